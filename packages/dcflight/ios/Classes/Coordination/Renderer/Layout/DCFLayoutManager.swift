@@ -385,6 +385,15 @@ extension DCFLayoutManager {
         
     }
     
+    func removeChildNode(parentId: Int, childId: Int) {
+        
+        YogaShadowTree.shared.removeChildNode(parentId: String(parentId), childId: String(childId))
+        
+        needsLayoutCalculation = true
+        scheduleLayoutCalculation()
+        
+    }
+    
     func removeNode(nodeId: Int) {
         
         YogaShadowTree.shared.removeNode(nodeId: String(nodeId))
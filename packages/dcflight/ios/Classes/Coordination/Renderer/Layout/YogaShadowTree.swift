@@ -205,7 +205,7 @@ import yoga
             }
             
             // Add to new parent using shadow view's insertSubview method
-            let insertIndex = index ?? parentShadowView.subviews.count
+            let insertIndex = min(index ?? parentShadowView.subviews.count, parentShadowView.subviews.count)
             parentShadowView.insertSubview(childShadowView, atIndex: insertIndex)
             
             // Setup measure function for child (only if it has no children)
@@ -213,6 +213,26 @@ import yoga
         }
     }
     
+    /// Detaches a child from a parent, keeping it registered to be attached elsewhere or removed
+    func removeChildNode(parentId: String, childId: String) {
+        guard let parentViewId = Int(parentId),
+              let childViewId = Int(childId) else {
+            return
+        }
+        
+        syncQueue.sync {
+            guard let parentShadowView = shadowViewRegistry[parentViewId],
+                  let childShadowView = shadowViewRegistry[childViewId],
+                  childShadowView.superview === parentShadowView else {
+                return
+            }
+            
+            parentShadowView.removeSubview(childShadowView)
+            // Re-setup measure function for the parent (might be able to have measure function now)
+            setupMeasureFunction(shadowView: parentShadowView, componentType: nodeTypes[parentViewId] ?? "View")
+        }
+    }
+    
     func removeNode(nodeId: String) {
         guard let viewId = Int(nodeId) else { return }
         
@@ -0,0 +1,3 @@
+// Relative import to expose the C interface of the shadow tree to Swift.
+// See the comment in ../../dcflight.podspec for more information.
+#include "../../../src/dcflight/shadow/ShadowTreeFfi.h"
@@ -10,6 +10,7 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <stddef.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -19,20 +20,68 @@ extern "C" {
 // Signature: void callback(int32_t viewId, const char* eventType, const char* eventDataJson)
 typedef void (*DCFlightEventCallback)(int32_t viewId, const char* eventType, const char* eventDataJson);
 
+// Called on the thread which queued an event or screen dimensions, when Dart
+// has drained everything queued before. It should only schedule the drain,
+// e.g. a NativeCallable.listener posting to the isolate.
+typedef void (*DCFlightWakeCallback)(void);
+
 // Screen dimensions callback function pointer type
 // Signature: void callback(const char* dimensionsJson)
 typedef void (*DCFlightScreenDimensionsCallback)(const char* dimensionsJson);
 
+// A queued event, laid out as dcflight::events::EventRecord
+// (see src/dcflight/events/EventRing.h). The event type and the event data
+// JSON are stored back to back, without terminators, at payloadOffset in the
+// payload arena.
+typedef struct {
+    int32_t viewId;
+    uint32_t eventTypeLength;
+    uint32_t eventDataLength;
+    uint32_t payloadOffset;
+    uint32_t payloadEnd;
+    // DCFLIGHT_EVENT_SUPERSEDED if a later event of the same view and
+    // coalescable type replaces this one, which is then to be skipped
+    uint32_t flags;
+} DCFlightEventRecord;
+
+#define DCFLIGHT_EVENT_SUPERSEDED 1u
+
+// Events ready to be read in place. Record i of the span is
+// records[(first + i) & (capacity - 1)]; both capacities are powers of two.
+typedef struct {
+    const DCFlightEventRecord* records;
+    const uint8_t* payloads;
+    uint32_t capacity;
+    uint32_t payloadCapacity;
+    uint32_t first;
+    uint32_t count;
+} DCFlightEventSpan;
+
+// A result written by native code into memory it owns, in the binary result
+// encoding (see src/dcflight/result/ResultProtocol.h). It stays valid until
+// dcflight_results_release().
+typedef struct {
+    const uint8_t* data;
+    uint32_t length;
+} DCFlightResult;
+
 // Initialize the DCFlight bridge
 bool dcflight_initialize(void);
 
-// View operations
+// View operations. Called off the main thread, they are queued and return
+// true once queued: the main thread runs them in order, in one hop, before
+// its next frame, before any other function below waits for it, or when
+// dcflight_flush_view_ops() is called. A queued operation which fails is
+// logged. Called on the main thread, they run at once and return whether
+// they succeeded.
 bool dcflight_create_view(int32_t viewId, const char* viewType, const char* propsJson);
 bool dcflight_update_view(int32_t viewId, const char* propsJson);
 bool dcflight_delete_view(int32_t viewId);
 bool dcflight_detach_view(int32_t childId);
 bool dcflight_attach_view(int32_t childId, int32_t parentId, int32_t index);
 bool dcflight_set_children(int32_t viewId, const int32_t* childrenIds, int32_t childrenCount);
+// Runs the queued view operations on the main thread and waits for them
+void dcflight_flush_view_ops(void);
 
 // Event listeners
 bool dcflight_add_event_listeners(int32_t viewId, const char* eventTypes);
@@ -41,16 +90,55 @@ bool dcflight_remove_event_listeners(int32_t viewId, const char* eventTypes);
 // Batch updates
 bool dcflight_start_batch_update(void);
 bool dcflight_commit_batch_update(const char* operationsJson);
+// Commit a batch encoded with the binary mutation protocol
+// (see src/dcflight/mutation/MutationProtocol.h). Buffers must be committed in
+// the order they were encoded, since they share an interned string table.
+bool dcflight_commit_batch_binary(const uint8_t* buffer, size_t length);
 bool dcflight_cancel_batch_update(void);
 
 // Tunnel mechanism
 bool dcflight_tunnel(const char* componentType, const char* method, const char* paramsJson, char* resultJson, int32_t resultSize);
 
+// Results of any size, read in place rather than parsed from JSON written to
+// a fixed buffer. A tunnel method returning nothing gives a null result. Only
+// one thread may use results at a time.
+bool dcflight_tunnel_result(const char* componentType, const char* method, const char* paramsJson, DCFlightResult* result);
+bool dcflight_get_screen_dimensions_result(DCFlightResult* result);
+// A null result when there is no token
+bool dcflight_get_session_token_result(DCFlightResult* result);
+bool dcflight_create_session_token_result(DCFlightResult* result);
+// Releases every result returned so far, e.g. once Dart has read them
+void dcflight_results_release(void);
+
 // Event callback management
 void dcflight_set_event_callback(DCFlightEventCallback callback);
 DCFlightEventCallback dcflight_get_event_callback(void);
 void dcflight_send_event(int32_t viewId, const char* eventType, const char* eventDataJson);
+// Drains queued events into a JSON array to be freed by the caller, or returns
+// NULL if there are none. Prefer reading events in place with the functions
+// below.
 const char* dcflight_get_queued_events(void);
+
+// Event ring: fills span with the queued events and returns their count. They
+// stay valid until dcflight_events_end_read() releases them. Only one thread
+// may read events at a time.
+uint32_t dcflight_events_begin_read(DCFlightEventSpan* span);
+void dcflight_events_end_read(uint32_t count);
+// Number of events dropped so far because the ring was full
+uint64_t dcflight_events_get_dropped_count(void);
+// Sets whether the events of a type, e.g. "onScroll", are coalesced per view
+// when read: the earlier of the unreleased events of a view and type are
+// flagged DCFLIGHT_EVENT_SUPERSEDED. Only the reading thread may call it.
+void dcflight_events_set_coalescable(const char* eventType, bool coalescable);
+// Number of events superseded so far
+uint64_t dcflight_events_get_coalesced_count(void);
+// Sets or, given NULL, clears the callback waking Dart to drain the events and
+// screen dimensions, instead of polling. dcflight_events_begin_read() rearms
+// it, so Dart must call it before reading the screen dimensions, and once
+// after setting the callback for what was queued before.
+void dcflight_set_wake_callback(DCFlightWakeCallback callback);
+// Wakes Dart after queueing anything else it drains, from any thread
+void dcflight_wake_dart(void);
 void dcflight_process_event_queue(void);
 
 // Screen dimensions
@@ -8,15 +8,8 @@
 #import <Foundation/Foundation.h>
 #import <string.h>
 #import "DCFlightFfi.h"
-
-// Helper macro to safely execute on main thread
-// Avoids deadlock if already on main thread
-#define SAFE_MAIN_THREAD_EXEC(block) \
-    if ([NSThread isMainThread]) { \
-        block(); \
-    } else { \
-        dispatch_sync(dispatch_get_main_queue(), block); \
-    }
+#import "DCFlightFfiInternal.h"
+#import "DCFlightFfiResults.h"
 
 // Import Swift classes via generated header
 // Swift classes marked with @objc public are exposed to Objective-C via {MODULE}-Swift.h
@@ -38,67 +31,18 @@
 
 // Global event callback function pointer
 static DCFlightEventCallback g_eventCallback = NULL;
-// Queue for events that need to be processed on Dart isolate thread
-static NSMutableArray<NSDictionary*>* g_eventQueue = nil;
-static dispatch_queue_t g_eventQueueLock = NULL;
 
+// Events are queued by dcflight_send_event in DCFlightFfiEvents.mm
 void dcflight_set_event_callback(DCFlightEventCallback callback) {
     g_eventCallback = callback;
-    if (g_eventQueue == nil) {
-        g_eventQueue = [[NSMutableArray alloc] init];
-        g_eventQueueLock = dispatch_queue_create("com.dotcorr.dcflight.eventqueue", DISPATCH_QUEUE_SERIAL);
-    }
 }
 
 DCFlightEventCallback dcflight_get_event_callback(void) {
     return g_eventCallback;
 }
 
-void dcflight_send_event(int32_t viewId, const char* eventType, const char* eventDataJson) {
-    // Queue the event for Dart to poll - we can't call FFI callbacks from native threads
-    @synchronized(g_eventQueue) {
-        if (g_eventQueue == nil) {
-            g_eventQueue = [[NSMutableArray alloc] init];
-        }
-        [g_eventQueue addObject:@{
-            @"viewId": @(viewId),
-            @"eventType": [NSString stringWithUTF8String:eventType ?: ""],
-            @"eventDataJson": [NSString stringWithUTF8String:eventDataJson ?: ""]
-        }];
-    }
-}
-
-// Get queued events for Dart to process (polling mechanism)
-// Returns JSON array of events, or NULL if no events
-const char* dcflight_get_queued_events(void) {
-    if (g_eventQueue == nil || g_eventQueue.count == 0) {
-        return NULL;
-    }
-    
-    NSArray<NSDictionary*>* eventsToProcess = nil;
-    @synchronized(g_eventQueue) {
-        if (g_eventQueue.count == 0) {
-            return NULL;
-        }
-        eventsToProcess = [g_eventQueue copy];
-        [g_eventQueue removeAllObjects];
-    }
-    
-    NSError* error = nil;
-    NSData* jsonData = [NSJSONSerialization dataWithJSONObject:eventsToProcess options:0 error:&error];
-    if (error != nil) {
-        NSLog(@"❌ DCFlightFfi: Failed to serialize queued events: %@", error);
-        return NULL;
-    }
-    
-    NSString* jsonString = [[NSString alloc] initWithData:jsonData encoding:NSUTF8StringEncoding];
-    // Allocate memory that will be freed by Dart
-    char* result = strdup([jsonString UTF8String]);
-    return result;
-}
-
 void dcflight_process_event_queue(void) {
-    // This function is deprecated - use dcflight_get_queued_events instead
+    // This function is deprecated - use dcflight_events_begin_read instead
     // Kept for backward compatibility but does nothing
 }
 
@@ -141,121 +85,7 @@ bool dcflight_initialize(void) {
     return result;
 }
 
-bool dcflight_create_view(int32_t viewId, const char* viewType, const char* propsJson) {
-    if (viewType == NULL || propsJson == NULL) {
-        return false;
-    }
-    
-    NSString* viewTypeStr = [NSString stringWithUTF8String:viewType];
-    NSString* propsJsonStr = [NSString stringWithUTF8String:propsJson];
-    
-    __block bool result = false;
-    SAFE_MAIN_THREAD_EXEC(^{
-        result = [DCFlightNative.shared createViewWithViewId:viewId viewType:viewTypeStr propsJson:propsJsonStr];
-    });
-    return result;
-}
-
-bool dcflight_update_view(int32_t viewId, const char* propsJson) {
-    if (propsJson == NULL) {
-        return false;
-    }
-    
-    NSString* propsJsonStr = [NSString stringWithUTF8String:propsJson];
-    
-    __block bool result = false;
-    SAFE_MAIN_THREAD_EXEC(^{
-        result = [DCFlightNative.shared updateViewWithViewId:viewId propsJson:propsJsonStr];
-    });
-    return result;
-}
-
-bool dcflight_delete_view(int32_t viewId) {
-    __block bool result = false;
-    SAFE_MAIN_THREAD_EXEC(^{
-        result = [DCFlightNative.shared deleteViewWithViewId:viewId];
-    });
-    return result;
-}
-
-bool dcflight_detach_view(int32_t viewId) {
-    __block bool result = false;
-    SAFE_MAIN_THREAD_EXEC(^{
-        result = [DCFlightNative.shared detachViewWithChildId:viewId];
-    });
-    return result;
-}
-
-bool dcflight_attach_view(int32_t childId, int32_t parentId, int32_t index) {
-    __block bool result = false;
-    SAFE_MAIN_THREAD_EXEC(^{
-        result = [DCFlightNative.shared attachViewWithChildId:childId parentId:parentId index:index];
-    });
-    return result;
-}
-
-bool dcflight_set_children(int32_t viewId, const int32_t* childrenIds, int32_t childrenCount) {
-    if (childrenIds == NULL || childrenCount < 0) {
-        return false;
-    }
-    
-    __block bool result = false;
-    SAFE_MAIN_THREAD_EXEC(^{
-        NSMutableArray<NSNumber*>* intArray = [NSMutableArray arrayWithCapacity:childrenCount];
-        for (int32_t i = 0; i < childrenCount; i++) {
-            [intArray addObject:@(childrenIds[i])];
-        }
-        // Convert NSArray<NSNumber*> to [Int] for Swift
-        NSMutableArray* swiftIntArray = [NSMutableArray arrayWithCapacity:childrenCount];
-        for (NSNumber* num in intArray) {
-            [swiftIntArray addObject:num];
-        }
-        result = [DCFlightNative.shared setChildrenWithViewId:viewId childrenIds:swiftIntArray];
-    });
-    return result;
-}
-
-bool dcflight_add_event_listeners(int32_t viewId, const char* eventTypes) {
-    if (eventTypes == NULL) {
-        return false;
-    }
-    
-    NSString* eventTypesStr = [NSString stringWithUTF8String:eventTypes];
-    NSData* data = [eventTypesStr dataUsingEncoding:NSUTF8StringEncoding];
-    NSError* error = nil;
-    NSArray<NSString*>* eventTypesArray = [NSJSONSerialization JSONObjectWithData:data options:0 error:&error];
-    if (error != nil || ![eventTypesArray isKindOfClass:[NSArray class]]) {
-        NSLog(@"❌ DCFlightFfi: Failed to parse event types JSON: %@", error);
-        return false;
-    }
-    
-    __block bool result = false;
-    SAFE_MAIN_THREAD_EXEC(^{
-        result = [DCFlightNative.shared addEventListenersWithViewId:viewId eventTypes:eventTypesArray];
-    });
-    return result;
-}
-
-bool dcflight_remove_event_listeners(int32_t viewId, const char* eventTypes) {
-    if (eventTypes == NULL) {
-        return false;
-    }
-    
-    NSString* eventTypesStr = [NSString stringWithUTF8String:eventTypes];
-    NSData* data = [eventTypesStr dataUsingEncoding:NSUTF8StringEncoding];
-    NSError* error = nil;
-    NSArray<NSString*>* eventTypesArray = [NSJSONSerialization JSONObjectWithData:data options:0 error:&error];
-    if (error != nil || ![eventTypesArray isKindOfClass:[NSArray class]]) {
-        NSLog(@"❌ DCFlightFfi: Failed to parse event types JSON: %@", error);
-        return false;
-    }
-    
-    __block bool result = false;
-    SAFE_MAIN_THREAD_EXEC(^{
-        result = [DCFlightNative.shared removeEventListenersWithViewId:viewId eventTypes:eventTypesArray];
-    });
-    return result;
-}
+// View operations are queued by DCFlightFfiViewOps.mm
 
 bool dcflight_start_batch_update(void) {
     __block bool result = false;
@@ -295,11 +125,9 @@ bool dcflight_cancel_batch_update(void) {
     return result;
 }
 
-bool dcflight_tunnel(const char* componentType, const char* method, const char* paramsJson, char* resultJson, int32_t resultSize) {
-    if (componentType == NULL || method == NULL || paramsJson == NULL || resultJson == NULL || resultSize <= 0) {
-        return false;
-    }
-    
+// Parses the params and calls a tunnel method on the main thread. Returns
+// false if the params are invalid.
+static bool _callTunnel(const char* componentType, const char* method, const char* paramsJson, id* result) {
     NSString* componentTypeStr = [NSString stringWithUTF8String:componentType];
     NSString* methodStr = [NSString stringWithUTF8String:method];
     NSString* paramsJsonStr = [NSString stringWithUTF8String:paramsJson];
@@ -312,10 +140,23 @@ bool dcflight_tunnel(const char* componentType, const char* method, const char*
         return false;
     }
     
-    __block id result = nil;
+    __block id tunnelResult = nil;
     SAFE_MAIN_THREAD_EXEC(^{
-        result = [DCFlightNative.shared handleTunnelMethodWithComponentType:componentTypeStr method:methodStr params:(NSDictionary*)params];
+        tunnelResult = [DCFlightNative.shared handleTunnelMethodWithComponentType:componentTypeStr method:methodStr params:(NSDictionary*)params];
     });
+    *result = tunnelResult;
+    return true;
+}
+
+bool dcflight_tunnel(const char* componentType, const char* method, const char* paramsJson, char* resultJson, int32_t resultSize) {
+    if (componentType == NULL || method == NULL || paramsJson == NULL || resultJson == NULL || resultSize <= 0) {
+        return false;
+    }
+    
+    id result = nil;
+    if (!_callTunnel(componentType, method, paramsJson, &result)) {
+        return false;
+    }
     
     if (result == nil) {
         strncpy(resultJson, "null", resultSize - 1);
@@ -323,6 +164,7 @@ bool dcflight_tunnel(const char* componentType, const char* method, const char*
         return false;
     }
     
+    NSError* error = nil;
     NSData* resultData = [NSJSONSerialization dataWithJSONObject:result options:0 error:&error];
     if (error != nil) {
         NSLog(@"❌ DCFlightFfi: Failed to serialize result: %@", error);
@@ -345,6 +187,16 @@ bool dcflight_tunnel(const char* componentType, const char* method, const char*
     return true;
 }
 
+bool dcflight_tunnel_result(const char* componentType, const char* method, const char* paramsJson, DCFlightResult* result) {
+    if (componentType == NULL || method == NULL || paramsJson == NULL || result == NULL) {
+        return false;
+    }
+    
+    id tunnelResult = nil;
+    return _callTunnel(componentType, method, paramsJson, &tunnelResult) &&
+        DCFlightWriteResult(tunnelResult, result);
+}
+
 // Global screen dimensions callback function pointer
 static DCFlightScreenDimensionsCallback g_screenDimensionsCallback = NULL;
 // Queue for screen dimension changes that need to be processed on Dart isolate thread
@@ -358,7 +210,7 @@ void dcflight_set_screen_dimensions_callback(DCFlightScreenDimensionsCallback ca
 }
 
 void dcflight_send_screen_dimensions_changed(const char* dimensionsJson) {
-    // Queue the dimensions change for Dart to poll - we can't call FFI callbacks from native threads
+    // Queue the dimensions change for Dart to drain - we can't call FFI callbacks from native threads
     // EXACT SAME PATTERN AS EVENTS
     @synchronized(g_screenDimensionsQueue) {
         if (g_screenDimensionsQueue == nil) {
@@ -367,6 +219,7 @@ void dcflight_send_screen_dimensions_changed(const char* dimensionsJson) {
         NSString* dimensionsStr = [NSString stringWithUTF8String:dimensionsJson ?: ""];
         [g_screenDimensionsQueue addObject:dimensionsStr];
     }
+    dcflight_wake_dart();
 }
 
 // Get queued screen dimensions for Dart to process (polling mechanism)
@@ -433,6 +286,18 @@ bool dcflight_get_screen_dimensions(char* resultJson, int32_t resultSize) {
     return true;
 }
 
+bool dcflight_get_screen_dimensions_result(DCFlightResult* result) {
+    if (result == NULL) {
+        return false;
+    }
+    
+    __block NSDictionary* dimensions = nil;
+    SAFE_MAIN_THREAD_EXEC(^{
+        dimensions = [DCFScreenUtilities.shared getScreenDimensionsDict];
+    });
+    return dimensions != nil && DCFlightWriteResult(dimensions, result);
+}
+
 static NSString* g_sessionToken = nil;
 static NSString* const kSessionTokenKey = @"dcflight_session_token";
 
@@ -493,6 +358,11 @@ bool dcflight_get_session_token(char* resultJson, int32_t resultSize) {
     return true;
 }
 
+bool dcflight_get_session_token_result(DCFlightResult* result) {
+    NSString* token = _getSessionToken();
+    return DCFlightWriteResult(token.length > 0 ? token : nil, result);
+}
+
 bool dcflight_create_session_token(char* resultJson, int32_t resultSize) {
     if (resultJson == NULL || resultSize <= 0) {
         NSLog(@"❌ dcflight_create_session_token: Invalid parameters - resultJson=%p, resultSize=%d", resultJson, resultSize);
@@ -532,6 +402,12 @@ bool dcflight_create_session_token(char* resultJson, int32_t resultSize) {
     return true;
 }
 
+bool dcflight_create_session_token_result(DCFlightResult* result) {
+    NSString* token = [NSString stringWithFormat:@"dcf_session_%lld", (long long)([[NSDate date] timeIntervalSince1970] * 1000)];
+    _saveSessionToken(token);
+    return DCFlightWriteResult(token, result);
+}
+
 void dcflight_clear_session_token(void) {
     _saveSessionToken(nil);
 }
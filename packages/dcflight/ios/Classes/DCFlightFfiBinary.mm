@@ -0,0 +1,183 @@
+/*
+ * Copyright (c) Dotcorr Studio. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#import <Foundation/Foundation.h>
+#import "DCFlightFfi.h"
+#import "DCFlightFfiInternal.h"
+#import "dcflight-Swift.h"
+
+#include <mutex>
+
+#include <dcflight/mutation/MutationDecoder.h>
+
+using namespace dcflight::mutation;
+
+namespace {
+
+// The decoder owns the interned string table of the session, which must see
+// every buffer in order. Dart commits from a single isolate; the lock only
+// guards against a stray concurrent commit corrupting the table.
+std::mutex gDecoderMutex;
+MutationDecoder gDecoder;
+
+// NSStrings for interned ids, so that view types, prop keys and event types
+// are converted once per session rather than once per op
+NSMutableArray* gSymbols = nil;
+uint32_t gSymbolsGeneration = 0;
+
+NSString* makeString(std::string_view string) {
+    return [[NSString alloc] initWithBytes:string.data()
+                                    length:string.size()
+                                  encoding:NSUTF8StringEncoding];
+}
+
+NSString* symbolString(Symbol symbol) {
+    const uint32_t generation = gDecoder.strings().getGeneration();
+    if (gSymbols == nil || gSymbolsGeneration != generation) {
+        gSymbols = [NSMutableArray array];
+        gSymbolsGeneration = generation;
+    }
+    while (gSymbols.count <= symbol.id) {
+        [gSymbols addObject:[NSNull null]];
+    }
+
+    id cached = gSymbols[symbol.id];
+    if (cached != [NSNull null]) {
+        return cached;
+    }
+    NSString* string = makeString(symbol.name) ?: @"";
+    gSymbols[symbol.id] = string;
+    return string;
+}
+
+NSDictionary<NSString*, id>* makeDictionary(MapReader map);
+
+// Converts a value to the same Foundation type NSJSONSerialization would
+// produce for it. Returns nil for strings that are not valid UTF-8.
+id makeObject(const Value& value) {
+    switch (value.type()) {
+        case ValueType::Null:
+            return [NSNull null];
+        case ValueType::False:
+        case ValueType::True:
+            return @(value.asBool());
+        case ValueType::Int:
+            return @(value.asInt());
+        case ValueType::Double:
+            return @(value.asDouble());
+        case ValueType::String:
+            return makeString(value.asString());
+        case ValueType::List: {
+            ListReader list = value.asList();
+            NSMutableArray* array = [NSMutableArray arrayWithCapacity:list.size()];
+            Value item;
+            while (list.next(item)) {
+                if (id object = makeObject(item)) {
+                    [array addObject:object];
+                }
+            }
+            return array;
+        }
+        case ValueType::Map:
+            return makeDictionary(value.asMap());
+    }
+    return [NSNull null];
+}
+
+NSDictionary<NSString*, id>* makeDictionary(MapReader map) {
+    NSMutableDictionary* dictionary = [NSMutableDictionary dictionaryWithCapacity:map.size()];
+    Symbol key;
+    Value value;
+    while (map.next(key, value)) {
+        if (id object = makeObject(value)) {
+            dictionary[symbolString(key)] = object;
+        }
+    }
+    return dictionary;
+}
+
+NSArray<NSString*>* makeStringArray(StringList strings) {
+    NSMutableArray* array = [NSMutableArray arrayWithCapacity:strings.size()];
+    for (uint32_t i = 0; i < strings.size(); i++) {
+        [array addObject:symbolString(strings[i])];
+    }
+    return array;
+}
+
+// Collects the ops of a buffer into typed batch operations. Props are
+// converted while decoding, off the main thread.
+class BatchBuilder : public MutationHandler {
+public:
+    explicit BatchBuilder(DCFBatchOperations* batch) : batch_(batch) {}
+
+    void createView(int32_t viewId, Symbol viewType, MapReader props) override {
+        [batch_ createViewWithViewId:viewId
+                            viewType:symbolString(viewType)
+                               props:makeDictionary(props)];
+    }
+
+    void updateView(int32_t viewId, MapReader props) override {
+        [batch_ updateViewWithViewId:viewId props:makeDictionary(props)];
+    }
+
+    void deleteView(int32_t viewId) override {
+        [batch_ deleteViewWithViewId:viewId];
+    }
+
+    void attachView(int32_t childId, int32_t parentId, int32_t index) override {
+        [batch_ attachViewWithChildId:childId parentId:parentId index:index];
+    }
+
+    void detachView(int32_t viewId) override {
+        [batch_ detachViewWithChildId:viewId];
+    }
+
+    void setChildren(int32_t viewId, PackedArray<int32_t> childIds) override {
+        NSMutableArray<NSNumber*>* childrenIds = [NSMutableArray arrayWithCapacity:childIds.size()];
+        for (uint32_t i = 0; i < childIds.size(); i++) {
+            [childrenIds addObject:@(childIds[i])];
+        }
+        [batch_ setChildrenWithViewId:viewId childrenIds:childrenIds];
+    }
+
+    void addEventListeners(int32_t viewId, StringList eventTypes) override {
+        [batch_ addEventListenersWithViewId:viewId eventTypes:makeStringArray(eventTypes)];
+    }
+
+    void removeEventListeners(int32_t viewId, StringList eventTypes) override {
+        [batch_ removeEventListenersWithViewId:viewId eventTypes:makeStringArray(eventTypes)];
+    }
+
+private:
+    DCFBatchOperations* batch_;
+};
+
+} // namespace
+
+bool dcflight_commit_batch_binary(const uint8_t* buffer, size_t length) {
+    if (buffer == NULL) {
+        return false;
+    }
+
+    DCFBatchOperations* batch = [[DCFBatchOperations alloc] init];
+    DecodeStatus status;
+    @autoreleasepool {
+        std::lock_guard<std::mutex> lock(gDecoderMutex);
+        BatchBuilder builder(batch);
+        status = gDecoder.decode(buffer, length, builder);
+    }
+    if (status != DecodeStatus::Ok) {
+        NSLog(@"❌ DCFlightFfi: Failed to decode binary batch: %s", toString(status));
+        return false;
+    }
+
+    __block BOOL result = NO;
+    SAFE_MAIN_THREAD_EXEC(^{
+        result = [DCFlightNative.shared commitBatch:batch];
+    });
+    return result;
+}
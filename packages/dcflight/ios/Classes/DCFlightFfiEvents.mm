@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) Dotcorr Studio. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#import <Foundation/Foundation.h>
+#import "DCFlightFfi.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <string_view>
+
+#include <dcflight/events/EventRing.h>
+#include <dcflight/events/WakeSignal.h>
+
+using namespace dcflight::events;
+
+static_assert(sizeof(DCFlightEventRecord) == sizeof(EventRecord));
+static_assert(offsetof(DCFlightEventRecord, viewId) == offsetof(EventRecord, viewId));
+static_assert(offsetof(DCFlightEventRecord, eventTypeLength) == offsetof(EventRecord, typeLength));
+static_assert(offsetof(DCFlightEventRecord, eventDataLength) == offsetof(EventRecord, dataLength));
+static_assert(offsetof(DCFlightEventRecord, payloadOffset) == offsetof(EventRecord, payloadOffset));
+static_assert(offsetof(DCFlightEventRecord, payloadEnd) == offsetof(EventRecord, payloadEnd));
+static_assert(offsetof(DCFlightEventRecord, flags) == offsetof(EventRecord, flags));
+static_assert(DCFLIGHT_EVENT_SUPERSEDED == EventRecord::Superseded);
+
+namespace {
+
+// Events are sent from the main thread and from gesture and scroll callbacks,
+// and polled by the Dart isolate. 4096 events and 1 MB of payload hold well
+// over a second of 120 Hz scrolling between two polls.
+EventRing& eventRing() {
+    static EventRing ring{4096, 1 << 20};
+    return ring;
+}
+
+// Wakes the Dart isolate when events or screen dimensions are queued
+WakeSignal& wakeSignal() {
+    static WakeSignal signal;
+    return signal;
+}
+
+// Whether an event was dropped since Dart last began reading. The ring only
+// fills when Dart stalls, so drops are logged once per stall rather than per
+// event, and counted by the ring.
+std::atomic<bool> gLoggedOverflow{false};
+
+std::string_view makeView(const char* string) {
+    return string != NULL ? std::string_view{string} : std::string_view{};
+}
+
+} // namespace
+
+void dcflight_send_event(int32_t viewId, const char* eventType, const char* eventDataJson) {
+    // Queue the event for Dart to drain - we can't call FFI callbacks from native threads
+    if (!eventRing().push(viewId, makeView(eventType), makeView(eventDataJson))) {
+        if (!gLoggedOverflow.exchange(true, std::memory_order_relaxed)) {
+            NSLog(@"⚠️ DCFlightFfi: Event queue full, dropping events until Dart drains it");
+        }
+        return;
+    }
+    wakeSignal().notify();
+}
+
+void dcflight_set_wake_callback(DCFlightWakeCallback callback) {
+    wakeSignal().setWakeFunction(callback);
+}
+
+void dcflight_wake_dart(void) {
+    wakeSignal().notify();
+}
+
+uint32_t dcflight_events_begin_read(DCFlightEventSpan* span) {
+    if (span == NULL) {
+        return 0;
+    }
+
+    // Events queued from now on wake Dart again
+    wakeSignal().rearm();
+    gLoggedOverflow.store(false, std::memory_order_relaxed);
+    EventRing& ring = eventRing();
+    span->records = reinterpret_cast<const DCFlightEventRecord*>(ring.getRecords());
+    span->payloads = ring.getPayloads();
+    span->capacity = static_cast<uint32_t>(ring.getRecordCapacity());
+    span->payloadCapacity = static_cast<uint32_t>(ring.getPayloadCapacity());
+    span->first = ring.getReadIndex();
+    span->count = static_cast<uint32_t>(ring.beginRead());
+    return span->count;
+}
+
+void dcflight_events_end_read(uint32_t count) {
+    eventRing().endRead(count);
+}
+
+uint64_t dcflight_events_get_dropped_count(void) {
+    return eventRing().getDroppedCount();
+}
+
+void dcflight_events_set_coalescable(const char* eventType, bool coalescable) {
+    eventRing().setCoalescable(makeView(eventType), coalescable);
+}
+
+uint64_t dcflight_events_get_coalesced_count(void) {
+    return eventRing().getCoalescedCount();
+}
+
+// Get queued events for Dart to process (polling mechanism)
+// Returns JSON array of events, or NULL if no events
+const char* dcflight_get_queued_events(void) {
+    wakeSignal().rearm();
+    gLoggedOverflow.store(false, std::memory_order_relaxed);
+    EventRing& ring = eventRing();
+    const size_t count = ring.beginRead();
+    if (count == 0) {
+        return NULL;
+    }
+
+    NSMutableArray<NSDictionary*>* eventsToProcess = [NSMutableArray arrayWithCapacity:count];
+    for (size_t i = 0; i < count; i++) {
+        const EventRecord& record = ring.getRecord(static_cast<uint32_t>(ring.getReadIndex() + i));
+        if ((record.flags & EventRecord::Superseded) != 0) {
+            continue;
+        }
+        const std::string_view eventType = ring.getType(record);
+        const std::string_view eventData = ring.getData(record);
+        [eventsToProcess addObject:@{
+            @"viewId": @(record.viewId),
+            @"eventType": [[NSString alloc] initWithBytes:eventType.data()
+                                                   length:eventType.size()
+                                                 encoding:NSUTF8StringEncoding] ?: @"",
+            @"eventDataJson": [[NSString alloc] initWithBytes:eventData.data()
+                                                       length:eventData.size()
+                                                     encoding:NSUTF8StringEncoding] ?: @""
+        }];
+    }
+    ring.endRead(count);
+
+    NSError* error = nil;
+    NSData* jsonData = [NSJSONSerialization dataWithJSONObject:eventsToProcess options:0 error:&error];
+    if (error != nil) {
+        NSLog(@"❌ DCFlightFfi: Failed to serialize queued events: %@", error);
+        return NULL;
+    }
+
+    NSString* jsonString = [[NSString alloc] initWithData:jsonData encoding:NSUTF8StringEncoding];
+    // Allocate memory that will be freed by Dart
+    char* result = strdup([jsonString UTF8String]);
+    return result;
+}
@@ -0,0 +1,25 @@
+/*
+ * Copyright (c) Dotcorr Studio. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#import <Foundation/Foundation.h>
+#import "DCFlightFfi.h"
+
+// Helpers shared by the FFI implementation files, not part of the interface
+
+// Runs a block on the main thread, avoiding a deadlock if already on it.
+// Runs the queued view operations first, so that the block sees every view
+// operation called before it, as when each of them waited for the main thread
+#define SAFE_MAIN_THREAD_EXEC(block) \
+    if ([NSThread isMainThread]) { \
+        dcflight_flush_view_ops(); \
+        block(); \
+    } else { \
+        dispatch_sync(dispatch_get_main_queue(), ^{ \
+            dcflight_flush_view_ops(); \
+            block(); \
+        }); \
+    }
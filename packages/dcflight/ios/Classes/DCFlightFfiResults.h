@@ -0,0 +1,23 @@
+/*
+ * Copyright (c) Dotcorr Studio. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#import <Foundation/Foundation.h>
+#import "DCFlightFfi.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Writes a Foundation value, such as the result of a tunnel method, as a
+// result Dart reads in place. Values convert as they would to JSON, nil to
+// null. Returns false for values JSON cannot hold, such as dictionaries with
+// keys which are not strings.
+bool DCFlightWriteResult(id value, DCFlightResult* result);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) Dotcorr Studio. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#import "DCFlightFfiResults.h"
+
+#include <cstddef>
+#include <mutex>
+#include <string_view>
+
+#include <dcflight/result/ResultArena.h>
+#include <dcflight/result/ResultWriter.h>
+
+using namespace dcflight::result;
+
+static_assert(sizeof(DCFlightResult) == sizeof(ResultSlice));
+static_assert(offsetof(DCFlightResult, data) == offsetof(ResultSlice, data));
+static_assert(offsetof(DCFlightResult, length) == offsetof(ResultSlice, length));
+
+namespace {
+
+// Results are read and released by the Dart isolate; the lock only guards
+// against a stray concurrent caller corrupting the arena
+std::mutex gResultMutex;
+ResultArena gResults;
+ResultWriter gWriter;
+
+std::string_view makeView(NSString* string) {
+    const char* utf8 = string.UTF8String;
+    return utf8 != NULL ? std::string_view{utf8} : std::string_view{};
+}
+
+bool writeObject(id object, size_t depth) {
+    if (depth > dcflight::mutation::MaxValueDepth) {
+        return false;
+    }
+    if (object == nil || object == [NSNull null]) {
+        gWriter.writeNull();
+        return true;
+    }
+    if ([object isKindOfClass:[NSString class]]) {
+        gWriter.writeString(makeView(object));
+        return true;
+    }
+    if ([object isKindOfClass:[NSNumber class]]) {
+        NSNumber* number = object;
+        if (CFGetTypeID((__bridge CFTypeRef)number) == CFBooleanGetTypeID()) {
+            gWriter.writeBool(number.boolValue);
+        } else if (CFNumberIsFloatType((__bridge CFNumberRef)number)) {
+            gWriter.writeDouble(number.doubleValue);
+        } else {
+            gWriter.writeInt(number.longLongValue);
+        }
+        return true;
+    }
+    if ([object isKindOfClass:[NSArray class]]) {
+        gWriter.beginList();
+        for (id item in (NSArray*)object) {
+            if (!writeObject(item, depth + 1)) {
+                return false;
+            }
+        }
+        gWriter.endList();
+        return true;
+    }
+    if ([object isKindOfClass:[NSDictionary class]]) {
+        gWriter.beginMap();
+        __block bool written = true;
+        [(NSDictionary*)object enumerateKeysAndObjectsUsingBlock:^(id key, id value, BOOL* stop) {
+            if (![key isKindOfClass:[NSString class]]) {
+                written = false;
+            } else {
+                gWriter.key(makeView(key));
+                written = writeObject(value, depth + 1);
+            }
+            *stop = !written;
+        }];
+        if (!written) {
+            return false;
+        }
+        gWriter.endMap();
+        return true;
+    }
+    return false;
+}
+
+} // namespace
+
+bool DCFlightWriteResult(id value, DCFlightResult* result) {
+    if (result == NULL) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(gResultMutex);
+    if (!writeObject(value, 0)) {
+        NSLog(@"❌ DCFlightFfi: Cannot write result of type %@", [value class]);
+        gWriter.reset();
+        return false;
+    }
+    const ResultSlice slice = gWriter.finish(gResults);
+    result->data = slice.data;
+    result->length = slice.length;
+    return true;
+}
+
+void dcflight_results_release(void) {
+    std::lock_guard<std::mutex> lock(gResultMutex);
+    gResults.releaseAll();
+}
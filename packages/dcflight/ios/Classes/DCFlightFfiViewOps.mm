@@ -0,0 +1,248 @@
+/*
+ * Copyright (c) Dotcorr Studio. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#import <Foundation/Foundation.h>
+#import "DCFlightFfi.h"
+#import "dcflight-Swift.h"
+
+#include <string_view>
+
+#include <dcflight/mutation/CommandBuffer.h>
+
+using namespace dcflight::mutation;
+
+namespace {
+
+void scheduleViewOps();
+
+// View ops called off the main thread are queued here rather than each
+// waiting for the main thread, and run there in one hop
+CommandBuffer& viewOps() {
+    static CommandBuffer* buffer = [] {
+        auto* buffer = new CommandBuffer();
+        buffer->setScheduleFunction(scheduleViewOps);
+        return buffer;
+    }();
+    return *buffer;
+}
+
+// Only touched on the main thread
+CommandBatch& viewOpBatch() {
+    static CommandBatch batch;
+    return batch;
+}
+bool gRunningViewOps = false;
+
+NSString* makeString(std::string_view string) {
+    return [[NSString alloc] initWithBytes:string.data()
+                                    length:string.size()
+                                  encoding:NSUTF8StringEncoding];
+}
+
+NSArray<NSString*>* parseEventTypes(NSString* eventTypes) {
+    NSData* data = [eventTypes dataUsingEncoding:NSUTF8StringEncoding];
+    if (data == nil) {
+        return nil;
+    }
+    NSError* error = nil;
+    NSArray<NSString*>* eventTypesArray = [NSJSONSerialization JSONObjectWithData:data options:0 error:&error];
+    if (error != nil || ![eventTypesArray isKindOfClass:[NSArray class]]) {
+        NSLog(@"❌ DCFlightFfi: Failed to parse event types JSON: %@", error);
+        return nil;
+    }
+    return eventTypesArray;
+}
+
+// The ops themselves, run on the main thread whether they were queued or not
+
+bool createView(int32_t viewId, NSString* viewType, NSString* propsJson) {
+    return [DCFlightNative.shared createViewWithViewId:viewId viewType:viewType propsJson:propsJson];
+}
+
+bool updateView(int32_t viewId, NSString* propsJson) {
+    return [DCFlightNative.shared updateViewWithViewId:viewId propsJson:propsJson];
+}
+
+bool setChildren(int32_t viewId, const int32_t* childrenIds, uint32_t childrenCount) {
+    NSMutableArray<NSNumber*>* childrenArray = [NSMutableArray arrayWithCapacity:childrenCount];
+    for (uint32_t i = 0; i < childrenCount; i++) {
+        [childrenArray addObject:@(childrenIds[i])];
+    }
+    return [DCFlightNative.shared setChildrenWithViewId:viewId childrenIds:childrenArray];
+}
+
+bool addEventListeners(int32_t viewId, NSString* eventTypes) {
+    NSArray<NSString*>* eventTypesArray = parseEventTypes(eventTypes);
+    return eventTypesArray != nil &&
+        [DCFlightNative.shared addEventListenersWithViewId:viewId eventTypes:eventTypesArray];
+}
+
+bool removeEventListeners(int32_t viewId, NSString* eventTypes) {
+    NSArray<NSString*>* eventTypesArray = parseEventTypes(eventTypes);
+    return eventTypesArray != nil &&
+        [DCFlightNative.shared removeEventListenersWithViewId:viewId eventTypes:eventTypesArray];
+}
+
+bool runCommand(const CommandBatch& batch, const Command& command) {
+    switch (command.type) {
+        case CommandType::CreateView:
+            return createView(command.viewId,
+                              makeString(batch.getViewType(command)),
+                              makeString(batch.getText(command)));
+        case CommandType::UpdateView:
+            return updateView(command.viewId, makeString(batch.getText(command)));
+        case CommandType::DeleteView:
+            return [DCFlightNative.shared deleteViewWithViewId:command.viewId];
+        case CommandType::DetachView:
+            return [DCFlightNative.shared detachViewWithChildId:command.viewId];
+        case CommandType::AttachView:
+            return [DCFlightNative.shared attachViewWithChildId:command.viewId
+                                                       parentId:command.parentId
+                                                          index:command.index];
+        case CommandType::SetChildren:
+            return setChildren(command.viewId, batch.getChildIds(command), command.childCount);
+        case CommandType::AddEventListeners:
+            return addEventListeners(command.viewId, makeString(batch.getText(command)));
+        case CommandType::RemoveEventListeners:
+            return removeEventListeners(command.viewId, makeString(batch.getText(command)));
+    }
+    return false;
+}
+
+// Runs the queued ops on the main thread, in the order they were queued. An
+// op called from within one of them runs at once, as it did before ops were
+// queued, rather than taking the ops queued meanwhile out of order.
+void runQueuedViewOps() {
+    if (gRunningViewOps) {
+        return;
+    }
+    CommandBatch& batch = viewOpBatch();
+    if (viewOps().take(batch) == 0) {
+        return;
+    }
+
+    gRunningViewOps = true;
+    @autoreleasepool {
+        for (const Command& command : batch.getCommands()) {
+            if (!runCommand(batch, command)) {
+                NSLog(@"⚠️ DCFlightFfi: Queued view op %d failed for view %d",
+                      static_cast<int>(command.type), command.viewId);
+            }
+        }
+    }
+    gRunningViewOps = false;
+}
+
+void runQueuedViewOpsAsync(void*) {
+    runQueuedViewOps();
+}
+
+// Called by the first op queued after the last run. The main queue runs the
+// ops before it next sleeps and commits the frame, together with every op
+// queued until then.
+void scheduleViewOps() {
+    dispatch_async_f(dispatch_get_main_queue(), NULL, runQueuedViewOpsAsync);
+}
+
+} // namespace
+
+void dcflight_flush_view_ops(void) {
+    if ([NSThread isMainThread]) {
+        runQueuedViewOps();
+    } else if (viewOps().getPendingCount() > 0) {
+        dispatch_sync(dispatch_get_main_queue(), ^{
+            runQueuedViewOps();
+        });
+    }
+}
+
+bool dcflight_create_view(int32_t viewId, const char* viewType, const char* propsJson) {
+    if (viewType == NULL || propsJson == NULL) {
+        return false;
+    }
+    if (![NSThread isMainThread]) {
+        viewOps().createView(viewId, std::string_view{viewType}, std::string_view{propsJson});
+        return true;
+    }
+    runQueuedViewOps();
+    return createView(viewId, [NSString stringWithUTF8String:viewType], [NSString stringWithUTF8String:propsJson]);
+}
+
+bool dcflight_update_view(int32_t viewId, const char* propsJson) {
+    if (propsJson == NULL) {
+        return false;
+    }
+    if (![NSThread isMainThread]) {
+        viewOps().updateView(viewId, std::string_view{propsJson});
+        return true;
+    }
+    runQueuedViewOps();
+    return updateView(viewId, [NSString stringWithUTF8String:propsJson]);
+}
+
+bool dcflight_delete_view(int32_t viewId) {
+    if (![NSThread isMainThread]) {
+        viewOps().deleteView(viewId);
+        return true;
+    }
+    runQueuedViewOps();
+    return [DCFlightNative.shared deleteViewWithViewId:viewId];
+}
+
+bool dcflight_detach_view(int32_t viewId) {
+    if (![NSThread isMainThread]) {
+        viewOps().detachView(viewId);
+        return true;
+    }
+    runQueuedViewOps();
+    return [DCFlightNative.shared detachViewWithChildId:viewId];
+}
+
+bool dcflight_attach_view(int32_t childId, int32_t parentId, int32_t index) {
+    if (![NSThread isMainThread]) {
+        viewOps().attachView(childId, parentId, index);
+        return true;
+    }
+    runQueuedViewOps();
+    return [DCFlightNative.shared attachViewWithChildId:childId parentId:parentId index:index];
+}
+
+bool dcflight_set_children(int32_t viewId, const int32_t* childrenIds, int32_t childrenCount) {
+    if (childrenIds == NULL || childrenCount < 0) {
+        return false;
+    }
+    if (![NSThread isMainThread]) {
+        viewOps().setChildren(viewId, childrenIds, static_cast<size_t>(childrenCount));
+        return true;
+    }
+    runQueuedViewOps();
+    return setChildren(viewId, childrenIds, static_cast<uint32_t>(childrenCount));
+}
+
+bool dcflight_add_event_listeners(int32_t viewId, const char* eventTypes) {
+    if (eventTypes == NULL) {
+        return false;
+    }
+    if (![NSThread isMainThread]) {
+        viewOps().addEventListeners(viewId, std::string_view{eventTypes});
+        return true;
+    }
+    runQueuedViewOps();
+    return addEventListeners(viewId, [NSString stringWithUTF8String:eventTypes]);
+}
+
+bool dcflight_remove_event_listeners(int32_t viewId, const char* eventTypes) {
+    if (eventTypes == NULL) {
+        return false;
+    }
+    if (![NSThread isMainThread]) {
+        viewOps().removeEventListeners(viewId, std::string_view{eventTypes});
+        return true;
+    }
+    runQueuedViewOps();
+    return removeEventListeners(viewId, [NSString stringWithUTF8String:eventTypes]);
+}
@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) Dotcorr Studio. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+import Foundation
+
+/// Typed operations of a batch commit.
+/// Filled in by the JSON and binary batch decoders, then executed in phases by
+/// `DCFlightNative.commitBatch(_:)`.
+@objc public class DCFBatchOperations: NSObject {
+
+    /// Hierarchy changes are applied in the order they were recorded
+    enum HierarchyOperation {
+        case attach(childId: Int, parentId: Int, index: Int)
+        case detach(childId: Int)
+        case setChildren(viewId: Int, childrenIds: [Int])
+    }
+
+    var deleteOps: [Int] = []
+    var createOps: [(viewId: Int, viewType: String, props: [String: Any])] = []
+    var updateOps: [(viewId: Int, props: [String: Any])] = []
+    var hierarchyOps: [HierarchyOperation] = []
+    var eventOps: [(viewId: Int, eventTypes: [String])] = []
+    var removeEventOps: [(viewId: Int, eventTypes: [String])] = []
+
+    /// Number of operations recorded so far
+    @objc public private(set) var count = 0
+
+    @objc public func deleteView(viewId: Int) {
+        deleteOps.append(viewId)
+        count += 1
+    }
+
+    @objc public func createView(viewId: Int, viewType: String, props: [String: Any]) {
+        createOps.append((viewId, viewType, props))
+        count += 1
+    }
+
+    @objc public func updateView(viewId: Int, props: [String: Any]) {
+        updateOps.append((viewId, props))
+        count += 1
+    }
+
+    @objc public func attachView(childId: Int, parentId: Int, index: Int) {
+        hierarchyOps.append(.attach(childId: childId, parentId: parentId, index: index))
+        count += 1
+    }
+
+    @objc public func detachView(childId: Int) {
+        hierarchyOps.append(.detach(childId: childId))
+        count += 1
+    }
+
+    @objc public func setChildren(viewId: Int, childrenIds: [Int]) {
+        hierarchyOps.append(.setChildren(viewId: viewId, childrenIds: childrenIds))
+        count += 1
+    }
+
+    @objc public func addEventListeners(viewId: Int, eventTypes: [String]) {
+        eventOps.append((viewId, eventTypes))
+        count += 1
+    }
+
+    @objc public func removeEventListeners(viewId: Int, eventTypes: [String]) {
+        removeEventOps.append((viewId, eventTypes))
+        count += 1
+    }
+}
@@ -8,6 +8,9 @@
 import UIKit
 import Foundation
 
+@_silgen_name("dcflight_shadow_diff_children")
+func dcflight_shadow_diff_children(_ oldIds: UnsafePointer<Int32>?, _ oldCount: Int32, _ newIds: UnsafePointer<Int32>?, _ newCount: Int32, _ removals: UnsafeMutablePointer<Int32>?, _ removalCount: UnsafeMutablePointer<Int32>, _ insertions: UnsafeMutablePointer<Int32>?, _ insertionCount: UnsafeMutablePointer<Int32>) -> Bool
+
 /// Native implementation for iOS view operations.
 /// Called directly via FFI from Dart (no MethodChannel).
 @objc public class DCFlightNative: NSObject {
@@ -53,6 +56,14 @@ import Foundation
     
     /// Create a view with properties
     @objc public func createView(viewId: Int, viewType: String, propsJson: String) -> Bool {
+        guard let props = parseProps(propsJson) else {
+            return false
+        }
+        return createView(viewId: viewId, viewType: viewType, props: props)
+    }
+    
+    /// Create a view with already decoded properties
+    @objc public func createView(viewId: Int, viewType: String, props: [String: Any]) -> Bool {
         
         // 🔥 CRITICAL FIX: Match Android behavior - check if view already exists
         // During hot reload, views are preserved but Dart may try to "create" them again
@@ -63,16 +74,10 @@ import Foundation
                 deleteView(viewId: viewId)
             } else {
                 // View exists and is in hierarchy - update it instead of creating
-                return updateView(viewId: viewId, propsJson: propsJson)
+                return updateView(viewId: viewId, props: props)
             }
         }
         
-        guard let propsData = propsJson.data(using: .utf8),
-              let props = try? JSONSerialization.jsonObject(with: propsData, options: []) as? [String: Any] else {
-            return false
-        }
-        
-        
         let success = DCFViewManager.shared.createView(viewId: viewId, viewType: viewType, props: props)
         
         if success, let view = ViewRegistry.shared.getView(id: viewId) {
@@ -85,15 +90,24 @@ import Foundation
     
     /// Update a view's properties
     @objc public func updateView(viewId: Int, propsJson: String) -> Bool {
-        
-        guard let propsData = propsJson.data(using: .utf8),
-              let props = try? JSONSerialization.jsonObject(with: propsData, options: []) as? [String: Any] else {
+        guard let props = parseProps(propsJson) else {
             return false
         }
-        
+        return updateView(viewId: viewId, props: props)
+    }
+    
+    /// Update a view's properties with already decoded properties
+    @objc public func updateView(viewId: Int, props: [String: Any]) -> Bool {
         return DCFViewManager.shared.updateView(viewId: viewId, props: props)
     }
     
+    private func parseProps(_ propsJson: String) -> [String: Any]? {
+        guard let propsData = propsJson.data(using: .utf8) else {
+            return nil
+        }
+        return (try? JSONSerialization.jsonObject(with: propsData, options: [])) as? [String: Any]
+    }
+    
     /// Delete a view
     @objc public func deleteView(viewId: Int) -> Bool {
         // 🔥 CRITICAL FIX: Stop animations before deleting to prevent freeze
@@ -292,6 +306,10 @@ import Foundation
             childToParent[childIdStr] = viewIdStr
         }
         
+        if moveChangedChildren(parentView: parentView, viewId: viewId, oldChildren: oldChildren, childrenIds: childrenIds) {
+            return true
+        }
+        
         for subview in parentView.subviews {
             subview.removeFromSuperview()
         }
@@ -307,6 +325,63 @@ import Foundation
         return true
     }
     
+    /// Move only the children which were added or changed place, as diffed by the native core,
+    /// so that reordering a list leaves the views which kept their order attached.
+    /// Returns false without changing anything if the subviews are not the old children in order,
+    /// as the diff indexes into them, and the children must then be replaced at once.
+    private func moveChangedChildren(parentView: UIView, viewId: Int, oldChildren: [String], childrenIds: [Int]) -> Bool {
+        let oldIds = oldChildren.compactMap { Int($0) }
+        guard oldIds.count == oldChildren.count,
+              parentView.subviews.count == oldIds.count,
+              zip(parentView.subviews, oldIds).allSatisfy({ $0 === self.views[$1] }),
+              childrenIds.allSatisfy({ self.views[$0] != nil }) else {
+            return false
+        }
+        
+        let oldIds32 = oldIds.map { Int32($0) }
+        let newIds32 = childrenIds.map { Int32($0) }
+        var removals = [Int32](repeating: 0, count: oldIds32.count)
+        var insertions = [Int32](repeating: 0, count: newIds32.count)
+        var removalCount: Int32 = 0
+        var insertionCount: Int32 = 0
+        let diffed = oldIds32.withUnsafeBufferPointer { oldBuffer in
+            newIds32.withUnsafeBufferPointer { newBuffer in
+                removals.withUnsafeMutableBufferPointer { removalBuffer in
+                    insertions.withUnsafeMutableBufferPointer { insertionBuffer in
+                        dcflight_shadow_diff_children(
+                            oldBuffer.baseAddress, Int32(oldBuffer.count),
+                            newBuffer.baseAddress, Int32(newBuffer.count),
+                            removalBuffer.baseAddress, &removalCount,
+                            insertionBuffer.baseAddress, &insertionCount)
+                    }
+                }
+            }
+        }
+        guard diffed else {
+            return false
+        }
+        
+        // Removals go from the last child to the first, so that each index is still valid
+        for removal in removals.prefix(Int(removalCount)) {
+            let childId = oldIds[Int(removal)]
+            self.views[childId]?.removeFromSuperview()
+            DCFLayoutManager.shared.removeChildNode(parentId: viewId, childId: childId)
+        }
+        
+        // Insertions go from the first child to the last, each landing at its final index
+        for insertion in insertions.prefix(Int(insertionCount)) {
+            let index = Int(insertion)
+            let childId = childrenIds[index]
+            if let childView = self.views[childId] {
+                parentView.insertSubview(childView, at: index)
+                
+                DCFLayoutManager.shared.addChildNode(parentId: viewId, childId: childId, index: index)
+            }
+        }
+        
+        return true
+    }
+    
     
     /// Detach a view from its parent
     @objc public func detachView(childId: Int) -> Bool {
@@ -477,12 +552,7 @@ import Foundation
     /// - Parameter updates: Array of operation dictionaries containing view operations
     /// - Returns: `true` if all operations succeeded, `false` otherwise
     @objc public func commitBatchUpdate(updates: [[String: Any]]) -> Bool {
-        // Separate pre-serialized JSON operations from legacy Map operations
-        var deleteOps: [Int] = []
-        var createOps: [(viewId: Int, viewType: String, propsJson: String)] = []
-        var updateOps: [(viewId: Int, propsJson: String)] = []
-        var attachOps: [(childId: Int, parentId: Int, index: Int)] = []
-        var eventOps: [(viewId: Int, eventTypes: [String])] = []
+        let batch = DCFBatchOperations()
         
         // Parse phase - collect all operations
         for operation in updates {
@@ -505,7 +575,7 @@ import Foundation
                 
                 if let viewId = viewId {
                     print("🗑️ iOS_BATCH: Parsed deleteView operation for viewId: \(viewId)")
-                    deleteOps.append(viewId)
+                    batch.deleteView(viewId: viewId)
                 }
                 
             case "createView":
@@ -524,14 +594,14 @@ import Foundation
                    let viewType = operation["viewType"] as? String {
                     // Check for pre-serialized JSON first (optimized path)
                     if let propsJson = operation["propsJson"] as? String {
-                        createOps.append((viewId, viewType, propsJson))
-                    } else if let props = operation["props"] as? [String: Any] {
-                        // Legacy fallback: serialize on native side
-                        guard let propsData = try? JSONSerialization.data(withJSONObject: props),
-                              let propsJson = String(data: propsData, encoding: .utf8) else {
-                            continue
+                        guard let props = parseProps(propsJson) else {
+                            print("❌ Failed to parse props of view \(viewId)")
+                            return false
                         }
-                        createOps.append((viewId, viewType, propsJson))
+                        batch.createView(viewId: viewId, viewType: viewType, props: props)
+                    } else if let props = operation["props"] as? [String: Any] {
+                        // Legacy fallback: props were sent as a map
+                        batch.createView(viewId: viewId, viewType: viewType, props: props)
                     }
                 }
                 
@@ -550,14 +620,14 @@ import Foundation
                 if let viewId = viewId {
                     // Check for pre-serialized JSON first (optimized path)
                     if let propsJson = operation["propsJson"] as? String {
-                        updateOps.append((viewId, propsJson))
-                    } else if let props = operation["props"] as? [String: Any] {
-                        // Legacy fallback: serialize on native side
-                        guard let propsData = try? JSONSerialization.data(withJSONObject: props),
-                              let propsJson = String(data: propsData, encoding: .utf8) else {
-                            continue
+                        guard let props = parseProps(propsJson) else {
+                            print("❌ Failed to parse props of view \(viewId)")
+                            return false
                         }
-                        updateOps.append((viewId, propsJson))
+                        batch.updateView(viewId: viewId, props: props)
+                    } else if let props = operation["props"] as? [String: Any] {
+                        // Legacy fallback: props were sent as a map
+                        batch.updateView(viewId: viewId, props: props)
                     }
                 }
                 
@@ -587,7 +657,7 @@ import Foundation
                 if let childId = childId,
                    let parentId = parentId,
                    let index = operation["index"] as? Int {
-                    attachOps.append((childId, parentId, index))
+                    batch.attachView(childId: childId, parentId: parentId, index: index)
                 }
                 
             case "addEventListeners":
@@ -604,7 +674,7 @@ import Foundation
                 
                 if let viewId = viewId,
                    let eventTypes = operation["eventTypes"] as? [String] {
-                    eventOps.append((viewId, eventTypes))
+                    batch.addEventListeners(viewId: viewId, eventTypes: eventTypes)
                 }
                 
             default:
@@ -613,6 +683,15 @@ import Foundation
             }
         }
         
+        return commitBatch(batch)
+    }
+    
+    /// Execute a batch of typed operations atomically.
+    /// Called by the JSON batch path above and by the binary batch entry point
+    /// (`dcflight_commit_batch_binary`), which decodes straight into `DCFBatchOperations`.
+    @objc public func commitBatch(_ batch: DCFBatchOperations) -> Bool {
+        let deleteOps = batch.deleteOps
+        
         // Execute phase - process all operations with minimal overhead
         do {
             let startTime = CFAbsoluteTimeGetCurrent()
@@ -690,51 +769,64 @@ import Foundation
             
             // Create all views (props are already JSON strings - no serialization needed!)
             // Old views are already removed from layout tree, so layout will only calculate with new views
-            for op in createOps {
-                if !createView(viewId: op.viewId, viewType: op.viewType, propsJson: op.propsJson) {
+            for op in batch.createOps {
+                if !createView(viewId: op.viewId, viewType: op.viewType, props: op.props) {
                     print("❌ Failed to create view \(op.viewId)")
                     return false
                 }
             }
             
             let createTime = (CFAbsoluteTimeGetCurrent() - createStartTime) * 1000
-            print("� iOS_BATCH_TIMING: Create phase completed in \(String(format: "%.2f", createTime))ms (\(createOps.count) views)")
+            print("� iOS_BATCH_TIMING: Create phase completed in \(String(format: "%.2f", createTime))ms (\(batch.createOps.count) views)")
             
             let updateStartTime = CFAbsoluteTimeGetCurrent()
             
-            // Update all views (props are already JSON strings - no serialization needed!)
-            for op in updateOps {
-                if !updateView(viewId: op.viewId, propsJson: op.propsJson) {
+            // Update all views (props are already decoded - no serialization needed!)
+            for op in batch.updateOps {
+                if !updateView(viewId: op.viewId, props: op.props) {
                     print("❌ Failed to update view \(op.viewId)")
                     return false
                 }
             }
             
             let updateTime = (CFAbsoluteTimeGetCurrent() - updateStartTime) * 1000
-            print("� iOS_BATCH_TIMING: Update phase completed in \(String(format: "%.2f", updateTime))ms (\(updateOps.count) views)")
+            print("� iOS_BATCH_TIMING: Update phase completed in \(String(format: "%.2f", updateTime))ms (\(batch.updateOps.count) views)")
             
             let attachStartTime = CFAbsoluteTimeGetCurrent()
             
             // Attach all views to hierarchy
-            for op in attachOps {
-                if !attachView(childId: op.childId, parentId: op.parentId, index: op.index) {
-                    print("❌ Failed to attach \(op.childId) to \(op.parentId)")
-                    return false
+            for op in batch.hierarchyOps {
+                switch op {
+                case let .attach(childId, parentId, index):
+                    if !attachView(childId: childId, parentId: parentId, index: index) {
+                        print("❌ Failed to attach \(childId) to \(parentId)")
+                        return false
+                    }
+                case let .detach(childId):
+                    _ = detachView(childId: childId)
+                case let .setChildren(viewId, childrenIds):
+                    if !setChildren(viewId: viewId, childrenIds: childrenIds) {
+                        print("❌ Failed to set children of \(viewId)")
+                        return false
+                    }
                 }
             }
             
             let attachTime = (CFAbsoluteTimeGetCurrent() - attachStartTime) * 1000
-            print("� iOS_BATCH_TIMING: Attach phase completed in \(String(format: "%.2f", attachTime))ms (\(attachOps.count) attachments)")
+            print("� iOS_BATCH_TIMING: Attach phase completed in \(String(format: "%.2f", attachTime))ms (\(batch.hierarchyOps.count) attachments)")
             
             let eventsStartTime = CFAbsoluteTimeGetCurrent()
             
             // Register all event listeners
-            for op in eventOps {
+            for op in batch.eventOps {
                 DCMauiEventMethodHandler.shared.addEventListenersForBatch(viewId: op.viewId, eventTypes: op.eventTypes)
             }
+            for op in batch.removeEventOps {
+                _ = DCMauiEventMethodHandler.shared.removeEventListeners(viewId: op.viewId, eventTypes: op.eventTypes)
+            }
             
             let eventsTime = (CFAbsoluteTimeGetCurrent() - eventsStartTime) * 1000
-            print("📊 iOS_BATCH_TIMING: Events phase completed in \(String(format: "%.2f", eventsTime))ms (\(eventOps.count) registrations)")
+            print("📊 iOS_BATCH_TIMING: Events phase completed in \(String(format: "%.2f", eventsTime))ms (\(batch.eventOps.count) registrations)")
             
             let layoutStartTime = CFAbsoluteTimeGetCurrent()
             
@@ -745,7 +837,7 @@ import Foundation
             print("� iOS_BATCH_TIMING: Layout phase completed in \(String(format: "%.2f", layoutTime))ms")
             
             let totalTime = (CFAbsoluteTimeGetCurrent() - startTime) * 1000
-            print("📊 iOS_BATCH_TIMING: ✅ TOTAL BATCH COMMIT TIME: \(String(format: "%.2f", totalTime))ms for \(updates.count) operations")
+            print("📊 iOS_BATCH_TIMING: ✅ TOTAL BATCH COMMIT TIME: \(String(format: "%.2f", totalTime))ms for \(batch.count) operations")
             print("🔥 iOS_BATCH_COMMIT: Successfully committed all operations atomically")
             
             return true
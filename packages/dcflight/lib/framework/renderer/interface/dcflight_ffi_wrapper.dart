@@ -10,11 +10,14 @@ import 'dart:ffi' as ffi;
 import 'dart:io' show Platform;
 import 'dart:convert';
 import 'dart:developer';
+import 'dart:typed_data';
 import 'package:ffi/ffi.dart';
 
 import 'src/generated/dcflight_ffi_bindings.dart';
 import 'interface.dart';
 import 'interface_util.dart';
+import 'mutation_encoder.dart';
+import 'result_reader.dart';
 import '../../events/event_registry.dart';
 
 /// Wrapper for iOS DCFlight bridge using FFI.
@@ -33,9 +36,18 @@ class DCFlightFfiWrapper implements PlatformInterface {
   static DCFlightEventCallback? _eventCallback;
   static DCFlightScreenDimensionsCallback? _screenDimensionsCallback;
   static void Function(Map<String, dynamic>)? _screenDimensionsChangeHandler;
+  // Reused by every drain of the event ring
+  static ffi.Pointer<DCFlightEventSpan>? _eventSpan;
+  // Events of which only the latest per view matters between two drains, so
+  // that a fling costs one scroll event per frame rather than one per callback
+  static const _coalescableEventTypes = ['onScroll', 'onContentSizeChange'];
+  // Posts to this isolate when native code queues events or screen dimensions
+  static ffi.NativeCallable<DCFlightWakeCallbackFunction>? _wakeCallback;
+  // Reused by every call returning a result
+  static ffi.Pointer<DCFlightResult>? _result;
   
   bool _batchUpdateInProgress = false;
-  final List<Map<String, dynamic>> _pendingBatchUpdates = [];
+  final MutationEncoder _batchEncoder = MutationEncoder();
 
   /// Gets the FFI bindings instance.
   ///
@@ -103,6 +115,20 @@ class DCFlightFfiWrapper implements PlatformInterface {
     });
   }
   
+  /// Reads the result [query] returns in native memory, then releases it.
+  /// Returns null if the query fails.
+  static dynamic _readResult(bool Function(ffi.Pointer<DCFlightResult>) query) {
+    final result = _result ??= malloc<DCFlightResult>();
+    if (!query(result)) {
+      return null;
+    }
+    try {
+      return ResultReader.read(result.ref);
+    } finally {
+      _bindings!.dcflight_results_release();
+    }
+  }
+
   /// Static method to get screen dimensions (for ScreenUtilities)
   static Future<Map<String, dynamic>?> getScreenDimensions() async {
     try {
@@ -110,34 +136,23 @@ class DCFlightFfiWrapper implements PlatformInterface {
         final wrapper = DCFlightFfiWrapper();
         await wrapper.initialize();
       }
-      final resultBuffer = malloc<ffi.Uint8>(1024);
-      try {
-        final success = _bindings!.dcflight_get_screen_dimensions(
-          resultBuffer.cast(),
-          1024,
-        ) == 1;
-        
-        if (!success) {
-          return null;
-        }
-        
-        final dimensionsStr = resultBuffer.cast<Utf8>().toDartString();
-        final dimensions = jsonDecode(dimensionsStr) as Map<String, dynamic>;
-        // Normalize all numeric values to double (iOS JSON can return int for CGFloat)
-        return <String, dynamic>{
-          'width': (dimensions['width'] as num?)?.toDouble() ?? 0.0,
-          'height': (dimensions['height'] as num?)?.toDouble() ?? 0.0,
-          'scale': (dimensions['scale'] as num?)?.toDouble() ?? 1.0,
-          'fontScale': (dimensions['fontScale'] as num?)?.toDouble() ?? 1.0,
-          'statusBarHeight': (dimensions['statusBarHeight'] as num?)?.toDouble() ?? 0.0,
-          'safeAreaTop': (dimensions['safeAreaTop'] as num?)?.toDouble() ?? 0.0,
-          'safeAreaBottom': (dimensions['safeAreaBottom'] as num?)?.toDouble() ?? 0.0,
-          'safeAreaLeft': (dimensions['safeAreaLeft'] as num?)?.toDouble() ?? 0.0,
-          'safeAreaRight': (dimensions['safeAreaRight'] as num?)?.toDouble() ?? 0.0,
-        };
-      } finally {
-        malloc.free(resultBuffer);
+      final dimensions = _readResult(_bindings!.dcflight_get_screen_dimensions_result)
+          as Map<String, dynamic>?;
+      if (dimensions == null) {
+        return null;
       }
+      // Normalize all numeric values to double (iOS can return int for CGFloat)
+      return <String, dynamic>{
+        'width': (dimensions['width'] as num?)?.toDouble() ?? 0.0,
+        'height': (dimensions['height'] as num?)?.toDouble() ?? 0.0,
+        'scale': (dimensions['scale'] as num?)?.toDouble() ?? 1.0,
+        'fontScale': (dimensions['fontScale'] as num?)?.toDouble() ?? 1.0,
+        'statusBarHeight': (dimensions['statusBarHeight'] as num?)?.toDouble() ?? 0.0,
+        'safeAreaTop': (dimensions['safeAreaTop'] as num?)?.toDouble() ?? 0.0,
+        'safeAreaBottom': (dimensions['safeAreaBottom'] as num?)?.toDouble() ?? 0.0,
+        'safeAreaLeft': (dimensions['safeAreaLeft'] as num?)?.toDouble() ?? 0.0,
+        'safeAreaRight': (dimensions['safeAreaRight'] as num?)?.toDouble() ?? 0.0,
+      };
     } catch (e) {
       log('Error getting screen dimensions: $e');
       return null;
@@ -154,30 +169,9 @@ class DCFlightFfiWrapper implements PlatformInterface {
         final wrapper = DCFlightFfiWrapper();
         await wrapper.initialize();
       }
-      final resultBuffer = malloc<ffi.Char>(256);
-      try {
-        // Zero-initialize buffer using Uint8 view
-        resultBuffer.cast<ffi.Uint8>().asTypedList(256).fillRange(0, 256, 0);
-        
-        log('🔥 DCFlightFfiWrapper: Calling dcflight_get_session_token...');
-        final success = _bindings!.dcflight_get_session_token(
-          resultBuffer,
-          256,
-        );
-        
-        log('🔥 DCFlightFfiWrapper: dcflight_get_session_token returned: success=$success');
-        
-        if (!success) {
-          log('❌ DCFlightFfiWrapper: Failed to get session token');
-          return null;
-        }
-        
-        final tokenStr = resultBuffer.cast<Utf8>().toDartString();
-        log('🔥 DCFlightFfiWrapper: Token from native: "$tokenStr" (length: ${tokenStr.length})');
-        return tokenStr.isEmpty ? null : tokenStr;
-      } finally {
-        malloc.free(resultBuffer);
-      }
+      final token = _readResult(_bindings!.dcflight_get_session_token_result) as String?;
+      log('🔥 DCFlightFfiWrapper: Token from native: "$token"');
+      return token == null || token.isEmpty ? null : token;
     } catch (e) {
       log('Error getting session token: $e');
       return null;
@@ -190,42 +184,13 @@ class DCFlightFfiWrapper implements PlatformInterface {
         final wrapper = DCFlightFfiWrapper();
         await wrapper.initialize();
       }
-      final resultBuffer = malloc<ffi.Char>(256);
-      try {
-        // Zero-initialize buffer using Uint8 view
-        resultBuffer.cast<ffi.Uint8>().asTypedList(256).fillRange(0, 256, 0);
-        
-        log('🔥 DCFlightFfiWrapper: Calling dcflight_create_session_token...');
-        final success = _bindings!.dcflight_create_session_token(
-          resultBuffer,
-          256,
-        );
-        
-        log('🔥 DCFlightFfiWrapper: dcflight_create_session_token returned: success=$success');
-        
-        if (!success) {
-          log('❌ DCFlightFfiWrapper: Failed to create session token');
-          // Check buffer contents even on failure
-          final bufferHex = resultBuffer.cast<ffi.Uint8>().asTypedList(50).map((b) => b.toRadixString(16).padLeft(2, '0')).join(' ');
-          log('⚠️ DCFlightFfiWrapper: Buffer contents on failure: $bufferHex');
-          return '';
-        }
-        
-        final tokenStr = resultBuffer.cast<Utf8>().toDartString();
-        log('🔥 DCFlightFfiWrapper: Token from native: "$tokenStr" (length: ${tokenStr.length})');
-        
-        if (tokenStr.isEmpty) {
-          final bufferHex = resultBuffer.cast<ffi.Uint8>().asTypedList(50).map((b) => b.toRadixString(16).padLeft(2, '0')).join(' ');
-          log('⚠️ DCFlightFfiWrapper: Token is empty! Buffer contents: $bufferHex');
-          // Try reading as raw bytes to see what's there
-          final rawBytes = resultBuffer.cast<ffi.Uint8>().asTypedList(50).where((b) => b != 0).toList();
-          log('⚠️ DCFlightFfiWrapper: Non-zero bytes in buffer: $rawBytes');
-        }
-        
-        return tokenStr;
-      } finally {
-        malloc.free(resultBuffer);
+      final token = _readResult(_bindings!.dcflight_create_session_token_result) as String?;
+      if (token == null) {
+        log('❌ DCFlightFfiWrapper: Failed to create session token');
+        return '';
       }
+      log('🔥 DCFlightFfiWrapper: Token from native: "$token" (length: ${token.length})');
+      return token;
     } catch (e, stackTrace) {
       log('❌ DCFlightFfiWrapper: Error creating session token: $e');
       log('Stack trace: $stackTrace');
@@ -302,8 +267,8 @@ class DCFlightFfiWrapper implements PlatformInterface {
         log('❌ DCFlightFfiWrapper: Initialization failed - dcflight_initialize returned false');
       } else {
         log('✅ DCFlightFfiWrapper: Initialization succeeded');
-        // Start polling for queued events from native threads
-        _startEventPoller();
+        // Drain events queued from native threads when woken
+        _startEventDelivery();
       }
       return result;
     } catch (e, stackTrace) {
@@ -313,70 +278,118 @@ class DCFlightFfiWrapper implements PlatformInterface {
     }
   }
   
-  /// Start polling for queued events from native threads
-  /// Since FFI callbacks can't be called from native threads, we use polling
-  void _startEventPoller() {
-    Timer.periodic(const Duration(milliseconds: 16), (timer) {
+  /// Reads the events queued in the native event ring in place and dispatches
+  /// them. The records are released before dispatching, so that handlers that
+  /// trigger more events do not find the ring full.
+  void _drainEvents() {
+    final span = _eventSpan ??= calloc<DCFlightEventSpan>();
+    final count = _ffi.dcflight_events_begin_read(span);
+    if (count == 0) {
+      return;
+    }
+
+    final ring = span.ref;
+    final payloads = ring.payloads.asTypedList(ring.payloadCapacity);
+    final events = <(int, String, String)>[];
+    for (var i = 0; i < count; i++) {
+      final record = ring.records[(ring.first + i) & (ring.capacity - 1)];
+      // A later event of the same view replaces it
+      if ((record.flags & DCFLIGHT_EVENT_SUPERSEDED) != 0) {
+        continue;
+      }
+      final typeStart = record.payloadOffset;
+      final dataStart = typeStart + record.eventTypeLength;
+      // Malformed UTF-8 must not throw before the records are released
+      events.add((
+        record.viewId,
+        utf8.decode(Uint8List.sublistView(payloads, typeStart, dataStart),
+            allowMalformed: true),
+        utf8.decode(
+            Uint8List.sublistView(
+                payloads, dataStart, dataStart + record.eventDataLength),
+            allowMalformed: true),
+      ));
+    }
+    _ffi.dcflight_events_end_read(count);
+
+    for (final (viewId, eventType, eventDataJson) in events) {
       try {
-        // Poll for queued events
-        final eventsJsonPtr = _ffi.dcflight_get_queued_events();
-        if (eventsJsonPtr != ffi.nullptr) {
-          try {
-            final eventsJson = eventsJsonPtr.cast<Utf8>().toDartString();
-            final events = jsonDecode(eventsJson) as List<dynamic>;
-            for (final event in events) {
-              final eventMap = event as Map<String, dynamic>;
-              final viewId = eventMap['viewId'] as int;
-              final eventType = eventMap['eventType'] as String;
-              final eventDataJson = eventMap['eventDataJson'] as String;
-              
-              Map<String, dynamic> eventData = {};
-              if (eventDataJson.isNotEmpty && eventDataJson != 'null') {
-                try {
-                  eventData = jsonDecode(eventDataJson) as Map<String, dynamic>;
-                } catch (e) {
-                  log('Error parsing event data JSON: $e');
-                }
-              }
-              
-              _eventRegistry.handleEvent(viewId, eventType, eventData);
-            }
-            // Free the memory allocated by native code (strdup)
-            malloc.free(eventsJsonPtr);
-          } catch (e) {
-            log('Error processing queued events: $e');
-          }
-        }
-        
-        // Poll for queued screen dimensions changes
-        final dimensionsJsonPtr = _ffi.dcflight_get_queued_screen_dimensions();
-        if (dimensionsJsonPtr != ffi.nullptr) {
+        Map<String, dynamic> eventData = {};
+        if (eventDataJson.isNotEmpty && eventDataJson != 'null') {
           try {
-            final dimensionsJson = dimensionsJsonPtr.cast<Utf8>().toDartString();
-            final dimensions = jsonDecode(dimensionsJson) as Map<String, dynamic>;
-            // Normalize all numeric values to double (iOS JSON can return int for CGFloat)
-            final normalizedDimensions = <String, dynamic>{
-              'width': (dimensions['width'] as num?)?.toDouble() ?? 0.0,
-              'height': (dimensions['height'] as num?)?.toDouble() ?? 0.0,
-              'scale': (dimensions['scale'] as num?)?.toDouble() ?? 1.0,
-              'fontScale': (dimensions['fontScale'] as num?)?.toDouble() ?? 1.0,
-              'statusBarHeight': (dimensions['statusBarHeight'] as num?)?.toDouble() ?? 0.0,
-              'safeAreaTop': (dimensions['safeAreaTop'] as num?)?.toDouble() ?? 0.0,
-              'safeAreaBottom': (dimensions['safeAreaBottom'] as num?)?.toDouble() ?? 0.0,
-              'safeAreaLeft': (dimensions['safeAreaLeft'] as num?)?.toDouble() ?? 0.0,
-              'safeAreaRight': (dimensions['safeAreaRight'] as num?)?.toDouble() ?? 0.0,
-            };
-            _screenDimensionsChangeHandler?.call(normalizedDimensions);
-            // Free the memory allocated by native code (strdup)
-            malloc.free(dimensionsJsonPtr);
+            eventData = jsonDecode(eventDataJson) as Map<String, dynamic>;
           } catch (e) {
-            log('Error processing queued screen dimensions: $e');
+            log('Error parsing event data JSON: $e');
           }
         }
+
+        _eventRegistry.handleEvent(viewId, eventType, eventData);
       } catch (e) {
-        // Ignore errors in polling - it's best effort
+        log('Error processing queued events: $e');
       }
-    });
+    }
+  }
+
+  /// Drains what native threads queued whenever they wake this isolate,
+  /// rather than polling on a timer: FFI callbacks can't be called from native
+  /// threads, but a listener callable posts to the isolate from any thread.
+  /// Native code only wakes it once until the next drain, so a burst of
+  /// events costs one wake-up and an idle app is never woken.
+  void _startEventDelivery() {
+    if (_wakeCallback != null) {
+      return;
+    }
+    for (final eventType in _coalescableEventTypes) {
+      final eventTypePtr = eventType.toNativeUtf8();
+      try {
+        _ffi.dcflight_events_set_coalescable(eventTypePtr.cast(), true);
+      } finally {
+        malloc.free(eventTypePtr);
+      }
+    }
+    final callback = ffi.NativeCallable<DCFlightWakeCallbackFunction>.listener(
+        _drainQueues);
+    _wakeCallback = callback;
+    _ffi.dcflight_set_wake_callback(callback.nativeFunction);
+    // Whatever was queued before the callback was set
+    _drainQueues();
+  }
+
+  void _drainQueues() {
+    try {
+      // Draining the events rearms the wake-up, so it comes first
+      _drainEvents();
+      _drainScreenDimensions();
+    } catch (e) {
+      log('Error draining queued events: $e');
+    }
+  }
+
+  void _drainScreenDimensions() {
+    final dimensionsJsonPtr = _ffi.dcflight_get_queued_screen_dimensions();
+    if (dimensionsJsonPtr != ffi.nullptr) {
+      try {
+        final dimensionsJson = dimensionsJsonPtr.cast<Utf8>().toDartString();
+        final dimensions = jsonDecode(dimensionsJson) as Map<String, dynamic>;
+        // Normalize all numeric values to double (iOS JSON can return int for CGFloat)
+        final normalizedDimensions = <String, dynamic>{
+          'width': (dimensions['width'] as num?)?.toDouble() ?? 0.0,
+          'height': (dimensions['height'] as num?)?.toDouble() ?? 0.0,
+          'scale': (dimensions['scale'] as num?)?.toDouble() ?? 1.0,
+          'fontScale': (dimensions['fontScale'] as num?)?.toDouble() ?? 1.0,
+          'statusBarHeight': (dimensions['statusBarHeight'] as num?)?.toDouble() ?? 0.0,
+          'safeAreaTop': (dimensions['safeAreaTop'] as num?)?.toDouble() ?? 0.0,
+          'safeAreaBottom': (dimensions['safeAreaBottom'] as num?)?.toDouble() ?? 0.0,
+          'safeAreaLeft': (dimensions['safeAreaLeft'] as num?)?.toDouble() ?? 0.0,
+          'safeAreaRight': (dimensions['safeAreaRight'] as num?)?.toDouble() ?? 0.0,
+        };
+        _screenDimensionsChangeHandler?.call(normalizedDimensions);
+        // Free the memory allocated by native code (strdup)
+        malloc.free(dimensionsJsonPtr);
+      } catch (e) {
+        log('Error processing queued screen dimensions: $e');
+      }
+    }
   }
 
   @override
@@ -384,14 +397,14 @@ class DCFlightFfiWrapper implements PlatformInterface {
     final processedProps = preprocessProps(props);
     
     if (_batchUpdateInProgress) {
-      final propsJson = jsonEncode(processedProps);
-      _pendingBatchUpdates.add({
-        'operation': 'createView',
-        'viewId': viewId,
-        'viewType': type,
-        'propsJson': propsJson,
-      });
-      return true;
+      // A prop which cannot be encoded only loses this op, not the batch
+      try {
+        _batchEncoder.createView(viewId, type, processedProps);
+        return true;
+      } catch (e) {
+        log('Error encoding view creation: $e');
+        return false;
+      }
     }
     
     try {
@@ -415,13 +428,13 @@ class DCFlightFfiWrapper implements PlatformInterface {
     final processedProps = preprocessProps(propPatches);
     
     if (_batchUpdateInProgress) {
-      final propsJson = jsonEncode(processedProps);
-      _pendingBatchUpdates.add({
-        'operation': 'updateView',
-        'viewId': viewId,
-        'propsJson': propsJson,
-      });
-      return true;
+      try {
+        _batchEncoder.updateView(viewId, processedProps);
+        return true;
+      } catch (e) {
+        log('Error encoding view update: $e');
+        return false;
+      }
     }
     
     try {
@@ -441,10 +454,7 @@ class DCFlightFfiWrapper implements PlatformInterface {
   @override
   Future<bool> deleteView(int viewId) async {
     if (_batchUpdateInProgress) {
-      _pendingBatchUpdates.add({
-        'operation': 'deleteView',
-        'viewId': viewId,
-      });
+      _batchEncoder.deleteView(viewId);
       return true;
     }
     
@@ -469,12 +479,7 @@ class DCFlightFfiWrapper implements PlatformInterface {
   @override
   Future<bool> attachView(int childId, int parentId, int index) async {
     if (_batchUpdateInProgress) {
-      _pendingBatchUpdates.add({
-        'operation': 'attachView',
-        'childId': childId,
-        'parentId': parentId,
-        'index': index,
-      });
+      _batchEncoder.attachView(childId, parentId, index);
       return true;
     }
     
@@ -489,11 +494,7 @@ class DCFlightFfiWrapper implements PlatformInterface {
   @override
   Future<bool> setChildren(int viewId, List<int> childrenIds) async {
     if (_batchUpdateInProgress) {
-      _pendingBatchUpdates.add({
-        'operation': 'setChildren',
-        'viewId': viewId,
-        'childrenIds': childrenIds,
-      });
+      _batchEncoder.setChildren(viewId, childrenIds);
       return true;
     }
     
@@ -516,11 +517,7 @@ class DCFlightFfiWrapper implements PlatformInterface {
   @override
   Future<bool> addEventListeners(int viewId, List<String> eventTypes) async {
     if (_batchUpdateInProgress) {
-      _pendingBatchUpdates.add({
-        'operation': 'addEventListeners',
-        'viewId': viewId,
-        'eventTypes': eventTypes,
-      });
+      _batchEncoder.addEventListeners(viewId, eventTypes);
       return true;
     }
     
@@ -571,7 +568,7 @@ class DCFlightFfiWrapper implements PlatformInterface {
     }
     
     _batchUpdateInProgress = true;
-    _pendingBatchUpdates.clear();
+    _batchEncoder.discard();
     
     try {
       return _ffi.dcflight_start_batch_update() == 1;
@@ -589,21 +586,28 @@ class DCFlightFfiWrapper implements PlatformInterface {
     }
     
     try {
-      final operationsJson = jsonEncode(_pendingBatchUpdates);
-      final operationsJsonPtr = operationsJson.toNativeUtf8();
+      // Ops are encoded with the binary mutation protocol as they are queued,
+      // so committing is a single copy into native memory
+      final buffer = _batchEncoder.finish();
+      final bufferPtr = malloc<ffi.Uint8>(buffer.length);
       try {
-        final success = _ffi.dcflight_commit_batch_update(operationsJsonPtr.cast()) == 1;
+        bufferPtr.asTypedList(buffer.length).setAll(0, buffer);
+        final success = _ffi.dcflight_commit_batch_binary(bufferPtr, buffer.length);
+        if (!success) {
+          // The native string table may not have applied this buffer
+          _batchEncoder.resetStrings();
+        }
         
         _batchUpdateInProgress = false;
-        _pendingBatchUpdates.clear();
         return success;
       } finally {
-        malloc.free(operationsJsonPtr);
+        malloc.free(bufferPtr);
       }
     } catch (e) {
       log('Error committing batch update via FFI: $e');
       _batchUpdateInProgress = false;
-      _pendingBatchUpdates.clear();
+      _batchEncoder.discard();
+      _batchEncoder.resetStrings();
       return false;
     }
   }
@@ -615,7 +619,7 @@ class DCFlightFfiWrapper implements PlatformInterface {
     }
     
     _batchUpdateInProgress = false;
-    _pendingBatchUpdates.clear();
+    _batchEncoder.discard();
     
     try {
       return _ffi.dcflight_cancel_batch_update() == 1;
@@ -637,28 +641,15 @@ class DCFlightFfiWrapper implements PlatformInterface {
       final componentTypePtr = componentType.toNativeUtf8();
       final methodPtr = method.toNativeUtf8();
       final paramsJsonPtr = paramsJson.toNativeUtf8();
-      final resultBuffer = malloc<ffi.Uint8>(4096);
       try {
-        final success = _ffi.dcflight_tunnel(
-          componentTypePtr.cast(),
-          methodPtr.cast(),
-          paramsJsonPtr.cast(),
-          resultBuffer.cast(),
-          4096,
-        ) == 1;
-        
-        if (!success) {
-          return null;
-        }
-        
-        final resultStr = resultBuffer.cast<Utf8>().toDartString();
-        if (resultStr == 'null') {
-          return null;
-        }
-        
-        return jsonDecode(resultStr);
+        // The result is read from native memory rather than parsed from JSON
+        return _readResult((result) => _ffi.dcflight_tunnel_result(
+              componentTypePtr.cast(),
+              methodPtr.cast(),
+              paramsJsonPtr.cast(),
+              result,
+            ));
       } finally {
-        malloc.free(resultBuffer);
         malloc.free(componentTypePtr);
         malloc.free(methodPtr);
         malloc.free(paramsJsonPtr);
@@ -0,0 +1,328 @@
+/*
+ * Copyright (c) Dotcorr Studio. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+import 'dart:convert';
+import 'dart:typed_data';
+
+/// Encodes view tree mutations with the binary mutation protocol.
+///
+/// The format is documented in `src/dcflight/mutation/MutationProtocol.h` and
+/// decoded natively by `dcflight_commit_batch_binary`. View types, prop keys
+/// and event types are interned: each string is sent once per session and
+/// referenced by id afterwards, so the buffers returned by [finish] must be
+/// committed in order.
+class MutationEncoder {
+  static const int _magic = 0x4d464344; // 'DCFM'
+  static const int _version = 1;
+  static const int _headerSize = 20;
+  static const int _flagResetStrings = 1;
+
+  static const int _opCreateView = 1;
+  static const int _opUpdateView = 2;
+  static const int _opDeleteView = 3;
+  static const int _opAttachView = 4;
+  static const int _opDetachView = 5;
+  static const int _opSetChildren = 6;
+  static const int _opAddEventListeners = 7;
+  static const int _opRemoveEventListeners = 8;
+
+  static const int _typeNull = 0;
+  static const int _typeFalse = 1;
+  static const int _typeTrue = 2;
+  static const int _typeInt = 3;
+  static const int _typeDouble = 4;
+  static const int _typeString = 5;
+  static const int _typeList = 6;
+  static const int _typeMap = 7;
+
+  /// Once this many strings are interned the table is reset, so that maps
+  /// with data-dependent keys cannot grow it for the rest of the session.
+  static const int maxInternedStrings = 1 << 16;
+
+  final Map<String, int> _ids = {};
+  int _firstStringId = 0;
+  bool _resetStrings = true;
+  final _ByteWriter _strings = _ByteWriter();
+  int _stringCount = 0;
+
+  final _ByteWriter _ops = _ByteWriter();
+  int _opCount = 0;
+
+  /// Number of ops written since the last [finish].
+  int get opCount => _opCount;
+
+  /// Forgets every interned string. The next buffer asks the native decoder to
+  /// do the same, e.g. to recover after a commit failed.
+  void resetStrings() {
+    _ids.clear();
+    _strings.clear();
+    _stringCount = 0;
+    _firstStringId = 0;
+    _resetStrings = true;
+  }
+
+  /// Drops the ops written since the last [finish]. Strings they interned are
+  /// still defined by the next buffer.
+  void discard() {
+    _ops.clear();
+    _opCount = 0;
+  }
+
+  /// Throws if a prop value cannot be encoded, leaving out the op but not the
+  /// ops written before it.
+  void createView(int viewId, String viewType, Map<String, dynamic> props) {
+    final op = _beginOp(_opCreateView);
+    try {
+      _ops.int32(viewId);
+      _ops.uint32(_intern(viewType));
+      _writeMapBody(props);
+    } catch (_) {
+      _abortOp(op);
+      rethrow;
+    }
+    _endOp(op);
+  }
+
+  /// Throws if a prop value cannot be encoded, like [createView].
+  void updateView(int viewId, Map<String, dynamic> props) {
+    final op = _beginOp(_opUpdateView);
+    try {
+      _ops.int32(viewId);
+      _writeMapBody(props);
+    } catch (_) {
+      _abortOp(op);
+      rethrow;
+    }
+    _endOp(op);
+  }
+
+  void deleteView(int viewId) {
+    final op = _beginOp(_opDeleteView);
+    _ops.int32(viewId);
+    _endOp(op);
+  }
+
+  void attachView(int childId, int parentId, int index) {
+    final op = _beginOp(_opAttachView);
+    _ops.int32(childId);
+    _ops.int32(parentId);
+    _ops.int32(index);
+    _endOp(op);
+  }
+
+  void detachView(int viewId) {
+    final op = _beginOp(_opDetachView);
+    _ops.int32(viewId);
+    _endOp(op);
+  }
+
+  void setChildren(int viewId, List<int> childIds) {
+    final op = _beginOp(_opSetChildren);
+    _ops.int32(viewId);
+    _ops.uint32(childIds.length);
+    for (final childId in childIds) {
+      _ops.int32(childId);
+    }
+    _endOp(op);
+  }
+
+  void addEventListeners(int viewId, List<String> eventTypes) {
+    _writeEventListeners(_opAddEventListeners, viewId, eventTypes);
+  }
+
+  void removeEventListeners(int viewId, List<String> eventTypes) {
+    _writeEventListeners(_opRemoveEventListeners, viewId, eventTypes);
+  }
+
+  /// Returns the buffer holding every op written since the last call, and
+  /// starts a new one.
+  Uint8List finish() {
+    final buffer = Uint8List(_headerSize + _strings.length + _ops.length);
+    ByteData.sublistView(buffer, 0, _headerSize)
+      ..setUint32(0, _magic, Endian.little)
+      ..setUint16(4, _version, Endian.little)
+      ..setUint16(6, _resetStrings ? _flagResetStrings : 0, Endian.little)
+      ..setUint32(8, _firstStringId, Endian.little)
+      ..setUint32(12, _stringCount, Endian.little)
+      ..setUint32(16, _opCount, Endian.little);
+    buffer.setRange(
+        _headerSize, _headerSize + _strings.length, _strings.view());
+    buffer.setRange(_headerSize + _strings.length, buffer.length, _ops.view());
+
+    _firstStringId += _stringCount;
+    _stringCount = 0;
+    _strings.clear();
+    _resetStrings = false;
+    discard();
+    if (_ids.length >= maxInternedStrings) {
+      resetStrings();
+    }
+    return buffer;
+  }
+
+  int _intern(String string) {
+    final existing = _ids[string];
+    if (existing != null) {
+      return existing;
+    }
+    final id = _ids.length;
+    _ids[string] = id;
+    final bytes = utf8.encode(string);
+    _strings.uint32(bytes.length);
+    _strings.bytes(bytes);
+    _stringCount++;
+    return id;
+  }
+
+  int _beginOp(int opcode) {
+    _ops.uint8(opcode);
+    final start = _ops.length;
+    _ops.uint32(0);
+    return start;
+  }
+
+  void _endOp(int start) {
+    _ops.patchUint32(start, _ops.length - start - 4);
+    _opCount++;
+  }
+
+  // Truncates an op whose encoding threw, from its opcode before `start`, so
+  // that the buffer stays decodable
+  void _abortOp(int start) {
+    _ops.length = start - 1;
+  }
+
+  void _writeEventListeners(int opcode, int viewId, List<String> eventTypes) {
+    final op = _beginOp(opcode);
+    _ops.int32(viewId);
+    _ops.uint32(eventTypes.length);
+    for (final eventType in eventTypes) {
+      _ops.uint32(_intern(eventType));
+    }
+    _endOp(op);
+  }
+
+  // Containers are prefixed by their byte length and item count, which are
+  // patched in once the items are written
+  int _beginContainer() {
+    final start = _ops.length;
+    _ops.uint32(0);
+    _ops.uint32(0);
+    return start;
+  }
+
+  void _endContainer(int start, int count) {
+    _ops.patchUint32(start, _ops.length - start - 4);
+    _ops.patchUint32(start + 4, count);
+  }
+
+  void _writeMapBody(Map map) {
+    final start = _beginContainer();
+    map.forEach((key, value) {
+      _ops.uint32(_intern(key.toString()));
+      _writeValue(value);
+    });
+    _endContainer(start, map.length);
+  }
+
+  void _writeValue(Object? value) {
+    if (value == null) {
+      _ops.uint8(_typeNull);
+    } else if (value is bool) {
+      _ops.uint8(value ? _typeTrue : _typeFalse);
+    } else if (value is int) {
+      _ops.uint8(_typeInt);
+      _ops.int64(value);
+    } else if (value is double) {
+      _ops.uint8(_typeDouble);
+      _ops.float64(value);
+    } else if (value is String) {
+      _ops.uint8(_typeString);
+      final bytes = utf8.encode(value);
+      _ops.uint32(bytes.length);
+      _ops.bytes(bytes);
+    } else if (value is List) {
+      _ops.uint8(_typeList);
+      final start = _beginContainer();
+      for (final item in value) {
+        _writeValue(item);
+      }
+      _endContainer(start, value.length);
+    } else if (value is Map) {
+      _ops.uint8(_typeMap);
+      _writeMapBody(value);
+    } else {
+      // Other objects are sent the way the JSON bridge sends them, through
+      // their toJson()
+      _writeValue(jsonDecode(jsonEncode(value)));
+    }
+  }
+}
+
+/// Growable little-endian byte buffer.
+class _ByteWriter {
+  Uint8List _bytes = Uint8List(1024);
+  late ByteData _data = ByteData.sublistView(_bytes);
+  int length = 0;
+
+  void clear() {
+    length = 0;
+  }
+
+  Uint8List view() => Uint8List.sublistView(_bytes, 0, length);
+
+  void _reserve(int count) {
+    if (length + count <= _bytes.length) {
+      return;
+    }
+    var capacity = _bytes.length * 2;
+    while (capacity < length + count) {
+      capacity *= 2;
+    }
+    _bytes = Uint8List(capacity)..setRange(0, length, _bytes);
+    _data = ByteData.sublistView(_bytes);
+  }
+
+  void uint8(int value) {
+    _reserve(1);
+    _bytes[length++] = value;
+  }
+
+  void uint32(int value) {
+    _reserve(4);
+    _data.setUint32(length, value, Endian.little);
+    length += 4;
+  }
+
+  void int32(int value) {
+    _reserve(4);
+    _data.setInt32(length, value, Endian.little);
+    length += 4;
+  }
+
+  void int64(int value) {
+    _reserve(8);
+    _data.setInt64(length, value, Endian.little);
+    length += 8;
+  }
+
+  void float64(double value) {
+    _reserve(8);
+    _data.setFloat64(length, value, Endian.little);
+    length += 8;
+  }
+
+  void bytes(List<int> bytes) {
+    _reserve(bytes.length);
+    _bytes.setRange(length, length + bytes.length, bytes);
+    length += bytes.length;
+  }
+
+  void patchUint32(int offset, int value) {
+    _data.setUint32(offset, value, Endian.little);
+  }
+}
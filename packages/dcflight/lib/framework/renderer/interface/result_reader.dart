@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) Dotcorr Studio. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+import 'dart:convert';
+import 'dart:ffi' as ffi;
+import 'dart:typed_data';
+
+import 'src/generated/dcflight_ffi_bindings.dart';
+
+/// Reads the results native code returns in place of JSON, such as the result
+/// of a tunnel method.
+///
+/// The format is documented in `src/dcflight/result/ResultProtocol.h`. The
+/// bytes are read where native code wrote them, and stay valid until
+/// `dcflight_results_release`, so a result must be read before its release.
+/// Values read as `jsonDecode` would return them.
+class ResultReader {
+  static const int _typeNull = 0;
+  static const int _typeFalse = 1;
+  static const int _typeTrue = 2;
+  static const int _typeInt = 3;
+  static const int _typeDouble = 4;
+  static const int _typeString = 5;
+  static const int _typeList = 6;
+  static const int _typeMap = 7;
+
+  final ByteData _data;
+  int _offset = 0;
+
+  ResultReader._(this._data);
+
+  /// Reads the value of [result].
+  static dynamic read(DCFlightResult result) {
+    if (result.data == ffi.nullptr || result.length == 0) {
+      return null;
+    }
+    final bytes = result.data.asTypedList(result.length);
+    final reader = ResultReader._(ByteData.sublistView(bytes));
+    final value = reader._readValue();
+    if (reader._offset != result.length) {
+      throw const FormatException('Trailing bytes after result');
+    }
+    return value;
+  }
+
+  dynamic _readValue() {
+    final type = _data.getUint8(_offset++);
+    switch (type) {
+      case _typeNull:
+        return null;
+      case _typeFalse:
+        return false;
+      case _typeTrue:
+        return true;
+      case _typeInt:
+        final value = _data.getInt64(_offset, Endian.little);
+        _offset += 8;
+        return value;
+      case _typeDouble:
+        final value = _data.getFloat64(_offset, Endian.little);
+        _offset += 8;
+        return value;
+      case _typeString:
+        return _readString();
+      case _typeList:
+        // The byte length is only needed to skip the list
+        _offset += 4;
+        final count = _readUint32();
+        return List<dynamic>.generate(count, (_) => _readValue(), growable: true);
+      case _typeMap:
+        _offset += 4;
+        final count = _readUint32();
+        final map = <String, dynamic>{};
+        for (var i = 0; i < count; i++) {
+          final key = _readString();
+          map[key] = _readValue();
+        }
+        return map;
+      default:
+        throw FormatException('Unknown result value type $type');
+    }
+  }
+
+  int _readUint32() {
+    final value = _data.getUint32(_offset, Endian.little);
+    _offset += 4;
+    return value;
+  }
+
+  String _readString() {
+    final length = _readUint32();
+    final bytes = Uint8List.sublistView(_data, _offset, _offset + length);
+    _offset += length;
+    return utf8.decode(bytes);
+  }
+}
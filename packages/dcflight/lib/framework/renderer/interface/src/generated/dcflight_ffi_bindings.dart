@@ -161,6 +161,20 @@ class DCFlightFfi {
   late final _dcflight_set_children = _dcflight_set_childrenPtr
       .asFunction<bool Function(int, ffi.Pointer<ffi.Int32>, int)>();
 
+  /// Run the view operations queued off the main thread and wait for them.
+  /// Called off the main thread, the view operations above are queued and
+  /// return true once queued; the main thread runs them in order before its
+  /// next frame, before any other call waiting for it, or on this call.
+  void dcflight_flush_view_ops() {
+    return _dcflight_flush_view_ops();
+  }
+
+  late final _dcflight_flush_view_opsPtr =
+      _lookup<ffi.NativeFunction<ffi.Void Function()>>(
+          'dcflight_flush_view_ops');
+  late final _dcflight_flush_view_ops =
+      _dcflight_flush_view_opsPtr.asFunction<void Function()>();
+
   /// Add event listeners to a view
   /// viewId: Unique identifier for the view
   /// eventTypes: Comma-separated string of event types (e.g., "onPress,onChange")
@@ -233,6 +247,26 @@ class DCFlightFfi {
   late final _dcflight_commit_batch_update = _dcflight_commit_batch_updatePtr
       .asFunction<bool Function(ffi.Pointer<ffi.Char>)>();
 
+  /// Commit a batch encoded with the binary mutation protocol
+  /// (see src/dcflight/mutation/MutationProtocol.h). Buffers must be committed in
+  /// the order they were encoded, since they share an interned string table.
+  bool dcflight_commit_batch_binary(
+    ffi.Pointer<ffi.Uint8> buffer,
+    int length,
+  ) {
+    return _dcflight_commit_batch_binary(
+      buffer,
+      length,
+    );
+  }
+
+  late final _dcflight_commit_batch_binaryPtr = _lookup<
+          ffi
+          .NativeFunction<ffi.Bool Function(ffi.Pointer<ffi.Uint8>, ffi.Size)>>(
+      'dcflight_commit_batch_binary');
+  late final _dcflight_commit_batch_binary = _dcflight_commit_batch_binaryPtr
+      .asFunction<bool Function(ffi.Pointer<ffi.Uint8>, int)>();
+
   /// Cancel the pending batch updates
   /// Returns true if a batch was cancelled, false if no batch was in progress
   bool dcflight_cancel_batch_update() {
@@ -280,6 +314,92 @@ class DCFlightFfi {
       bool Function(ffi.Pointer<ffi.Char>, ffi.Pointer<ffi.Char>,
           ffi.Pointer<ffi.Char>, ffi.Pointer<ffi.Char>, int)>();
 
+  /// Call a tunnel method, returning its result of any size in native memory
+  /// rather than as JSON in a fixed buffer. Read it with ResultReader before
+  /// calling dcflight_results_release. A method returning nothing gives a
+  /// null result.
+  bool dcflight_tunnel_result(
+    ffi.Pointer<ffi.Char> componentType,
+    ffi.Pointer<ffi.Char> method,
+    ffi.Pointer<ffi.Char> paramsJson,
+    ffi.Pointer<DCFlightResult> result,
+  ) {
+    return _dcflight_tunnel_result(
+      componentType,
+      method,
+      paramsJson,
+      result,
+    );
+  }
+
+  late final _dcflight_tunnel_resultPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Bool Function(
+              ffi.Pointer<ffi.Char>,
+              ffi.Pointer<ffi.Char>,
+              ffi.Pointer<ffi.Char>,
+              ffi.Pointer<DCFlightResult>)>>('dcflight_tunnel_result');
+  late final _dcflight_tunnel_result = _dcflight_tunnel_resultPtr.asFunction<
+      bool Function(ffi.Pointer<ffi.Char>, ffi.Pointer<ffi.Char>,
+          ffi.Pointer<ffi.Char>, ffi.Pointer<DCFlightResult>)>();
+
+  bool dcflight_get_screen_dimensions_result(
+    ffi.Pointer<DCFlightResult> result,
+  ) {
+    return _dcflight_get_screen_dimensions_result(
+      result,
+    );
+  }
+
+  late final _dcflight_get_screen_dimensions_resultPtr = _lookup<
+          ffi.NativeFunction<ffi.Bool Function(ffi.Pointer<DCFlightResult>)>>(
+      'dcflight_get_screen_dimensions_result');
+  late final _dcflight_get_screen_dimensions_result =
+      _dcflight_get_screen_dimensions_resultPtr
+          .asFunction<bool Function(ffi.Pointer<DCFlightResult>)>();
+
+  /// A null result when there is no token
+  bool dcflight_get_session_token_result(
+    ffi.Pointer<DCFlightResult> result,
+  ) {
+    return _dcflight_get_session_token_result(
+      result,
+    );
+  }
+
+  late final _dcflight_get_session_token_resultPtr = _lookup<
+          ffi.NativeFunction<ffi.Bool Function(ffi.Pointer<DCFlightResult>)>>(
+      'dcflight_get_session_token_result');
+  late final _dcflight_get_session_token_result =
+      _dcflight_get_session_token_resultPtr
+          .asFunction<bool Function(ffi.Pointer<DCFlightResult>)>();
+
+  bool dcflight_create_session_token_result(
+    ffi.Pointer<DCFlightResult> result,
+  ) {
+    return _dcflight_create_session_token_result(
+      result,
+    );
+  }
+
+  late final _dcflight_create_session_token_resultPtr = _lookup<
+          ffi.NativeFunction<ffi.Bool Function(ffi.Pointer<DCFlightResult>)>>(
+      'dcflight_create_session_token_result');
+  late final _dcflight_create_session_token_result =
+      _dcflight_create_session_token_resultPtr
+          .asFunction<bool Function(ffi.Pointer<DCFlightResult>)>();
+
+  /// Release every result returned so far, e.g. once they have been read
+  void dcflight_results_release() {
+    return _dcflight_results_release();
+  }
+
+  late final _dcflight_results_releasePtr =
+      _lookup<ffi.NativeFunction<ffi.Void Function()>>(
+          'dcflight_results_release');
+  late final _dcflight_results_release =
+      _dcflight_results_releasePtr.asFunction<void Function()>();
+
   void dcflight_set_event_callback(
     DCFlightEventCallback callback,
   ) {
@@ -394,6 +514,103 @@ class DCFlightFfi {
   late final _dcflight_get_queued_events =
       _dcflight_get_queued_eventsPtr.asFunction<ffi.Pointer<ffi.Char> Function()>();
 
+  int dcflight_events_begin_read(
+    ffi.Pointer<DCFlightEventSpan> span,
+  ) {
+    return _dcflight_events_begin_read(
+      span,
+    );
+  }
+
+  late final _dcflight_events_begin_readPtr = _lookup<
+          ffi.NativeFunction<ffi.Uint32 Function(ffi.Pointer<DCFlightEventSpan>)>>(
+      'dcflight_events_begin_read');
+  late final _dcflight_events_begin_read = _dcflight_events_begin_readPtr
+      .asFunction<int Function(ffi.Pointer<DCFlightEventSpan>)>();
+
+  void dcflight_events_end_read(
+    int count,
+  ) {
+    return _dcflight_events_end_read(
+      count,
+    );
+  }
+
+  late final _dcflight_events_end_readPtr =
+      _lookup<ffi.NativeFunction<ffi.Void Function(ffi.Uint32)>>(
+          'dcflight_events_end_read');
+  late final _dcflight_events_end_read =
+      _dcflight_events_end_readPtr.asFunction<void Function(int)>();
+
+  int dcflight_events_get_dropped_count() {
+    return _dcflight_events_get_dropped_count();
+  }
+
+  late final _dcflight_events_get_dropped_countPtr =
+      _lookup<ffi.NativeFunction<ffi.Uint64 Function()>>(
+          'dcflight_events_get_dropped_count');
+  late final _dcflight_events_get_dropped_count =
+      _dcflight_events_get_dropped_countPtr.asFunction<int Function()>();
+
+  /// Sets whether the events of a type, e.g. "onScroll", are coalesced per view
+  /// when read: the earlier of the unreleased events of a view and type are
+  /// flagged DCFLIGHT_EVENT_SUPERSEDED. Only the reading thread may call it.
+  void dcflight_events_set_coalescable(
+    ffi.Pointer<ffi.Char> eventType,
+    bool coalescable,
+  ) {
+    return _dcflight_events_set_coalescable(
+      eventType,
+      coalescable,
+    );
+  }
+
+  late final _dcflight_events_set_coalescablePtr = _lookup<
+          ffi.NativeFunction<ffi.Void Function(ffi.Pointer<ffi.Char>, ffi.Bool)>>(
+      'dcflight_events_set_coalescable');
+  late final _dcflight_events_set_coalescable =
+      _dcflight_events_set_coalescablePtr
+          .asFunction<void Function(ffi.Pointer<ffi.Char>, bool)>();
+
+  /// Number of events superseded so far
+  int dcflight_events_get_coalesced_count() {
+    return _dcflight_events_get_coalesced_count();
+  }
+
+  late final _dcflight_events_get_coalesced_countPtr =
+      _lookup<ffi.NativeFunction<ffi.Uint64 Function()>>(
+          'dcflight_events_get_coalesced_count');
+  late final _dcflight_events_get_coalesced_count =
+      _dcflight_events_get_coalesced_countPtr.asFunction<int Function()>();
+
+  /// Sets or, given NULL, clears the callback waking Dart to drain the events and
+  /// screen dimensions, instead of polling. dcflight_events_begin_read() rearms
+  /// it, so Dart must call it before reading the screen dimensions, and once
+  /// after setting the callback for what was queued before.
+  void dcflight_set_wake_callback(
+    DCFlightWakeCallback callback,
+  ) {
+    return _dcflight_set_wake_callback(
+      callback,
+    );
+  }
+
+  late final _dcflight_set_wake_callbackPtr =
+      _lookup<ffi.NativeFunction<ffi.Void Function(DCFlightWakeCallback)>>(
+          'dcflight_set_wake_callback');
+  late final _dcflight_set_wake_callback = _dcflight_set_wake_callbackPtr
+      .asFunction<void Function(DCFlightWakeCallback)>();
+
+  /// Wakes Dart after queueing anything else it drains, from any thread
+  void dcflight_wake_dart() {
+    return _dcflight_wake_dart();
+  }
+
+  late final _dcflight_wake_dartPtr =
+      _lookup<ffi.NativeFunction<ffi.Void Function()>>('dcflight_wake_dart');
+  late final _dcflight_wake_dart =
+      _dcflight_wake_dartPtr.asFunction<void Function()>();
+
   void dcflight_process_event_queue() {
     return _dcflight_process_event_queue();
   }
@@ -586,6 +803,51 @@ final class _opaque_pthread_t extends ffi.Struct {
   external ffi.Array<ffi.Char> __opaque;
 }
 
+final class DCFlightEventRecord extends ffi.Struct {
+  @ffi.Int32()
+  external int viewId;
+
+  @ffi.Uint32()
+  external int eventTypeLength;
+
+  @ffi.Uint32()
+  external int eventDataLength;
+
+  @ffi.Uint32()
+  external int payloadOffset;
+
+  @ffi.Uint32()
+  external int payloadEnd;
+
+  @ffi.Uint32()
+  external int flags;
+}
+
+final class DCFlightEventSpan extends ffi.Struct {
+  external ffi.Pointer<DCFlightEventRecord> records;
+
+  external ffi.Pointer<ffi.Uint8> payloads;
+
+  @ffi.Uint32()
+  external int capacity;
+
+  @ffi.Uint32()
+  external int payloadCapacity;
+
+  @ffi.Uint32()
+  external int first;
+
+  @ffi.Uint32()
+  external int count;
+}
+
+final class DCFlightResult extends ffi.Struct {
+  external ffi.Pointer<ffi.Uint8> data;
+
+  @ffi.Uint32()
+  external int length;
+}
+
 /// Set event callback function pointer for native-to-Dart event communication
 /// This function will be called when native events occur
 /// callback: Function pointer that takes (viewId, eventType, eventDataJson) and returns void
@@ -597,6 +859,14 @@ typedef DCFlightEventCallbackFunction = ffi.Void Function(ffi.Int32 viewId,
 typedef DartDCFlightEventCallbackFunction = void Function(int viewId,
     ffi.Pointer<ffi.Char> eventType, ffi.Pointer<ffi.Char> eventDataJson);
 
+/// Called on the thread which queued an event or screen dimensions, when Dart
+/// has drained everything queued before. It should only schedule the drain,
+/// e.g. a NativeCallable.listener posting to the isolate.
+typedef DCFlightWakeCallback
+    = ffi.Pointer<ffi.NativeFunction<DCFlightWakeCallbackFunction>>;
+typedef DCFlightWakeCallbackFunction = ffi.Void Function();
+typedef DartDCFlightWakeCallbackFunction = void Function();
+
 /// Set screen dimensions callback function pointer for native-to-Dart communication
 /// This function will be called when screen dimensions change
 /// callback: Function pointer that takes (dimensionsJson) and returns void
@@ -608,6 +878,8 @@ typedef DCFlightScreenDimensionsCallbackFunction = ffi.Void Function(
 typedef DartDCFlightScreenDimensionsCallbackFunction = void Function(
     ffi.Pointer<ffi.Char> dimensionsJson);
 
+const int DCFLIGHT_EVENT_SUPERSEDED = 1;
+
 const int __WORDSIZE = 64;
 
 const int __has_safe_buffers = 1;
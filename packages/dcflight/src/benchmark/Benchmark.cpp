@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) Dotcorr Studio. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+#include <Benchmark.h>
+
+// Every allocation made by the process is counted so that the harness can
+// report allocations per operation.
+namespace {
+std::atomic<size_t> gAllocationCount{0};
+} // namespace
+
+void* operator new(size_t size) {
+  gAllocationCount.fetch_add(1, std::memory_order_relaxed);
+  if (void* ptr = std::malloc(size == 0 ? 1 : size)) {
+    return ptr;
+  }
+  throw std::bad_alloc{};
+}
+
+void operator delete(void* ptr) noexcept {
+  std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t /*size*/) noexcept {
+  std::free(ptr);
+}
+
+namespace dcflight::benchmark {
+
+namespace {
+
+constexpr size_t kDefaultIterations = 50;
+
+} // namespace
+
+size_t allocationCount() {
+  return gAllocationCount.load(std::memory_order_relaxed);
+}
+
+int run(int argc, char* argv[]) {
+  const size_t iterations = argc > 1
+      ? static_cast<size_t>(std::strtoul(argv[1], nullptr, 10))
+      : kDefaultIterations;
+  if (iterations == 0) {
+    std::fprintf(stderr, "usage: %s [iterations]\n", argv[0]);
+    return 1;
+  }
+
+  runMutationBenchmarks(iterations);
+  std::printf("\n");
+  runEventBenchmarks(iterations);
+  std::printf("\n");
+  runShadowBenchmarks(iterations);
+  std::printf("\n");
+  runResultBenchmarks(iterations);
+  return 0;
+}
+
+} // namespace dcflight::benchmark
+
+int main(int argc, char* argv[]) {
+  return dcflight::benchmark::run(argc, argv);
+}
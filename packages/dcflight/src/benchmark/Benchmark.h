@@ -0,0 +1,38 @@
+/*
+ * Copyright (c) Dotcorr Studio. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <vector>
+
+namespace dcflight::benchmark {
+
+using Clock = std::chrono::steady_clock;
+
+// Number of allocations made by the process so far
+size_t allocationCount();
+
+inline double elapsedNanos(Clock::time_point start, Clock::time_point end) {
+  return std::chrono::duration<double, std::nano>(end - start).count();
+}
+
+template <typename T>
+T median(std::vector<T> samples) {
+  std::nth_element(
+      samples.begin(), samples.begin() + samples.size() / 2, samples.end());
+  return samples[samples.size() / 2];
+}
+
+void runMutationBenchmarks(size_t iterations);
+void runEventBenchmarks(size_t iterations);
+void runShadowBenchmarks(size_t iterations);
+void runResultBenchmarks(size_t iterations);
+
+} // namespace dcflight::benchmark
@@ -0,0 +1,433 @@
+/*
+ * Copyright (c) Dotcorr Studio. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <atomic>
+#include <barrier>
+#include <condition_variable>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <Benchmark.h>
+#include <dcflight/events/EventRing.h>
+#include <dcflight/events/WakeSignal.h>
+
+namespace dcflight::benchmark {
+
+using namespace dcflight::events;
+
+namespace {
+
+// Events pushed by each producer between two polls of the consumer, about
+// what a 120 Hz scroll and a few gestures produce in a frame
+constexpr size_t kBurst = 500;
+constexpr size_t kRounds = 20;
+constexpr std::string_view kEventType = "onScroll";
+constexpr std::string_view kEventData =
+    R"({"contentOffset":{"x":0,"y":1234.5},"velocity":{"x":0,"y":-2.5}})";
+
+class RingQueue {
+ public:
+  void push(int32_t viewId) {
+    ring_.push(viewId, kEventType, kEventData);
+  }
+
+  size_t drain(size_t& checksum) {
+    const size_t count = ring_.beginRead();
+    for (size_t i = 0; i < count; i++) {
+      const auto& record =
+          ring_.getRecord(static_cast<uint32_t>(ring_.getReadIndex() + i));
+      checksum += ring_.getType(record).size() + ring_.getData(record).size();
+    }
+    ring_.endRead(count);
+    return count;
+  }
+
+  uint64_t getDroppedCount() const {
+    return ring_.getDroppedCount();
+  }
+
+ private:
+  EventRing ring_{4096, 1 << 20};
+};
+
+// The design the ring replaces: a locked queue of owned events, swapped out
+// by the consumer on every poll
+class LockedQueue {
+ public:
+  void push(int32_t viewId) {
+    std::string event{kEventType};
+    event += kEventData;
+    std::lock_guard<std::mutex> lock(mutex_);
+    queue_.push_back({viewId, std::move(event)});
+  }
+
+  size_t drain(size_t& checksum) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      drained_.swap(queue_);
+    }
+    for (const auto& event : drained_) {
+      checksum += event.second.size();
+    }
+    const size_t count = drained_.size();
+    drained_.clear();
+    return count;
+  }
+
+  uint64_t getDroppedCount() const {
+    return 0;
+  }
+
+ private:
+  std::mutex mutex_;
+  std::vector<std::pair<int32_t, std::string>> queue_;
+  std::vector<std::pair<int32_t, std::string>> drained_;
+};
+
+struct EventResult {
+  double pushNanos;
+  double drainNanos;
+  size_t allocations;
+  uint64_t dropped;
+};
+
+// Producers push a burst concurrently, then the consumer drains it, for
+// several rounds. Returns per event medians over the rounds.
+template <typename Queue>
+EventResult runQueue(size_t producers) {
+  Queue queue;
+  std::barrier start(static_cast<std::ptrdiff_t>(producers + 1));
+  std::barrier finish(static_cast<std::ptrdiff_t>(producers + 1));
+  // Each producer times its own burst, so that waking the threads up is not
+  // accounted to the queue
+  std::vector<double> burstNanos(producers);
+  std::vector<std::thread> threads;
+  for (size_t p = 0; p < producers; p++) {
+    threads.emplace_back([&queue, &start, &finish, &burstNanos, p] {
+      for (size_t round = 0; round < kRounds; round++) {
+        start.arrive_and_wait();
+        const auto begin = Clock::now();
+        for (size_t i = 0; i < kBurst; i++) {
+          queue.push(static_cast<int32_t>(p));
+        }
+        burstNanos[p] = elapsedNanos(begin, Clock::now());
+        finish.arrive_and_wait();
+      }
+    });
+  }
+
+  const auto events = static_cast<double>(producers * kBurst);
+  std::vector<double> pushNanos;
+  std::vector<double> drainNanos;
+  std::vector<size_t> allocations;
+  size_t checksum = 0;
+  size_t delivered = 0;
+  for (size_t round = 0; round < kRounds; round++) {
+    const size_t allocationsBefore = allocationCount();
+    start.arrive_and_wait();
+    finish.arrive_and_wait();
+    double total = 0;
+    for (double nanos : burstNanos) {
+      total += nanos;
+    }
+    pushNanos.push_back(total / events);
+
+    const auto begin = Clock::now();
+    delivered += queue.drain(checksum);
+    drainNanos.push_back(elapsedNanos(begin, Clock::now()) / events);
+    allocations.push_back(allocationCount() - allocationsBefore);
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  if (checksum != delivered * (kEventType.size() + kEventData.size())) {
+    std::fprintf(stderr, "event queue: corrupted payload\n");
+  }
+  return {
+      median(pushNanos),
+      median(drainNanos),
+      median(allocations),
+      queue.getDroppedCount()};
+}
+
+void reportEvents(
+    const char* name,
+    EventResult (*runner)(size_t),
+    size_t producers,
+    size_t iterations) {
+  std::vector<double> pushNanos;
+  std::vector<double> drainNanos;
+  EventResult result{};
+  for (size_t i = 0; i < iterations; i++) {
+    result = runner(producers);
+    pushNanos.push_back(result.pushNanos);
+    drainNanos.push_back(result.drainNanos);
+  }
+
+  char label[32];
+  std::snprintf(label, sizeof(label), "%s x%zu", name, producers);
+  std::printf(
+      "%-24s %10.1f %10.1f %10zu %10llu\n",
+      label,
+      median(pushNanos),
+      median(drainNanos),
+      result.allocations,
+      static_cast<unsigned long long>(result.dropped));
+}
+
+struct CoalescingResult {
+  size_t delivered;
+  double drainNanos;
+};
+
+// A fling: a burst of scroll events spread over `views` views, with a press
+// every 100 events, drained at once. Reports the events left for the
+// consumer to handle and the drain time per event pushed, coalescing
+// included.
+CoalescingResult runCoalescing(size_t views, bool coalesce, size_t rounds) {
+  constexpr std::string_view kPressType = "onPress";
+  EventRing ring{4096, 1 << 20};
+  if (coalesce) {
+    ring.setCoalescable(kEventType, true);
+  }
+
+  std::vector<double> drainNanos;
+  size_t delivered = 0;
+  for (size_t round = 0; round < rounds; round++) {
+    for (size_t i = 0; i < kBurst; i++) {
+      const auto viewId = static_cast<int32_t>(i % views);
+      if (i % 100 == 99) {
+        ring.push(viewId, kPressType, "{}");
+      } else {
+        ring.push(viewId, kEventType, kEventData);
+      }
+    }
+
+    const auto begin = Clock::now();
+    const size_t count = ring.beginRead();
+    size_t checksum = 0;
+    delivered = 0;
+    for (size_t i = 0; i < count; i++) {
+      const auto& record =
+          ring.getRecord(static_cast<uint32_t>(ring.getReadIndex() + i));
+      if ((record.flags & EventRecord::Superseded) != 0) {
+        continue;
+      }
+      checksum += ring.getData(record).size();
+      delivered++;
+    }
+    ring.endRead(count);
+    drainNanos.push_back(
+        elapsedNanos(begin, Clock::now()) / static_cast<double>(count));
+    if (checksum == 0) {
+      std::fprintf(stderr, "event coalescing: nothing delivered\n");
+    }
+  }
+  return {delivered, median(drainNanos)};
+}
+
+void reportCoalescing(size_t views, bool coalesce, size_t rounds) {
+  const CoalescingResult result = runCoalescing(views, coalesce, rounds);
+  char label[32];
+  std::snprintf(
+      label,
+      sizeof(label),
+      "%s x%zu view%s",
+      coalesce ? "coalesced" : "queued",
+      views,
+      views == 1 ? "" : "s");
+  std::printf(
+      "%-24s %10zu %10zu %10.1f\n",
+      label,
+      kBurst,
+      result.delivered,
+      result.drainNanos);
+}
+
+// Events delivered one at a time, at intervals out of phase with the poll
+// timer, then the time the consumer is left idle
+constexpr size_t kDeliveries = 24;
+constexpr auto kPollInterval = std::chrono::milliseconds(16);
+constexpr auto kIdleWindow = std::chrono::milliseconds(320);
+
+// Stands for the event loop of the Dart isolate, to which a wake-up posts a
+// message as a NativeCallable.listener does
+class EventLoop {
+ public:
+  void post() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    messages_++;
+    condition_.notify_one();
+  }
+
+  // Waits for a message until `deadline`. Returns false on timeout or stop.
+  bool waitUntil(Clock::time_point deadline) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    condition_.wait_until(
+        lock, deadline, [this] { return messages_ > 0 || stopped_; });
+    if (messages_ == 0) {
+      return false;
+    }
+    messages_--;
+    return true;
+  }
+
+  void stop() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopped_ = true;
+    condition_.notify_one();
+  }
+
+  bool isStopped() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stopped_;
+  }
+
+ private:
+  std::mutex mutex_;
+  std::condition_variable condition_;
+  size_t messages_ = 0;
+  bool stopped_ = false;
+};
+
+EventLoop* gDeliveryLoop = nullptr;
+
+void wakeDeliveryLoop() {
+  gDeliveryLoop->post();
+}
+
+struct DeliveryResult {
+  double latencyMicros;
+  double maxLatencyMicros;
+  double idleWakesPerSecond;
+};
+
+// A producer pushes events one by one while the consumer drains the ring
+// either on a 16 ms timer, as the Dart isolate polled it, or when woken by a
+// WakeSignal. Reports the time from push to drain and how often the consumer
+// woke up while no event was queued.
+DeliveryResult runDelivery(bool wakeOnPush) {
+  EventRing ring{4096, 1 << 20};
+  WakeSignal signal;
+  EventLoop loop;
+  gDeliveryLoop = &loop;
+  if (wakeOnPush) {
+    signal.setWakeFunction(wakeDeliveryLoop);
+  }
+
+  std::vector<Clock::time_point> pushed(kDeliveries);
+  std::vector<double> latencies;
+  std::atomic<bool> idle{false};
+  size_t idleWakes = 0;
+  std::thread consumer([&] {
+    auto nextPoll = Clock::now() + kPollInterval;
+    while (!loop.isStopped()) {
+      if (wakeOnPush) {
+        if (!loop.waitUntil(Clock::time_point::max())) {
+          continue;
+        }
+        signal.rearm();
+      } else {
+        loop.waitUntil(nextPoll);
+        nextPoll += kPollInterval;
+      }
+      if (idle.load(std::memory_order_relaxed)) {
+        idleWakes++;
+      }
+      const size_t count = ring.beginRead();
+      const auto now = Clock::now();
+      for (size_t i = 0; i < count; i++) {
+        const auto& record =
+            ring.getRecord(static_cast<uint32_t>(ring.getReadIndex() + i));
+        latencies.push_back(
+            elapsedNanos(pushed[static_cast<size_t>(record.viewId)], now) /
+            1000.0);
+      }
+      ring.endRead(count);
+    }
+  });
+
+  for (size_t i = 0; i < kDeliveries; i++) {
+    std::this_thread::sleep_for(std::chrono::microseconds(3000 + i * 1700));
+    pushed[i] = Clock::now();
+    ring.push(static_cast<int32_t>(i), kEventType, kEventData);
+    signal.notify();
+  }
+  // Let the last event be drained before counting idle wake-ups
+  std::this_thread::sleep_for(kPollInterval * 2);
+  idle.store(true, std::memory_order_relaxed);
+  std::this_thread::sleep_for(kIdleWindow);
+  idle.store(false, std::memory_order_relaxed);
+  loop.stop();
+  consumer.join();
+  gDeliveryLoop = nullptr;
+
+  const double idleSeconds =
+      std::chrono::duration<double>(kIdleWindow).count();
+  return {
+      median(latencies),
+      *std::max_element(latencies.begin(), latencies.end()),
+      static_cast<double>(idleWakes) / idleSeconds};
+}
+
+void reportDelivery(const char* name, bool wakeOnPush) {
+  const DeliveryResult result = runDelivery(wakeOnPush);
+  std::printf(
+      "%-24s %10.1f %10.1f %12.1f\n",
+      name,
+      result.latencyMicros,
+      result.maxLatencyMicros,
+      result.idleWakesPerSecond);
+}
+
+} // namespace
+
+void runEventBenchmarks(size_t iterations) {
+  // Each run already covers several rounds of bursts
+  const size_t runs = std::max<size_t>(1, iterations / 10);
+
+  std::printf(
+      "%-24s %10s %10s %10s %10s\n",
+      "event queue",
+      "push ns",
+      "drain ns",
+      "allocs",
+      "dropped");
+  for (size_t producers : {1, 4}) {
+    reportEvents("event ring", runQueue<RingQueue>, producers, runs);
+    reportEvents("locked queue", runQueue<LockedQueue>, producers, runs);
+  }
+
+  std::printf(
+      "\n%-24s %10s %10s %10s\n",
+      "event coalescing",
+      "events",
+      "delivered",
+      "drain ns");
+  for (size_t views : {1, 8}) {
+    reportCoalescing(views, false, runs * kRounds);
+    reportCoalescing(views, true, runs * kRounds);
+  }
+
+  // Each delivery run takes about a second of wall time, whatever the
+  // iteration count
+  std::printf(
+      "\n%-24s %10s %10s %12s\n",
+      "event delivery",
+      "latency us",
+      "max us",
+      "idle wakes/s");
+  reportDelivery("16 ms poll", false);
+  reportDelivery("wake signal", true);
+}
+
+} // namespace dcflight::benchmark
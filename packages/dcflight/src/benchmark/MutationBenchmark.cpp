@@ -0,0 +1,482 @@
+/*
+ * Copyright (c) Dotcorr Studio. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <array>
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <Benchmark.h>
+#include <dcflight/mutation/CommandBuffer.h>
+#include <dcflight/mutation/MutationDecoder.h>
+#include <dcflight/mutation/MutationEncoder.h>
+
+namespace dcflight::benchmark {
+
+using namespace dcflight::mutation;
+
+namespace {
+
+constexpr std::array<std::string_view, 4> kViewTypes = {
+    "View", "Text", "Image", "Button"};
+
+struct MutationScenario {
+  const char* name;
+  void (*encode)(MutationEncoder& encoder);
+};
+
+void writeStyle(MutationEncoder& encoder, int32_t viewId) {
+  encoder.key("width");
+  encoder.writeDouble(100 + viewId % 7);
+  encoder.key("height");
+  encoder.writeInt(44);
+  encoder.key("flexDirection");
+  encoder.writeString("row");
+  encoder.key("backgroundColor");
+  encoder.writeString("#ff336699");
+  encoder.key("opacity");
+  encoder.writeDouble(0.5);
+  encoder.key("hidden");
+  encoder.writeBool(false);
+  encoder.key("padding");
+  encoder.beginMap();
+  encoder.key("top");
+  encoder.writeInt(8);
+  encoder.key("bottom");
+  encoder.writeInt(8);
+  encoder.endMap();
+  encoder.key("shadowOffset");
+  encoder.beginList();
+  encoder.writeDouble(0);
+  encoder.writeDouble(2);
+  encoder.endList();
+}
+
+// A screen of 500 views created and attached in a single batch
+void encodeMount(MutationEncoder& encoder) {
+  constexpr std::string_view eventTypes[] = {"onPress", "onLongPress"};
+  for (int32_t viewId = 1; viewId <= 500; viewId++) {
+    const auto viewType = kViewTypes[static_cast<size_t>(viewId) % 4];
+    encoder.beginCreateView(viewId, viewType);
+    writeStyle(encoder, viewId);
+    encoder.key("content");
+    encoder.writeString(std::string{"Row "} + std::to_string(viewId));
+    encoder.endView();
+    encoder.attachView(viewId, (viewId - 1) / 10, (viewId - 1) % 10);
+    if (viewType == "Button") {
+      encoder.addEventListeners(viewId, eventTypes, 2);
+    }
+  }
+}
+
+// Small prop patches, e.g. an animation or a ticking counter
+void encodePatch(MutationEncoder& encoder) {
+  for (int32_t viewId = 1; viewId <= 200; viewId++) {
+    encoder.beginUpdateView(viewId);
+    encoder.key("opacity");
+    encoder.writeDouble(viewId / 200.0);
+    encoder.key("content");
+    encoder.writeString(std::to_string(viewId * 31));
+    encoder.endView();
+  }
+}
+
+// A long list reordered in place
+void encodeReorder(MutationEncoder& encoder) {
+  std::vector<int32_t> childIds(1000);
+  for (size_t i = 0; i < childIds.size(); i++) {
+    childIds[i] = static_cast<int32_t>(childIds.size() - i);
+  }
+  encoder.setChildren(0, childIds.data(), childIds.size());
+}
+
+/**
+ * Visits every prop of every op, the way a platform handler converting props
+ * to native values would.
+ */
+class CountingHandler : public MutationHandler {
+ public:
+  size_t values = 0;
+
+  void createView(int32_t, Symbol viewType, MapReader props) override {
+    values += viewType.id;
+    visitMap(props);
+  }
+  void updateView(int32_t, MapReader props) override {
+    visitMap(props);
+  }
+  void deleteView(int32_t) override {
+    values++;
+  }
+  void attachView(int32_t, int32_t, int32_t) override {
+    values++;
+  }
+  void detachView(int32_t) override {
+    values++;
+  }
+  void setChildren(int32_t, PackedArray<int32_t> childIds) override {
+    for (uint32_t i = 0; i < childIds.size(); i++) {
+      values += static_cast<size_t>(childIds[i]);
+    }
+  }
+  void addEventListeners(int32_t, StringList eventTypes) override {
+    values += eventTypes.size();
+  }
+  void removeEventListeners(int32_t, StringList eventTypes) override {
+    values += eventTypes.size();
+  }
+
+ private:
+  void visitValue(const Value& value) {
+    switch (value.type()) {
+      case ValueType::List: {
+        auto list = value.asList();
+        Value item;
+        while (list.next(item)) {
+          visitValue(item);
+        }
+        break;
+      }
+      case ValueType::Map:
+        visitMap(value.asMap());
+        break;
+      case ValueType::String:
+        values += value.asString().size();
+        break;
+      default:
+        values += static_cast<size_t>(value.asInt());
+        break;
+    }
+  }
+
+  void visitMap(MapReader map) {
+    Symbol key;
+    Value value;
+    while (map.next(key, value)) {
+      values += key.id;
+      visitValue(value);
+    }
+  }
+};
+
+void reportMutation(const MutationScenario& scenario, size_t iterations) {
+  MutationEncoder encoder;
+  MutationDecoder decoder;
+  CountingHandler handler;
+
+  // The first buffer of a session also defines the interned strings, which
+  // steady state frames only reference
+  scenario.encode(encoder);
+  const auto& first = encoder.finish();
+  const size_t firstBytes = first.size();
+  decoder.decode(first.data(), first.size(), handler);
+
+  std::vector<double> encodeNanos;
+  std::vector<double> decodeNanos;
+  std::vector<size_t> decodeAllocations;
+  size_t opCount = 0;
+  size_t bytes = 0;
+  for (size_t i = 0; i < iterations; i++) {
+    auto start = Clock::now();
+    scenario.encode(encoder);
+    opCount = encoder.getOpCount();
+    const auto& buffer = encoder.finish();
+    encodeNanos.push_back(elapsedNanos(start, Clock::now()));
+    bytes = buffer.size();
+
+    const size_t allocationsBefore = allocationCount();
+    start = Clock::now();
+    const auto status = decoder.decode(buffer.data(), buffer.size(), handler);
+    decodeNanos.push_back(elapsedNanos(start, Clock::now()));
+    decodeAllocations.push_back(allocationCount() - allocationsBefore);
+    if (status != DecodeStatus::Ok) {
+      std::fprintf(
+          stderr, "%s: decode failed: %s\n", scenario.name, toString(status));
+      return;
+    }
+  }
+
+  std::printf(
+      "%-24s %7zu %10zu %10zu %10.1f %10.1f %8zu\n",
+      scenario.name,
+      opCount,
+      firstBytes,
+      bytes,
+      median(encodeNanos) / 1000.0,
+      median(decodeNanos) / 1000.0,
+      median(decodeAllocations));
+}
+
+// Stands for the main queue of the platform: a thread running posted tasks
+// in order, which a caller may wait for as dispatch_sync does
+class UiThread {
+ public:
+  UiThread() : thread_([this] { run(); }) {}
+
+  ~UiThread() {
+    post(nullptr);
+    thread_.join();
+  }
+
+  void post(std::function<void()> task) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    tasks_.push_back(std::move(task));
+    condition_.notify_one();
+  }
+
+  void runSync(const std::function<void()>& task) {
+    std::mutex doneMutex;
+    std::condition_variable doneCondition;
+    bool done = false;
+    post([&] {
+      task();
+      std::lock_guard<std::mutex> lock(doneMutex);
+      done = true;
+      doneCondition.notify_one();
+    });
+    std::unique_lock<std::mutex> lock(doneMutex);
+    doneCondition.wait(lock, [&] { return done; });
+  }
+
+  size_t getTaskCount() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return taskCount_;
+  }
+
+ private:
+  void run() {
+    while (true) {
+      std::function<void()> task;
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        condition_.wait(lock, [this] { return !tasks_.empty(); });
+        task = std::move(tasks_.front());
+        tasks_.pop_front();
+        if (!task) {
+          return;
+        }
+        taskCount_++;
+      }
+      task();
+    }
+  }
+
+  std::mutex mutex_;
+  std::condition_variable condition_;
+  std::deque<std::function<void()>> tasks_;
+  size_t taskCount_ = 0;
+  std::thread thread_;
+};
+
+// The views of the platform, touched by one op at a time the same way
+// whether it was queued or not
+struct ViewOpSink {
+  size_t values = 0;
+
+  void run(const CommandBatch& batch, const Command& command) {
+    values += static_cast<size_t>(command.viewId);
+    switch (command.type) {
+      case CommandType::CreateView:
+        values += batch.getViewType(command).size();
+        [[fallthrough]];
+      case CommandType::UpdateView:
+      case CommandType::AddEventListeners:
+      case CommandType::RemoveEventListeners:
+        values += batch.getText(command).size();
+        break;
+      case CommandType::AttachView:
+        values += static_cast<size_t>(command.parentId + command.index);
+        break;
+      case CommandType::SetChildren:
+        values += command.childCount;
+        break;
+      case CommandType::DeleteView:
+      case CommandType::DetachView:
+        break;
+    }
+  }
+};
+
+// The non-batched ops of a screen of 500 views, as the FFI receives them
+template <typename Queue>
+void queueMount(Queue& queue) {
+  constexpr std::string_view kProps =
+      R"({"width":100,"height":44,"flexDirection":"row","opacity":0.5})";
+  for (int32_t viewId = 1; viewId <= 500; viewId++) {
+    queue.createView(
+        viewId, kViewTypes[static_cast<size_t>(viewId) % 4], kProps);
+    queue.attachView(viewId, (viewId - 1) / 10, (viewId - 1) % 10);
+    if (viewId % 4 == 3) {
+      queue.addEventListeners(viewId, R"(["onPress","onLongPress"])");
+    }
+  }
+}
+
+// Every op waits for the UI thread to run it, as each FFI call did
+class SyncViewOps {
+ public:
+  SyncViewOps(UiThread& ui, ViewOpSink& sink) : ui_(ui), sink_(sink) {}
+
+  void createView(
+      int32_t viewId,
+      std::string_view viewType,
+      std::string_view propsJson) {
+    runSync([&](CommandBuffer& buffer) {
+      buffer.createView(viewId, viewType, propsJson);
+    });
+  }
+  void attachView(int32_t childId, int32_t parentId, int32_t index) {
+    runSync([&](CommandBuffer& buffer) {
+      buffer.attachView(childId, parentId, index);
+    });
+  }
+  void addEventListeners(int32_t viewId, std::string_view eventTypes) {
+    runSync([&](CommandBuffer& buffer) {
+      buffer.addEventListeners(viewId, eventTypes);
+    });
+  }
+
+  size_t getOpCount() const {
+    return opCount_;
+  }
+
+ private:
+  // Runs the one op on the UI thread, through a batch so that it is handled
+  // as a queued op is
+  template <typename Queue>
+  void runSync(Queue&& queueOp) {
+    opCount_++;
+    ui_.runSync([&] {
+      queueOp(buffer_);
+      buffer_.take(batch_);
+      for (const Command& command : batch_.getCommands()) {
+        sink_.run(batch_, command);
+      }
+    });
+  }
+
+  UiThread& ui_;
+  ViewOpSink& sink_;
+  CommandBuffer buffer_;
+  CommandBatch batch_;
+  size_t opCount_ = 0;
+};
+
+CommandBuffer* gViewOps = nullptr;
+CommandBatch* gViewOpBatch = nullptr;
+ViewOpSink* gViewOpSink = nullptr;
+UiThread* gUiThread = nullptr;
+
+// Takes and runs the queued ops on the UI thread
+void runQueuedViewOps() {
+  gViewOps->take(*gViewOpBatch);
+  for (const Command& command : gViewOpBatch->getCommands()) {
+    gViewOpSink->run(*gViewOpBatch, command);
+  }
+}
+
+void scheduleViewOps() {
+  gUiThread->post(runQueuedViewOps);
+}
+
+struct HopResult {
+  size_t ops;
+  size_t callerWaits;
+  size_t uiTasks;
+  double callerMicros;
+};
+
+HopResult runHops(bool queued) {
+  UiThread ui;
+  ViewOpSink sink;
+  size_t ops = 0;
+  size_t callerWaits = 0;
+  const auto start = Clock::now();
+  if (queued) {
+    CommandBuffer buffer;
+    CommandBatch batch;
+    gViewOps = &buffer;
+    gViewOpBatch = &batch;
+    gViewOpSink = &sink;
+    gUiThread = &ui;
+    buffer.setScheduleFunction(scheduleViewOps);
+    queueMount(buffer);
+    ops = buffer.getPendingCount();
+    // The explicit flush at the end of the frame
+    ui.runSync(runQueuedViewOps);
+    callerWaits = 1;
+  } else {
+    SyncViewOps syncOps{ui, sink};
+    queueMount(syncOps);
+    ops = syncOps.getOpCount();
+    callerWaits = ops;
+  }
+  const double callerMicros = elapsedNanos(start, Clock::now()) / 1000.0;
+  if (sink.values == 0) {
+    std::fprintf(stderr, "view op hops: no op ran\n");
+  }
+  return {ops, callerWaits, ui.getTaskCount(), callerMicros};
+}
+
+void reportHops(const char* name, bool queued, size_t iterations) {
+  std::vector<double> callerMicros;
+  HopResult result{};
+  for (size_t i = 0; i < iterations; i++) {
+    result = runHops(queued);
+    callerMicros.push_back(result.callerMicros);
+  }
+  std::printf(
+      "%-24s %7zu %10zu %10zu %10.1f\n",
+      name,
+      result.ops,
+      result.callerWaits,
+      result.uiTasks,
+      median(callerMicros));
+}
+
+} // namespace
+
+void runMutationBenchmarks(size_t iterations) {
+  const MutationScenario scenarios[] = {
+      {"mount 500 views", encodeMount},
+      {"patch 200 views", encodePatch},
+      {"reorder 1000 children", encodeReorder},
+  };
+
+  std::printf(
+      "%-24s %7s %10s %10s %10s %10s %8s\n",
+      "mutation batch",
+      "ops",
+      "first B",
+      "steady B",
+      "encode us",
+      "decode us",
+      "allocs");
+  for (const auto& scenario : scenarios) {
+    reportMutation(scenario, iterations);
+  }
+
+  // Each run starts a thread standing for the UI thread
+  const size_t runs = std::max<size_t>(1, iterations / 10);
+  std::printf(
+      "\n%-24s %7s %10s %10s %10s\n",
+      "view op hops",
+      "ops",
+      "waits",
+      "ui tasks",
+      "caller us");
+  reportHops("sync per op", false, runs);
+  reportHops("command buffer", true, runs);
+}
+
+} // namespace dcflight::benchmark
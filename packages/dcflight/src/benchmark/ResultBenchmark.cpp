@@ -0,0 +1,288 @@
+/*
+ * Copyright (c) Dotcorr Studio. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <charconv>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <Benchmark.h>
+#include <dcflight/result/ResultArena.h>
+#include <dcflight/result/ResultWriter.h>
+
+namespace dcflight::benchmark {
+
+using namespace dcflight::result;
+
+namespace {
+
+// The size of the buffer Dart passed to dcflight_tunnel for the JSON result
+constexpr size_t kTunnelBufferSize = 4096;
+
+// Writes a result as JSON with the calls of a ResultWriter, standing for the
+// JSON native code wrote into the buffer Dart passed
+class JsonWriter {
+ public:
+  void key(std::string_view key) {
+    separate();
+    writeString(key);
+    json_ += ':';
+    afterKey_ = true;
+  }
+  void writeBool(bool value) {
+    separate();
+    json_ += value ? "true" : "false";
+  }
+  void writeInt(int64_t value) {
+    separate();
+    char buffer[24];
+    json_.append(buffer, std::to_chars(buffer, buffer + 24, value).ptr);
+  }
+  void writeDouble(double value) {
+    separate();
+    char buffer[32];
+    json_.append(buffer, std::to_chars(buffer, buffer + 32, value).ptr);
+  }
+  void writeString(std::string_view value) {
+    separate();
+    json_ += '"';
+    json_ += value;
+    json_ += '"';
+  }
+  void beginList() {
+    separate();
+    json_ += '[';
+    first_ = true;
+  }
+  void endList() {
+    json_ += ']';
+    first_ = false;
+  }
+  void beginMap() {
+    separate();
+    json_ += '{';
+    first_ = true;
+  }
+  void endMap() {
+    json_ += '}';
+    first_ = false;
+  }
+
+  // The JSON written since the last call, as copied into the fixed buffer
+  const std::string& finish() {
+    result_.swap(json_);
+    json_.clear();
+    first_ = true;
+    return result_;
+  }
+
+ private:
+  void separate() {
+    if (afterKey_) {
+      afterKey_ = false;
+    } else if (!first_) {
+      json_ += ',';
+    }
+    first_ = false;
+  }
+
+  std::string json_;
+  std::string result_;
+  bool first_ = true;
+  bool afterKey_ = false;
+};
+
+template <typename Writer>
+void writeScreenDimensions(Writer& writer) {
+  constexpr std::string_view keys[] = {
+      "width",
+      "height",
+      "scale",
+      "fontScale",
+      "statusBarHeight",
+      "safeAreaTop",
+      "safeAreaBottom",
+      "safeAreaLeft",
+      "safeAreaRight"};
+  constexpr double values[] = {393, 852, 3, 1, 54, 59, 34, 0, 0};
+  writer.beginMap();
+  for (size_t i = 0; i < 9; i++) {
+    writer.key(keys[i]);
+    writer.writeDouble(values[i]);
+  }
+  writer.endMap();
+}
+
+// The frame of a view, as a measure tunnel returns it
+template <typename Writer>
+void writeMeasure(Writer& writer) {
+  writer.beginMap();
+  writer.key("x");
+  writer.writeDouble(16);
+  writer.key("y");
+  writer.writeDouble(248.33333333333334);
+  writer.key("width");
+  writer.writeDouble(361);
+  writer.key("height");
+  writer.writeDouble(44.5);
+  writer.key("visible");
+  writer.writeBool(true);
+  writer.endMap();
+}
+
+// The rows of a list in its viewport, with their offsets and keys
+template <typename Writer>
+void writeVisibleItems(Writer& writer) {
+  writer.beginList();
+  for (int64_t i = 0; i < 200; i++) {
+    writer.beginMap();
+    writer.key("index");
+    writer.writeInt(i);
+    writer.key("offset");
+    writer.writeDouble(static_cast<double>(i) * 44.5);
+    writer.key("key");
+    writer.writeString("row-" + std::to_string(i));
+    writer.endMap();
+  }
+  writer.endList();
+}
+
+// Walks a binary result, returning the number of values or 0 if it is
+// malformed
+size_t countValues(const uint8_t*& data, const uint8_t* end) {
+  if (data >= end) {
+    return 0;
+  }
+  const auto type = static_cast<ValueType>(*data++);
+  auto read = [&](auto& value) {
+    std::memcpy(&value, data, sizeof(value));
+    data += sizeof(value);
+  };
+  switch (type) {
+    case ValueType::Null:
+    case ValueType::False:
+    case ValueType::True:
+      return 1;
+    case ValueType::Int:
+    case ValueType::Double:
+      data += 8;
+      return data <= end ? 1 : 0;
+    case ValueType::String: {
+      uint32_t length;
+      read(length);
+      data += length;
+      return data <= end ? 1 : 0;
+    }
+    case ValueType::List:
+    case ValueType::Map: {
+      uint32_t byteLength;
+      uint32_t count;
+      read(byteLength);
+      read(count);
+      size_t values = 1;
+      for (uint32_t i = 0; i < count; i++) {
+        if (type == ValueType::Map) {
+          uint32_t keyLength;
+          read(keyLength);
+          data += keyLength;
+        }
+        const size_t itemValues = countValues(data, end);
+        if (itemValues == 0) {
+          return 0;
+        }
+        values += itemValues;
+      }
+      return values;
+    }
+  }
+  return 0;
+}
+
+struct ResultScenario {
+  const char* name;
+  void (*writeJson)(JsonWriter& writer);
+  void (*writeResult)(ResultWriter& writer);
+};
+
+void reportResult(const ResultScenario& scenario, size_t iterations) {
+  JsonWriter jsonWriter;
+  ResultWriter resultWriter;
+  ResultArena arena;
+  // Dart releases the results of a frame at once
+  constexpr size_t kResultsPerRelease = 8;
+
+  std::vector<double> jsonNanos;
+  std::vector<double> resultNanos;
+  std::vector<size_t> allocations;
+  size_t jsonBytes = 0;
+  size_t resultBytes = 0;
+  for (size_t i = 0; i < iterations; i++) {
+    auto start = Clock::now();
+    scenario.writeJson(jsonWriter);
+    jsonBytes = jsonWriter.finish().size();
+    jsonNanos.push_back(elapsedNanos(start, Clock::now()));
+
+    const size_t allocationsBefore = allocationCount();
+    start = Clock::now();
+    scenario.writeResult(resultWriter);
+    const ResultSlice slice = resultWriter.finish(arena);
+    resultNanos.push_back(elapsedNanos(start, Clock::now()));
+    allocations.push_back(allocationCount() - allocationsBefore);
+    resultBytes = slice.length;
+
+    const uint8_t* data = slice.data;
+    if (countValues(data, slice.data + slice.length) == 0 ||
+        data != slice.data + slice.length) {
+      std::fprintf(stderr, "%s: malformed result\n", scenario.name);
+      return;
+    }
+    if (i % kResultsPerRelease == kResultsPerRelease - 1) {
+      arena.releaseAll();
+    }
+  }
+
+  std::printf(
+      "%-24s %8zu %8s %8zu %10.1f %10.1f %8zu\n",
+      scenario.name,
+      jsonBytes,
+      jsonBytes < kTunnelBufferSize ? "yes" : "no",
+      resultBytes,
+      median(jsonNanos),
+      median(resultNanos),
+      median(allocations));
+}
+
+} // namespace
+
+void runResultBenchmarks(size_t iterations) {
+  const ResultScenario scenarios[] = {
+      {"screen dimensions",
+       writeScreenDimensions<JsonWriter>,
+       writeScreenDimensions<ResultWriter>},
+      {"measure", writeMeasure<JsonWriter>, writeMeasure<ResultWriter>},
+      {"visible items x200",
+       writeVisibleItems<JsonWriter>,
+       writeVisibleItems<ResultWriter>},
+  };
+
+  std::printf(
+      "%-24s %8s %8s %8s %10s %10s %8s\n",
+      "result buffers",
+      "json B",
+      "fits 4K",
+      "binary B",
+      "json ns",
+      "binary ns",
+      "allocs");
+  for (const auto& scenario : scenarios) {
+    reportResult(scenario, iterations);
+  }
+}
+
+} // namespace dcflight::benchmark
@@ -0,0 +1,514 @@
+/*
+ * Copyright (c) Dotcorr Studio. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <iterator>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include <Benchmark.h>
+#include <dcflight/shadow/ChildrenDiff.h>
+#include <dcflight/shadow/ShadowTree.h>
+
+namespace dcflight::benchmark {
+
+using namespace dcflight::shadow;
+
+namespace {
+
+struct ShadowScenario {
+  const char* name;
+  int32_t rows;
+  int32_t cellsPerRow;
+};
+
+YGSize measureText(
+    void* /*context*/,
+    int32_t viewId,
+    float width,
+    YGMeasureMode widthMode,
+    float /*height*/,
+    YGMeasureMode /*heightMode*/) {
+  const float textWidth = static_cast<float>(40 + viewId % 80);
+  return {
+      widthMode == YGMeasureModeUndefined ? textWidth
+                                          : std::min(textWidth, width),
+      20.0f};
+}
+
+// A scrolling list of rows, each a row of text cells: the view ids of a
+// screen are allocated in this order by the reconciler
+void mount(ShadowTree& tree, const ShadowScenario& scenario) {
+  const LayoutValue rowProps[] = {
+      {LayoutProp::FlexDirection, LayoutUnit::Point, YGFlexDirectionRow},
+      {LayoutProp::Padding, LayoutUnit::Point, 8},
+      {LayoutProp::Height, LayoutUnit::Point, 44},
+      {LayoutProp::AlignItems, LayoutUnit::Point, YGAlignCenter},
+  };
+  const LayoutValue cellProps[] = {
+      {LayoutProp::FlexGrow, LayoutUnit::Point, 1},
+      {LayoutProp::MarginHorizontal, LayoutUnit::Point, 4},
+  };
+
+  int32_t viewId = 1;
+  const int32_t list = viewId++;
+  tree.createNode(list);
+  tree.insertChild(ShadowTree::RootViewId, list, 0);
+
+  std::vector<int32_t> rows;
+  std::vector<int32_t> cells;
+  for (int32_t row = 0; row < scenario.rows; row++) {
+    const int32_t rowId = viewId++;
+    tree.createNode(rowId);
+    tree.setProps(rowId, rowProps, std::size(rowProps));
+
+    cells.clear();
+    for (int32_t cell = 0; cell < scenario.cellsPerRow; cell++) {
+      const int32_t cellId = viewId++;
+      tree.createNode(cellId);
+      tree.setProps(cellId, cellProps, std::size(cellProps));
+      tree.setMeasureFunction(cellId, measureText, nullptr);
+      cells.push_back(cellId);
+    }
+    tree.setChildren(rowId, cells.data(), cells.size());
+    rows.push_back(rowId);
+  }
+  tree.setChildren(list, rows.data(), rows.size());
+}
+
+void reportShadow(const ShadowScenario& scenario, size_t iterations) {
+  std::vector<double> mountNanos;
+  std::vector<double> firstNanos;
+  std::vector<double> relayoutNanos;
+  size_t nodeCount = 0;
+  size_t firstUpdates = 0;
+  size_t relayoutUpdates = 0;
+
+  for (size_t i = 0; i < iterations; i++) {
+    ShadowTree tree;
+    auto start = Clock::now();
+    mount(tree, scenario);
+    mountNanos.push_back(elapsedNanos(start, Clock::now()));
+    nodeCount = tree.getNodeCount();
+
+    start = Clock::now();
+    firstUpdates = tree.calculateLayout(390, 844).size();
+    firstNanos.push_back(elapsedNanos(start, Clock::now()));
+
+    // A keystroke: the first cell of a row in the middle grows
+    const int32_t cellId = 3 + (scenario.rows / 2) * (scenario.cellsPerRow + 1);
+    const LayoutValue grow{LayoutProp::MinWidth, LayoutUnit::Point, 150};
+    start = Clock::now();
+    tree.setProps(cellId, &grow, 1);
+    relayoutUpdates = tree.calculateLayout(390, 844).size();
+    relayoutNanos.push_back(elapsedNanos(start, Clock::now()));
+  }
+
+  std::printf(
+      "%-24s %7zu %10.1f %10.1f %8zu %10.1f %8zu\n",
+      scenario.name,
+      nodeCount,
+      median(mountNanos) / 1000.0,
+      median(firstNanos) / 1000.0,
+      firstUpdates,
+      median(relayoutNanos) / 1000.0,
+      relayoutUpdates);
+}
+
+// The same list with the cells of each row split into two groups. The list,
+// rows and groups only set layout props, so they are marked layout-only when
+// `flatten` is set. Returns the rows.
+std::vector<int32_t> mountGrouped(
+    ShadowTree& tree,
+    const ShadowScenario& scenario,
+    bool flatten) {
+  const LayoutValue rowProps[] = {
+      {LayoutProp::FlexDirection, LayoutUnit::Point, YGFlexDirectionRow},
+      {LayoutProp::Padding, LayoutUnit::Point, 8},
+      {LayoutProp::Height, LayoutUnit::Point, 44},
+      {LayoutProp::AlignItems, LayoutUnit::Point, YGAlignCenter},
+  };
+  const LayoutValue groupProps[] = {
+      {LayoutProp::FlexGrow, LayoutUnit::Point, 1},
+      {LayoutProp::FlexDirection, LayoutUnit::Point, YGFlexDirectionRow},
+      {LayoutProp::PaddingHorizontal, LayoutUnit::Point, 4},
+  };
+  const LayoutValue cellProps[] = {
+      {LayoutProp::FlexGrow, LayoutUnit::Point, 1},
+      {LayoutProp::MarginHorizontal, LayoutUnit::Point, 4},
+  };
+
+  int32_t viewId = 1;
+  const int32_t list = viewId++;
+  tree.createNode(list);
+  tree.setLayoutOnly(list, flatten);
+  tree.insertChild(ShadowTree::RootViewId, list, 0);
+
+  std::vector<int32_t> rows;
+  std::vector<int32_t> groups;
+  std::vector<int32_t> cells;
+  for (int32_t row = 0; row < scenario.rows; row++) {
+    const int32_t rowId = viewId++;
+    tree.createNode(rowId);
+    tree.setProps(rowId, rowProps, std::size(rowProps));
+    tree.setLayoutOnly(rowId, flatten);
+
+    groups.clear();
+    for (int32_t group = 0; group < 2; group++) {
+      const int32_t groupId = viewId++;
+      tree.createNode(groupId);
+      tree.setProps(groupId, groupProps, std::size(groupProps));
+      tree.setLayoutOnly(groupId, flatten);
+
+      cells.clear();
+      for (int32_t cell = 0; cell < scenario.cellsPerRow / 2; cell++) {
+        const int32_t cellId = viewId++;
+        tree.createNode(cellId);
+        tree.setProps(cellId, cellProps, std::size(cellProps));
+        tree.setMeasureFunction(cellId, measureText, nullptr);
+        cells.push_back(cellId);
+      }
+      tree.setChildren(groupId, cells.data(), cells.size());
+      groups.push_back(groupId);
+    }
+    tree.setChildren(rowId, groups.data(), groups.size());
+    rows.push_back(rowId);
+  }
+  tree.setChildren(list, rows.data(), rows.size());
+  return rows;
+}
+
+// The position of a view in the root from the frames returned so far, as
+// a platform applying them to native views would place it
+std::pair<float, float> getMountedPosition(
+    const ShadowTree& tree,
+    const std::vector<LayoutUpdate>& frames,
+    int32_t viewId) {
+  float left = 0.0f;
+  float top = 0.0f;
+  for (; viewId > 0; viewId = tree.getMountedParent(viewId)) {
+    left += frames[static_cast<size_t>(viewId)].left;
+    top += frames[static_cast<size_t>(viewId)].top;
+  }
+  return {left, top};
+}
+
+void applyFrames(
+    const std::vector<LayoutUpdate>& updates,
+    std::vector<LayoutUpdate>& frames) {
+  for (const auto& update : updates) {
+    frames[static_cast<size_t>(update.viewId)] = update;
+  }
+}
+
+// Compares laying out and moving the grouped list with every view mounted
+// against flattening the layout-only ones, and checks that the mounted
+// views end up in the same place
+void reportFlattening(const ShadowScenario& scenario, size_t iterations) {
+  std::vector<double> layoutNanos[2];
+  std::vector<double> patchNanos[2];
+  size_t mountedViews[2] = {};
+  size_t layoutUpdates[2] = {};
+  size_t patchUpdates[2] = {};
+  bool matches = true;
+
+  for (size_t i = 0; i < iterations; i++) {
+    ShadowTree trees[2];
+    std::vector<LayoutUpdate> frames[2];
+    std::vector<int32_t> rows;
+    for (int flatten = 0; flatten < 2; flatten++) {
+      ShadowTree& tree = trees[flatten];
+      rows = mountGrouped(tree, scenario, flatten != 0);
+      frames[flatten].resize(tree.getNodeCount());
+
+      auto start = Clock::now();
+      const auto& updates = tree.calculateLayout(390, 844);
+      layoutNanos[flatten].push_back(elapsedNanos(start, Clock::now()));
+      layoutUpdates[flatten] = updates.size();
+      applyFrames(updates, frames[flatten]);
+
+      // The first row grows, moving every row below it
+      const LayoutValue grow{LayoutProp::Height, LayoutUnit::Point, 60};
+      start = Clock::now();
+      tree.setProps(rows.front(), &grow, 1);
+      const auto& patch = tree.calculateLayout(390, 844);
+      patchNanos[flatten].push_back(elapsedNanos(start, Clock::now()));
+      patchUpdates[flatten] = patch.size();
+      applyFrames(patch, frames[flatten]);
+
+      mountedViews[flatten] = 0;
+      for (int32_t viewId = 0;
+           viewId < static_cast<int32_t>(tree.getNodeCount());
+           viewId++) {
+        mountedViews[flatten] += tree.isFlattened(viewId) ? 0 : 1;
+      }
+    }
+
+    for (int32_t viewId = 1;
+         viewId < static_cast<int32_t>(trees[1].getNodeCount());
+         viewId++) {
+      if (!trees[1].isFlattened(viewId)) {
+        matches = matches &&
+            getMountedPosition(trees[0], frames[0], viewId) ==
+                getMountedPosition(trees[1], frames[1], viewId);
+      }
+    }
+  }
+
+  std::printf(
+      "%-24s %7zu %10.1f %8zu %10.1f %8zu %7zu %10.1f %8zu %10.1f %8zu %8s\n",
+      scenario.name,
+      mountedViews[0],
+      median(layoutNanos[0]) / 1000.0,
+      layoutUpdates[0],
+      median(patchNanos[0]) / 1000.0,
+      patchUpdates[0],
+      mountedViews[1],
+      median(layoutNanos[1]) / 1000.0,
+      layoutUpdates[1],
+      median(patchNanos[1]) / 1000.0,
+      patchUpdates[1],
+      matches ? "yes" : "NO");
+}
+
+// Hit tests by testing every child of each view containing the point, as a
+// walk of the native view hierarchy does, in the order of queryPoint()
+void walkPoint(YGNodeRef node, float x, float y, std::vector<int32_t>& hits) {
+  const float width = YGNodeLayoutGetWidth(node);
+  const float height = YGNodeLayoutGetHeight(node);
+  if (!(x >= 0.0f && x < width && y >= 0.0f && y < height)) {
+    return;
+  }
+  hits.push_back(
+      static_cast<int32_t>(reinterpret_cast<intptr_t>(YGNodeGetContext(node))));
+  for (size_t i = 0; i < YGNodeGetChildCount(node); i++) {
+    YGNodeRef child = YGNodeGetChild(node, i);
+    walkPoint(
+        child,
+        x - YGNodeLayoutGetLeft(child),
+        y - YGNodeLayoutGetTop(child),
+        hits);
+  }
+}
+
+// Times finding the views under taps spread over the screen by walking the
+// views and with queryPoint(), and the first query, which builds the indexes
+void reportHitTest(const ShadowScenario& scenario, size_t iterations) {
+  constexpr size_t kTaps = 64;
+  const auto getTap = [](size_t tap) {
+    return std::pair{
+        static_cast<float>(20 + tap * 53 % 350),
+        static_cast<float>(tap * 131 % 844)};
+  };
+
+  ShadowTree tree;
+  mount(tree, scenario);
+  tree.calculateLayout(390, 844);
+  YGNodeRef root = tree.getNode(ShadowTree::RootViewId);
+
+  auto start = Clock::now();
+  tree.queryPoint(ShadowTree::RootViewId, 0, 0);
+  const double indexNanos = elapsedNanos(start, Clock::now());
+
+  std::vector<double> walkNanos;
+  std::vector<double> queryNanos;
+  std::vector<int32_t> hits;
+  for (size_t i = 0; i < iterations; i++) {
+    start = Clock::now();
+    for (size_t tap = 0; tap < kTaps; tap++) {
+      const auto [x, y] = getTap(tap);
+      hits.clear();
+      walkPoint(root, x, y, hits);
+    }
+    walkNanos.push_back(elapsedNanos(start, Clock::now()) / kTaps);
+
+    start = Clock::now();
+    for (size_t tap = 0; tap < kTaps; tap++) {
+      const auto [x, y] = getTap(tap);
+      tree.queryPoint(ShadowTree::RootViewId, x, y);
+    }
+    queryNanos.push_back(elapsedNanos(start, Clock::now()) / kTaps);
+  }
+
+  bool matches = true;
+  for (size_t tap = 0; tap < kTaps; tap++) {
+    const auto [x, y] = getTap(tap);
+    hits.clear();
+    walkPoint(root, x, y, hits);
+    matches = matches && tree.queryPoint(ShadowTree::RootViewId, x, y) == hits;
+  }
+
+  std::printf(
+      "%-24s %10.2f %10.2f %10.1f %8s\n",
+      scenario.name,
+      median(walkNanos) / 1000.0,
+      median(queryNanos) / 1000.0,
+      indexNanos / 1000.0,
+      matches ? "yes" : "NO");
+}
+
+struct ReorderScenario {
+  const char* name;
+  void (*reorder)(std::vector<int32_t>& rows);
+};
+
+std::vector<int32_t> getChildIds(const ShadowTree& tree, int32_t viewId) {
+  std::vector<int32_t> childIds;
+  YGNodeRef node = tree.getNode(viewId);
+  for (size_t i = 0; i < YGNodeGetChildCount(node); i++) {
+    childIds.push_back(static_cast<int32_t>(
+        reinterpret_cast<intptr_t>(YGNodeGetContext(YGNodeGetChild(node, i)))));
+  }
+  return childIds;
+}
+
+// Reorders the rows of a mounted list, replacing them all as setChildren()
+// used to and letting it diff them: the removals and insertions a platform
+// applies to the native views, the time to set the children, and the frames
+// the next layout returns. It checks that both leave the rows in order.
+void reportReorder(const ReorderScenario& scenario, size_t iterations) {
+  const ShadowScenario list{"list 500 rows", 500, 4};
+  constexpr int32_t kListId = 1;
+  std::vector<double> setNanos[2];
+  size_t moves[2] = {};
+  size_t updates[2] = {};
+  bool matches = true;
+
+  for (size_t i = 0; i < iterations; i++) {
+    for (int diff = 0; diff < 2; diff++) {
+      ShadowTree tree;
+      mount(tree, list);
+      tree.calculateLayout(390, 844);
+      const std::vector<int32_t> oldRows = getChildIds(tree, kListId);
+      std::vector<int32_t> rows = oldRows;
+      scenario.reorder(rows);
+
+      const auto start = Clock::now();
+      if (diff == 0) {
+        tree.setChildren(kListId, nullptr, 0);
+      }
+      tree.setChildren(kListId, rows.data(), rows.size());
+      setNanos[diff].push_back(elapsedNanos(start, Clock::now()));
+      updates[diff] = tree.calculateLayout(390, 844).size();
+      matches = matches && getChildIds(tree, kListId) == rows;
+
+      if (diff == 0) {
+        moves[diff] = oldRows.size() + rows.size();
+      } else {
+        ChildrenDiff childrenDiff;
+        childrenDiff.diff(
+            oldRows.data(), oldRows.size(), rows.data(), rows.size());
+        moves[diff] = childrenDiff.getRemovals().size() +
+            childrenDiff.getInsertions().size();
+      }
+    }
+  }
+
+  std::printf(
+      "%-24s %7zu %10.1f %8zu %7zu %10.1f %8zu %8s\n",
+      scenario.name,
+      moves[0],
+      median(setNanos[0]) / 1000.0,
+      updates[0],
+      moves[1],
+      median(setNanos[1]) / 1000.0,
+      updates[1],
+      matches ? "yes" : "NO");
+}
+
+} // namespace
+
+void runShadowBenchmarks(size_t iterations) {
+  const ShadowScenario scenarios[] = {
+      {"list 100 rows", 100, 4},
+      {"list 1000 rows", 1000, 4},
+  };
+
+  std::printf(
+      "%-24s %7s %10s %10s %8s %10s %8s\n",
+      "shadow tree",
+      "nodes",
+      "mount us",
+      "layout us",
+      "updates",
+      "patch us",
+      "updates");
+  for (const auto& scenario : scenarios) {
+    reportShadow(scenario, iterations);
+  }
+
+  std::printf(
+      "\n%-24s %7s %10s %8s %10s %8s %7s %10s %8s %10s %8s %8s\n",
+      "view flattening",
+      "views",
+      "layout us",
+      "updates",
+      "patch us",
+      "updates",
+      "flat",
+      "layout us",
+      "updates",
+      "patch us",
+      "updates",
+      "matches");
+  for (const auto& scenario : scenarios) {
+    reportFlattening(scenario, iterations);
+  }
+
+  std::printf(
+      "\n%-24s %10s %10s %10s %8s\n",
+      "hit testing",
+      "walk us",
+      "query us",
+      "index us",
+      "matches");
+  for (const auto& scenario : scenarios) {
+    reportHitTest(scenario, iterations);
+  }
+
+  const ReorderScenario reorders[] = {
+      {"move one row",
+       [](std::vector<int32_t>& rows) {
+         std::rotate(rows.begin(), rows.begin() + 1, rows.end());
+       }},
+      {"swap two rows",
+       [](std::vector<int32_t>& rows) {
+         std::swap(rows[10], rows[rows.size() - 10]);
+       }},
+      {"move 20 rows",
+       [](std::vector<int32_t>& rows) {
+         std::rotate(rows.begin(), rows.begin() + 20, rows.end());
+       }},
+      {"reverse rows",
+       [](std::vector<int32_t>& rows) {
+         std::reverse(rows.begin(), rows.end());
+       }},
+      {"shuffle rows",
+       [](std::vector<int32_t>& rows) {
+         std::shuffle(rows.begin(), rows.end(), std::mt19937{42});
+       }},
+  };
+
+  std::printf(
+      "\n%-24s %7s %10s %8s %7s %10s %8s %8s\n",
+      "children reorder",
+      "moves",
+      "set us",
+      "updates",
+      "diffed",
+      "set us",
+      "updates",
+      "matches");
+  for (const auto& reorder : reorders) {
+    reportReorder(reorder, iterations);
+  }
+}
+
+} // namespace dcflight::benchmark
@@ -0,0 +1,26 @@
+# Copyright (c) Dotcorr Studio. and affiliates.
+#
+# This source code is licensed under the MIT license found in the
+# LICENSE file in the root directory of this source tree.
+
+set(CMAKE_CXX_STANDARD 20)
+set(CMAKE_CXX_STANDARD_REQUIRED ON)
+set(CMAKE_POSITION_INDEPENDENT_CODE ON)
+
+if(NOT CMAKE_BUILD_TYPE AND NOT CMAKE_CONFIGURATION_TYPES)
+  set(CMAKE_BUILD_TYPE Release)
+endif()
+
+add_compile_definitions($<$<CONFIG:DEBUG>:DEBUG>)
+
+add_compile_options(
+    # Don't omit frame pointers (e.g. for crash dumps)
+    -fno-omit-frame-pointer
+    # Enable warnings and warnings as errors
+    -Wall
+    -Wextra
+    -Werror
+    # Disable RTTI
+    $<$<COMPILE_LANGUAGE:CXX>:-fno-rtti>
+    # Use -O2 (prioritize speed)
+    $<$<CONFIG:RELEASE>:-O2>)
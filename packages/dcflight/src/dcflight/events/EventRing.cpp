@@ -0,0 +1,197 @@
+/*
+ * Copyright (c) Dotcorr Studio. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+
+#include <dcflight/events/EventRing.h>
+
+namespace dcflight::events {
+
+namespace {
+
+uint32_t capacityMask(size_t capacity) {
+  return static_cast<uint32_t>(std::bit_ceil(capacity < 2 ? 2 : capacity) - 1);
+}
+
+uint32_t hashEvent(int32_t viewId, std::string_view type) {
+  // FNV-1a over the view id and the type
+  uint32_t hash = 2166136261u ^ static_cast<uint32_t>(viewId);
+  hash *= 16777619u;
+  for (char c : type) {
+    hash = (hash ^ static_cast<uint8_t>(c)) * 16777619u;
+  }
+  return hash;
+}
+
+} // namespace
+
+EventRing::EventRing(size_t recordCapacity, size_t payloadCapacity)
+    : recordMask_{capacityMask(recordCapacity)},
+      payloadMask_{capacityMask(payloadCapacity)},
+      records_{new EventRecord[recordMask_ + size_t{1}]},
+      sequences_{new std::atomic<uint32_t>[recordMask_ + size_t{1}]},
+      payloads_{new uint8_t[payloadMask_ + size_t{1}]} {
+  for (size_t i = 0; i <= recordMask_; i++) {
+    sequences_[i].store(0, std::memory_order_relaxed);
+  }
+}
+
+bool EventRing::push(
+    int32_t viewId,
+    std::string_view type,
+    std::string_view data) {
+  const size_t length = type.size() + data.size();
+  if (length > payloadMask_) {
+    dropped_.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+  const auto size = static_cast<uint32_t>(length);
+
+  uint32_t ticket;
+  uint32_t start;
+  uint32_t end;
+  while (true) {
+    // Loading released_ first guarantees that it does not run ahead of the
+    // reservation it is compared against
+    const uint64_t released = released_.load(std::memory_order_acquire);
+    uint64_t reserved = reserved_.load(std::memory_order_relaxed);
+    ticket = static_cast<uint32_t>(reserved);
+    const auto cursor = static_cast<uint32_t>(reserved >> 32);
+    if (ticket - static_cast<uint32_t>(released) > recordMask_) {
+      dropped_.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+
+    // A payload that would wrap around the end of the arena starts over at
+    // its beginning instead, so that it can be read in place
+    const uint32_t offset = cursor & payloadMask_;
+    start = offset + size > payloadMask_ + 1
+        ? cursor + (payloadMask_ + 1 - offset)
+        : cursor;
+    end = start + size;
+    if (end - static_cast<uint32_t>(released >> 32) > payloadMask_ + 1) {
+      dropped_.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+
+    if (reserved_.compare_exchange_weak(
+            reserved, pack(ticket + 1, end), std::memory_order_relaxed)) {
+      break;
+    }
+  }
+
+  const uint32_t offset = start & payloadMask_;
+  if (!type.empty()) {
+    std::memcpy(&payloads_[offset], type.data(), type.size());
+  }
+  if (!data.empty()) {
+    std::memcpy(&payloads_[offset + type.size()], data.data(), data.size());
+  }
+  records_[ticket & recordMask_] = EventRecord{
+      viewId,
+      static_cast<uint32_t>(type.size()),
+      static_cast<uint32_t>(data.size()),
+      offset,
+      end,
+      0};
+  sequences_[ticket & recordMask_].store(ticket + 1, std::memory_order_release);
+  return true;
+}
+
+size_t EventRing::beginRead() {
+  size_t count = 0;
+  while (count <= recordMask_) {
+    const auto index = static_cast<uint32_t>(readIndex_ + count);
+    if (sequences_[index & recordMask_].load(std::memory_order_acquire) !=
+        index + 1) {
+      break;
+    }
+    count++;
+  }
+  coalesce(static_cast<uint32_t>(readIndex_ + count));
+  return count;
+}
+
+void EventRing::setCoalescable(std::string_view type, bool coalescable) {
+  auto it =
+      std::find(coalescableTypes_.begin(), coalescableTypes_.end(), type);
+  if (!coalescable) {
+    if (it != coalescableTypes_.end()) {
+      coalescableTypes_.erase(it);
+    }
+    return;
+  }
+  if (it == coalescableTypes_.end()) {
+    coalescableTypes_.emplace_back(type);
+  }
+  if (!latestRecords_) {
+    latestRecords_ = std::make_unique<LatestRecord[]>(2 * (recordMask_ + 1));
+  }
+}
+
+bool EventRing::isCoalescable(std::string_view type) const {
+  return std::find(coalescableTypes_.begin(), coalescableTypes_.end(), type) !=
+      coalescableTypes_.end();
+}
+
+void EventRing::coalesce(uint32_t end) {
+  if (coalescableTypes_.empty()) {
+    scanIndex_ = end;
+    return;
+  }
+
+  // At most one entry per record scanned since the last release, so the
+  // table never fills
+  const uint32_t tableMask = 2 * recordMask_ + 1;
+  for (; scanIndex_ != end; scanIndex_++) {
+    EventRecord& record = records_[scanIndex_ & recordMask_];
+    const std::string_view type = getType(record);
+    if (!isCoalescable(type)) {
+      continue;
+    }
+    for (uint32_t i = hashEvent(record.viewId, type);; i++) {
+      LatestRecord& latest = latestRecords_[i & tableMask];
+      if (latest.epoch != epoch_) {
+        latest = {scanIndex_, epoch_};
+        break;
+      }
+      EventRecord& previous = records_[latest.ticket & recordMask_];
+      if (previous.viewId == record.viewId && getType(previous) == type) {
+        if ((previous.flags & EventRecord::Superseded) == 0) {
+          previous.flags |= EventRecord::Superseded;
+          coalesced_.fetch_add(1, std::memory_order_relaxed);
+        }
+        latest.ticket = scanIndex_;
+        break;
+      }
+    }
+  }
+}
+
+void EventRing::endRead(size_t count) {
+  if (count == 0) {
+    return;
+  }
+  const uint32_t payloadEnd = getRecord(
+                                  static_cast<uint32_t>(readIndex_ + count - 1))
+                                  .payloadEnd;
+  readIndex_ += static_cast<uint32_t>(count);
+  released_.store(pack(readIndex_, payloadEnd), std::memory_order_release);
+
+  // Forget the scanned records, and scan those left unreleased again
+  scanIndex_ = readIndex_;
+  if (++epoch_ == 0) {
+    if (latestRecords_) {
+      std::fill_n(latestRecords_.get(), 2 * (recordMask_ + 1), LatestRecord{});
+    }
+    epoch_ = 1;
+  }
+}
+
+} // namespace dcflight::events
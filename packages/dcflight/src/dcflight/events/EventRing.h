@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) Dotcorr Studio. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace dcflight::events {
+
+/**
+ * Fixed-size header of a queued event. Its payload, the UTF-8 event type
+ * immediately followed by the event data, lives out of line in the payload
+ * arena of the ring at payloadOffset, and never wraps around the end of the
+ * arena. The layout is shared with the FFI, which lets the consumer read
+ * records in place.
+ */
+struct EventRecord {
+  int32_t viewId;
+  uint32_t typeLength;
+  uint32_t dataLength;
+  uint32_t payloadOffset;
+  // Payload cursor once this record is released, including any padding that
+  // was skipped to keep the payload contiguous
+  uint32_t payloadEnd;
+  // Set by the consumer, e.g. Superseded (see EventRing::setCoalescable())
+  uint32_t flags;
+
+  static constexpr uint32_t Superseded = 1;
+};
+
+/**
+ * Bounded multi-producer, single-consumer queue of events.
+ *
+ * Producers on any thread reserve a record slot and its payload bytes with a
+ * single compare-and-swap, copy the event in, and publish the slot. The
+ * consumer reads the published records in place, in reservation order, and
+ * then releases them. Pushing and reading never allocate; when the ring is
+ * full, events are dropped and counted instead of blocking the producer.
+ *
+ * Events of a coalescable type, such as scroll events, are coalesced per view
+ * as they are read: of the unreleased events of one view and type, all but
+ * the latest are flagged Superseded for the consumer to skip. The consumer
+ * then handles one event per view in a burst, at the position of the latest.
+ */
+class EventRing {
+ public:
+  // Both capacities are rounded up to a power of two
+  EventRing(size_t recordCapacity, size_t payloadCapacity);
+
+  EventRing(const EventRing&) = delete;
+  EventRing& operator=(const EventRing&) = delete;
+
+  // Producer side, callable from any thread. Returns false if the event was
+  // dropped because the ring is full.
+  bool push(int32_t viewId, std::string_view type, std::string_view data);
+
+  // Consumer side, callable from one thread at a time. beginRead() returns
+  // how many records starting at index getReadIndex() are ready to be read,
+  // and endRead() releases that many of them to producers.
+  size_t beginRead();
+  void endRead(size_t count);
+
+  // Consumer side. Sets whether the events of a type are coalesced, which
+  // applies to the events not read yet.
+  void setCoalescable(std::string_view type, bool coalescable);
+
+  uint32_t getReadIndex() const {
+    return readIndex_;
+  }
+
+  const EventRecord& getRecord(uint32_t index) const {
+    return records_[index & recordMask_];
+  }
+
+  std::string_view getType(const EventRecord& record) const {
+    return {
+        reinterpret_cast<const char*>(&payloads_[record.payloadOffset]),
+        record.typeLength};
+  }
+
+  std::string_view getData(const EventRecord& record) const {
+    return {
+        reinterpret_cast<const char*>(
+            &payloads_[record.payloadOffset + record.typeLength]),
+        record.dataLength};
+  }
+
+  const EventRecord* getRecords() const {
+    return records_.get();
+  }
+
+  const uint8_t* getPayloads() const {
+    return payloads_.get();
+  }
+
+  size_t getRecordCapacity() const {
+    return recordMask_ + 1;
+  }
+
+  size_t getPayloadCapacity() const {
+    return payloadMask_ + 1;
+  }
+
+  uint64_t getDroppedCount() const {
+    return dropped_.load(std::memory_order_relaxed);
+  }
+
+  // Number of events superseded by a later one so far
+  uint64_t getCoalescedCount() const {
+    return coalesced_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  // Record tickets and payload cursors are free running 32-bit counters,
+  // packed together so that both are reserved by one atomic operation
+  static uint64_t pack(uint32_t ticket, uint32_t cursor) {
+    return uint64_t{cursor} << 32 | ticket;
+  }
+
+  const uint32_t recordMask_;
+  const uint32_t payloadMask_;
+  std::unique_ptr<EventRecord[]> records_;
+  std::unique_ptr<std::atomic<uint32_t>[]> sequences_;
+  std::unique_ptr<uint8_t[]> payloads_;
+
+  alignas(64) std::atomic<uint64_t> reserved_{0};
+  alignas(64) std::atomic<uint64_t> released_{0};
+  std::atomic<uint64_t> dropped_{0};
+
+  // The latest record of a view and coalescable type scanned since the
+  // records were last released, valid if its epoch is the current one
+  struct LatestRecord {
+    uint32_t ticket;
+    uint32_t epoch;
+  };
+
+  bool isCoalescable(std::string_view type) const;
+  // Flags the records superseded by those ready up to `end`
+  void coalesce(uint32_t end);
+
+  std::atomic<uint64_t> coalesced_{0};
+
+  // Owned by the consumer
+  uint32_t readIndex_ = 0;
+  uint32_t scanIndex_ = 0;
+  uint32_t epoch_ = 1;
+  std::vector<std::string> coalescableTypes_;
+  // Open addressed by view and type, twice the record capacity, allocated
+  // when a type is first made coalescable
+  std::unique_ptr<LatestRecord[]> latestRecords_;
+};
+
+} // namespace dcflight::events
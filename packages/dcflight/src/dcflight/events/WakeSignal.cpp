@@ -0,0 +1,37 @@
+/*
+ * Copyright (c) Dotcorr Studio. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <dcflight/events/WakeSignal.h>
+
+namespace dcflight::events {
+
+void WakeSignal::setWakeFunction(WakeFunction wake) {
+  wake_.store(wake, std::memory_order_release);
+}
+
+bool WakeSignal::notify() {
+  // Acquires the rearming of the consumer, and releases the work queued
+  // before to the consumer which rearms next
+  if (pending_.exchange(true, std::memory_order_acq_rel)) {
+    return false;
+  }
+  const WakeFunction wake = wake_.load(std::memory_order_acquire);
+  if (wake == nullptr) {
+    return false;
+  }
+  wakes_.fetch_add(1, std::memory_order_relaxed);
+  wake();
+  return true;
+}
+
+void WakeSignal::rearm() {
+  // An exchange rather than a store, so that the consumer acquires the work
+  // of producers which found the signal pending and did not wake it
+  pending_.exchange(false, std::memory_order_acq_rel);
+}
+
+} // namespace dcflight::events
@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) Dotcorr Studio. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace dcflight::events {
+
+/**
+ * Wakes the consumer of a queue when work is queued, rather than having it
+ * poll the queue on a timer.
+ *
+ * Producers call notify() after queueing. Only the first call since the
+ * consumer last rearmed the signal calls the wake function, so that a burst
+ * costs the consumer a single wake-up and an idle consumer is never woken.
+ * The consumer calls rearm() before draining the queue, so that work queued
+ * while it drains wakes it again rather than waiting for the next burst.
+ */
+class WakeSignal {
+ public:
+  using WakeFunction = void (*)();
+
+  WakeSignal() = default;
+
+  WakeSignal(const WakeSignal&) = delete;
+  WakeSignal& operator=(const WakeSignal&) = delete;
+
+  // Sets or, given nullptr, clears the function called to wake the consumer.
+  // It is called on the producer's thread, so it should only schedule the
+  // drain, e.g. by posting to the consumer's event loop. Work queued before
+  // it was set is only seen by the next drain.
+  void setWakeFunction(WakeFunction wake);
+
+  // Producer side, callable from any thread. Returns whether the consumer
+  // was woken.
+  bool notify();
+
+  // Consumer side, before reading the queue
+  void rearm();
+
+  uint64_t getWakeCount() const {
+    return wakes_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  std::atomic<WakeFunction> wake_{nullptr};
+  std::atomic<bool> pending_{false};
+  std::atomic<uint64_t> wakes_{0};
+};
+
+} // namespace dcflight::events
@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) Dotcorr Studio. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <dcflight/mutation/CommandBuffer.h>
+
+#include <utility>
+
+namespace dcflight::mutation {
+
+void CommandBatch::clear() {
+  commands_.clear();
+  text_.clear();
+  childIds_.clear();
+}
+
+Command& CommandBatch::append(CommandType type, int32_t viewId) {
+  Command& command = commands_.emplace_back();
+  command.type = type;
+  command.viewId = viewId;
+  return command;
+}
+
+void CommandBatch::appendText(
+    Command& command,
+    std::string_view viewType,
+    std::string_view text) {
+  command.textOffset = static_cast<uint32_t>(text_.size());
+  command.viewTypeLength = static_cast<uint32_t>(viewType.size());
+  command.textLength = static_cast<uint32_t>(text.size());
+  text_.append(viewType);
+  text_.append(text);
+}
+
+void CommandBuffer::setScheduleFunction(ScheduleFunction schedule) {
+  schedule_.store(schedule, std::memory_order_release);
+}
+
+template <typename Append>
+void CommandBuffer::queue(Append&& append) {
+  bool wasEmpty;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    wasEmpty = pending_.empty();
+    append(pending_);
+  }
+  // Called outside of the lock, as it may wait for the UI thread, which takes
+  // the lock to take the queue
+  if (!wasEmpty) {
+    return;
+  }
+  const ScheduleFunction schedule = schedule_.load(std::memory_order_acquire);
+  if (schedule != nullptr) {
+    schedules_.fetch_add(1, std::memory_order_relaxed);
+    schedule();
+  }
+}
+
+void CommandBuffer::createView(
+    int32_t viewId,
+    std::string_view viewType,
+    std::string_view propsJson) {
+  queue([&](CommandBatch& batch) {
+    Command& command = batch.append(CommandType::CreateView, viewId);
+    batch.appendText(command, viewType, propsJson);
+  });
+}
+
+void CommandBuffer::updateView(int32_t viewId, std::string_view propsJson) {
+  queue([&](CommandBatch& batch) {
+    Command& command = batch.append(CommandType::UpdateView, viewId);
+    batch.appendText(command, {}, propsJson);
+  });
+}
+
+void CommandBuffer::deleteView(int32_t viewId) {
+  queue([&](CommandBatch& batch) {
+    batch.append(CommandType::DeleteView, viewId);
+  });
+}
+
+void CommandBuffer::detachView(int32_t viewId) {
+  queue([&](CommandBatch& batch) {
+    batch.append(CommandType::DetachView, viewId);
+  });
+}
+
+void CommandBuffer::attachView(
+    int32_t childId,
+    int32_t parentId,
+    int32_t index) {
+  queue([&](CommandBatch& batch) {
+    Command& command = batch.append(CommandType::AttachView, childId);
+    command.parentId = parentId;
+    command.index = index;
+  });
+}
+
+void CommandBuffer::setChildren(
+    int32_t viewId,
+    const int32_t* childIds,
+    size_t count) {
+  queue([&](CommandBatch& batch) {
+    Command& command = batch.append(CommandType::SetChildren, viewId);
+    command.childOffset = static_cast<uint32_t>(batch.childIds_.size());
+    command.childCount = static_cast<uint32_t>(count);
+    batch.childIds_.insert(batch.childIds_.end(), childIds, childIds + count);
+  });
+}
+
+void CommandBuffer::addEventListeners(
+    int32_t viewId,
+    std::string_view eventTypes) {
+  queue([&](CommandBatch& batch) {
+    Command& command = batch.append(CommandType::AddEventListeners, viewId);
+    batch.appendText(command, {}, eventTypes);
+  });
+}
+
+void CommandBuffer::removeEventListeners(
+    int32_t viewId,
+    std::string_view eventTypes) {
+  queue([&](CommandBatch& batch) {
+    Command& command = batch.append(CommandType::RemoveEventListeners, viewId);
+    batch.appendText(command, {}, eventTypes);
+  });
+}
+
+size_t CommandBuffer::take(CommandBatch& batch) {
+  batch.clear();
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::swap(pending_, batch);
+  return batch.commands_.size();
+}
+
+size_t CommandBuffer::getPendingCount() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return pending_.commands_.size();
+}
+
+} // namespace dcflight::mutation
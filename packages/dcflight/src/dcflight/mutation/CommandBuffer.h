@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) Dotcorr Studio. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace dcflight::mutation {
+
+enum class CommandType : uint8_t {
+  CreateView,
+  UpdateView,
+  DeleteView,
+  DetachView,
+  AttachView,
+  SetChildren,
+  AddEventListeners,
+  RemoveEventListeners,
+};
+
+// A queued view operation. Its strings and child ids are stored in the batch
+// holding it, and read with the getters of CommandBatch.
+struct Command {
+  CommandType type;
+  int32_t viewId;
+  // The parent and index of AttachView
+  int32_t parentId = 0;
+  int32_t index = 0;
+  // The view type of CreateView, followed by the props JSON of CreateView and
+  // UpdateView or the event types of the listener commands
+  uint32_t textOffset = 0;
+  uint32_t viewTypeLength = 0;
+  uint32_t textLength = 0;
+  // The child ids of SetChildren
+  uint32_t childOffset = 0;
+  uint32_t childCount = 0;
+};
+
+/**
+ * View operations in the order they were queued, taken from a CommandBuffer
+ * to be run on the UI thread.
+ */
+class CommandBatch {
+ public:
+  const std::vector<Command>& getCommands() const {
+    return commands_;
+  }
+
+  bool empty() const {
+    return commands_.empty();
+  }
+
+  std::string_view getViewType(const Command& command) const {
+    return {text_.data() + command.textOffset, command.viewTypeLength};
+  }
+
+  // The props JSON or the event types of a command
+  std::string_view getText(const Command& command) const {
+    return {
+        text_.data() + command.textOffset + command.viewTypeLength,
+        command.textLength};
+  }
+
+  const int32_t* getChildIds(const Command& command) const {
+    return childIds_.data() + command.childOffset;
+  }
+
+  // Keeps the storage, to be reused by the next batch
+  void clear();
+
+ private:
+  friend class CommandBuffer;
+
+  Command& append(CommandType type, int32_t viewId);
+  void appendText(
+      Command& command,
+      std::string_view viewType,
+      std::string_view text);
+
+  std::vector<Command> commands_;
+  std::string text_;
+  std::vector<int32_t> childIds_;
+};
+
+/**
+ * Queues view operations from any thread, so that the UI thread runs them in
+ * one hop rather than each caller waiting on it per operation.
+ *
+ * Operations are queued in the order of the calls which queued them, and
+ * take() moves them to a batch in that order. The UI thread is the only one
+ * to take batches, and runs each before taking the next, so they run in the
+ * order they were queued. The first operation queued after a batch was taken
+ * calls the schedule function, which should arrange for the UI thread to take
+ * the next one, e.g. before it draws the next frame.
+ *
+ * Taking swaps the storage of the queue with that of the batch, so that a
+ * queue and a batch reused frame after frame stop allocating.
+ */
+class CommandBuffer {
+ public:
+  using ScheduleFunction = void (*)();
+
+  CommandBuffer() = default;
+
+  CommandBuffer(const CommandBuffer&) = delete;
+  CommandBuffer& operator=(const CommandBuffer&) = delete;
+
+  // Sets or, given nullptr, clears the function called on the queueing thread
+  // when the queue stops being empty
+  void setScheduleFunction(ScheduleFunction schedule);
+
+  void createView(
+      int32_t viewId,
+      std::string_view viewType,
+      std::string_view propsJson);
+  void updateView(int32_t viewId, std::string_view propsJson);
+  void deleteView(int32_t viewId);
+  void detachView(int32_t viewId);
+  void attachView(int32_t childId, int32_t parentId, int32_t index);
+  void setChildren(int32_t viewId, const int32_t* childIds, size_t count);
+  void addEventListeners(int32_t viewId, std::string_view eventTypes);
+  void removeEventListeners(int32_t viewId, std::string_view eventTypes);
+
+  // Replaces the commands of `batch` with the queued ones and empties the
+  // queue. Returns the number of commands taken.
+  size_t take(CommandBatch& batch);
+
+  size_t getPendingCount() const;
+
+  // Number of times the schedule function was called so far
+  uint64_t getScheduleCount() const {
+    return schedules_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  // Appends a command with `append`, then calls the schedule function if the
+  // queue was empty
+  template <typename Append>
+  void queue(Append&& append);
+
+  mutable std::mutex mutex_;
+  CommandBatch pending_;
+  std::atomic<ScheduleFunction> schedule_{nullptr};
+  std::atomic<uint64_t> schedules_{0};
+};
+
+} // namespace dcflight::mutation
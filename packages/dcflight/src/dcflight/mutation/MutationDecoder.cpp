@@ -0,0 +1,421 @@
+/*
+ * Copyright (c) Dotcorr Studio. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <bit>
+
+#include <dcflight/mutation/MutationDecoder.h>
+
+static_assert(
+    std::endian::native == std::endian::little,
+    "The mutation protocol is read in host byte order");
+
+namespace dcflight::mutation {
+
+namespace {
+
+DecodeStatus validateValue(ByteReader& reader, size_t strings, size_t depth);
+
+DecodeStatus validateContainer(
+    ByteReader& reader,
+    bool isMap,
+    size_t strings,
+    size_t depth) {
+  uint32_t byteLength = 0;
+  const uint8_t* bytes = nullptr;
+  if (!reader.read(byteLength) || !reader.readBytes(byteLength, bytes)) {
+    return DecodeStatus::MalformedValue;
+  }
+
+  ByteReader body{bytes, byteLength};
+  uint32_t count = 0;
+  if (!body.read(count)) {
+    return DecodeStatus::MalformedValue;
+  }
+  for (uint32_t i = 0; i < count; i++) {
+    uint32_t keyId = 0;
+    if (isMap) {
+      if (!body.read(keyId)) {
+        return DecodeStatus::MalformedValue;
+      }
+      if (keyId >= strings) {
+        return DecodeStatus::UnknownString;
+      }
+    }
+    const auto status = validateValue(body, strings, depth + 1);
+    if (status != DecodeStatus::Ok) {
+      return status;
+    }
+  }
+
+  return body.remaining() == 0 ? DecodeStatus::Ok
+                               : DecodeStatus::MalformedValue;
+}
+
+DecodeStatus validateValue(ByteReader& reader, size_t strings, size_t depth) {
+  uint8_t type = 0;
+  if (depth > MaxValueDepth || !reader.read(type)) {
+    return DecodeStatus::MalformedValue;
+  }
+
+  switch (static_cast<ValueType>(type)) {
+    case ValueType::Null:
+    case ValueType::False:
+    case ValueType::True:
+      return DecodeStatus::Ok;
+    case ValueType::Int:
+    case ValueType::Double:
+      return reader.skip(8) ? DecodeStatus::Ok : DecodeStatus::MalformedValue;
+    case ValueType::String: {
+      uint32_t length = 0;
+      return reader.read(length) && reader.skip(length)
+          ? DecodeStatus::Ok
+          : DecodeStatus::MalformedValue;
+    }
+    case ValueType::List:
+      return validateContainer(reader, false, strings, depth);
+    case ValueType::Map:
+      return validateContainer(reader, true, strings, depth);
+  }
+  return DecodeStatus::MalformedValue;
+}
+
+DecodeStatus validateStringIds(ByteReader& payload, size_t strings) {
+  uint32_t count = 0;
+  if (!payload.read(count) || count > payload.remaining() / 4) {
+    return DecodeStatus::MalformedOp;
+  }
+  for (uint32_t i = 0; i < count; i++) {
+    uint32_t id = 0;
+    payload.read(id);
+    if (id >= strings) {
+      return DecodeStatus::UnknownString;
+    }
+  }
+  return DecodeStatus::Ok;
+}
+
+DecodeStatus validateOp(uint8_t opcode, ByteReader payload, size_t strings) {
+  int32_t viewId = 0;
+  auto status = DecodeStatus::Ok;
+
+  switch (static_cast<OpCode>(opcode)) {
+    case OpCode::CreateView: {
+      uint32_t viewTypeId = 0;
+      if (!payload.read(viewId) || !payload.read(viewTypeId)) {
+        return DecodeStatus::MalformedOp;
+      }
+      if (viewTypeId >= strings) {
+        return DecodeStatus::UnknownString;
+      }
+      status = validateContainer(payload, true, strings, 0);
+      break;
+    }
+    case OpCode::UpdateView:
+      if (!payload.read(viewId)) {
+        return DecodeStatus::MalformedOp;
+      }
+      status = validateContainer(payload, true, strings, 0);
+      break;
+    case OpCode::DeleteView:
+    case OpCode::DetachView:
+      if (!payload.read(viewId)) {
+        return DecodeStatus::MalformedOp;
+      }
+      break;
+    case OpCode::AttachView:
+      if (!payload.skip(12)) {
+        return DecodeStatus::MalformedOp;
+      }
+      break;
+    case OpCode::SetChildren: {
+      uint32_t count = 0;
+      if (!payload.read(viewId) || !payload.read(count) ||
+          count > payload.remaining() / 4 || !payload.skip(count * 4)) {
+        return DecodeStatus::MalformedOp;
+      }
+      break;
+    }
+    case OpCode::AddEventListeners:
+    case OpCode::RemoveEventListeners:
+      if (!payload.read(viewId)) {
+        return DecodeStatus::MalformedOp;
+      }
+      status = validateStringIds(payload, strings);
+      break;
+    default:
+      // Ops from a newer encoder are skipped
+      return DecodeStatus::Ok;
+  }
+
+  if (status != DecodeStatus::Ok) {
+    return status;
+  }
+  return payload.remaining() == 0 ? DecodeStatus::Ok
+                                  : DecodeStatus::MalformedOp;
+}
+
+// Reads the count prefixed body of a validated container
+ByteReader readContainer(ByteReader& reader, uint32_t& count) {
+  uint32_t byteLength = 0;
+  const uint8_t* bytes = nullptr;
+  reader.read(byteLength);
+  reader.readBytes(byteLength, bytes);
+  ByteReader body{bytes, byteLength};
+  body.read(count);
+  return body;
+}
+
+MapReader readProps(ByteReader& payload, const StringTable* strings) {
+  uint32_t count = 0;
+  auto entries = readContainer(payload, count);
+  return MapReader{entries, count, strings};
+}
+
+template <typename T>
+PackedArray<T> readArray(ByteReader& payload) {
+  uint32_t count = 0;
+  const uint8_t* data = nullptr;
+  payload.read(count);
+  payload.readBytes(count * sizeof(T), data);
+  return PackedArray<T>{data, count};
+}
+
+void dispatchOp(
+    uint8_t opcode,
+    ByteReader payload,
+    const StringTable& strings,
+    MutationHandler& handler) {
+  int32_t viewId = 0;
+  switch (static_cast<OpCode>(opcode)) {
+    case OpCode::CreateView: {
+      uint32_t viewTypeId = 0;
+      payload.read(viewId);
+      payload.read(viewTypeId);
+      handler.createView(
+          viewId, strings.get(viewTypeId), readProps(payload, &strings));
+      break;
+    }
+    case OpCode::UpdateView:
+      payload.read(viewId);
+      handler.updateView(viewId, readProps(payload, &strings));
+      break;
+    case OpCode::DeleteView:
+      payload.read(viewId);
+      handler.deleteView(viewId);
+      break;
+    case OpCode::AttachView: {
+      int32_t parentId = 0;
+      int32_t index = 0;
+      payload.read(viewId);
+      payload.read(parentId);
+      payload.read(index);
+      handler.attachView(viewId, parentId, index);
+      break;
+    }
+    case OpCode::DetachView:
+      payload.read(viewId);
+      handler.detachView(viewId);
+      break;
+    case OpCode::SetChildren:
+      payload.read(viewId);
+      handler.setChildren(viewId, readArray<int32_t>(payload));
+      break;
+    case OpCode::AddEventListeners:
+      payload.read(viewId);
+      handler.addEventListeners(
+          viewId, StringList{readArray<uint32_t>(payload), strings});
+      break;
+    case OpCode::RemoveEventListeners:
+      payload.read(viewId);
+      handler.removeEventListeners(
+          viewId, StringList{readArray<uint32_t>(payload), strings});
+      break;
+  }
+}
+
+bool readOp(ByteReader& reader, uint8_t& opcode, ByteReader& payload) {
+  uint32_t length = 0;
+  const uint8_t* bytes = nullptr;
+  if (!reader.read(opcode) || !reader.read(length) ||
+      !reader.readBytes(length, bytes)) {
+    return false;
+  }
+  payload = ByteReader{bytes, length};
+  return true;
+}
+
+} // namespace
+
+bool readValue(ByteReader& reader, const StringTable* strings, Value& value) {
+  uint8_t type = 0;
+  if (!reader.read(type)) {
+    return false;
+  }
+
+  value = Value{};
+  value.type_ = static_cast<ValueType>(type);
+  value.strings_ = strings;
+  switch (value.type_) {
+    case ValueType::Int:
+      return reader.read(value.int_);
+    case ValueType::Double:
+      return reader.read(value.double_);
+    case ValueType::String: {
+      uint32_t length = 0;
+      const uint8_t* bytes = nullptr;
+      if (!reader.read(length) || !reader.readBytes(length, bytes)) {
+        return false;
+      }
+      value.string_ = {reinterpret_cast<const char*>(bytes), length};
+      return true;
+    }
+    case ValueType::List:
+    case ValueType::Map:
+      value.container_ = readContainer(reader, value.count_);
+      return true;
+    default:
+      return true;
+  }
+}
+
+ListReader Value::asList() const {
+  return type_ == ValueType::List ? ListReader{container_, count_, strings_}
+                                  : ListReader{{}, 0, strings_};
+}
+
+MapReader Value::asMap() const {
+  return type_ == ValueType::Map ? MapReader{container_, count_, strings_}
+                                 : MapReader{{}, 0, strings_};
+}
+
+bool ListReader::next(Value& value) {
+  if (remaining_ == 0 || !readValue(items_, strings_, value)) {
+    return false;
+  }
+  remaining_--;
+  return true;
+}
+
+bool MapReader::next(Symbol& key, Value& value) {
+  uint32_t keyId = 0;
+  if (remaining_ == 0 || !entries_.read(keyId) ||
+      !readValue(entries_, strings_, value)) {
+    return false;
+  }
+  key = strings_->get(keyId);
+  remaining_--;
+  return true;
+}
+
+const char* toString(DecodeStatus status) {
+  switch (status) {
+    case DecodeStatus::Ok:
+      return "ok";
+    case DecodeStatus::Truncated:
+      return "truncated";
+    case DecodeStatus::BadMagic:
+      return "bad-magic";
+    case DecodeStatus::UnsupportedVersion:
+      return "unsupported-version";
+    case DecodeStatus::StringTableMismatch:
+      return "string-table-mismatch";
+    case DecodeStatus::UnknownString:
+      return "unknown-string";
+    case DecodeStatus::MalformedOp:
+      return "malformed-op";
+    case DecodeStatus::MalformedValue:
+      return "malformed-value";
+    case DecodeStatus::TrailingBytes:
+      return "trailing-bytes";
+  }
+  return "unknown";
+}
+
+DecodeStatus MutationDecoder::decode(
+    const uint8_t* data,
+    size_t length,
+    MutationHandler& handler) {
+  ByteReader reader{data, length};
+  uint32_t magic = 0;
+  uint16_t version = 0;
+  uint16_t flags = 0;
+  uint32_t firstStringId = 0;
+  uint32_t stringCount = 0;
+  uint32_t opCount = 0;
+  if (!reader.read(magic) || !reader.read(version) || !reader.read(flags) ||
+      !reader.read(firstStringId) || !reader.read(stringCount) ||
+      !reader.read(opCount)) {
+    return DecodeStatus::Truncated;
+  }
+  if (magic != ProtocolMagic) {
+    return DecodeStatus::BadMagic;
+  }
+  if (version != ProtocolVersion) {
+    return DecodeStatus::UnsupportedVersion;
+  }
+
+  const bool resetStrings =
+      (flags & static_cast<uint16_t>(HeaderFlags::ResetStrings)) != 0;
+  const size_t baseStringId = resetStrings ? 0 : strings_.size();
+  if (firstStringId != baseStringId) {
+    return DecodeStatus::StringTableMismatch;
+  }
+  const size_t knownStrings = baseStringId + stringCount;
+
+  // Validate the whole buffer before touching the string table or the
+  // handler, so that a bad buffer leaves no trace
+  const ByteReader stringSection = reader;
+  for (uint32_t i = 0; i < stringCount; i++) {
+    uint32_t stringLength = 0;
+    if (!reader.read(stringLength) || !reader.skip(stringLength)) {
+      return DecodeStatus::Truncated;
+    }
+  }
+
+  const ByteReader opSection = reader;
+  for (uint32_t i = 0; i < opCount; i++) {
+    uint8_t opcode = 0;
+    ByteReader payload;
+    if (!readOp(reader, opcode, payload)) {
+      return DecodeStatus::Truncated;
+    }
+    const auto status = validateOp(opcode, payload, knownStrings);
+    if (status != DecodeStatus::Ok) {
+      return status;
+    }
+  }
+  if (reader.remaining() != 0) {
+    return DecodeStatus::TrailingBytes;
+  }
+
+  if (resetStrings) {
+    strings_.strings_.clear();
+    strings_.generation_++;
+  }
+  reader = stringSection;
+  strings_.strings_.reserve(knownStrings);
+  for (uint32_t i = 0; i < stringCount; i++) {
+    uint32_t stringLength = 0;
+    const uint8_t* bytes = nullptr;
+    reader.read(stringLength);
+    reader.readBytes(stringLength, bytes);
+    strings_.strings_.emplace_back(
+        reinterpret_cast<const char*>(bytes), stringLength);
+  }
+
+  reader = opSection;
+  for (uint32_t i = 0; i < opCount; i++) {
+    uint8_t opcode = 0;
+    ByteReader payload;
+    readOp(reader, opcode, payload);
+    dispatchOp(opcode, payload, strings_, handler);
+  }
+
+  return DecodeStatus::Ok;
+}
+
+} // namespace dcflight::mutation
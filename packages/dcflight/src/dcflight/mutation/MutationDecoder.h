@@ -0,0 +1,293 @@
+/*
+ * Copyright (c) Dotcorr Studio. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <dcflight/mutation/MutationProtocol.h>
+
+namespace dcflight::mutation {
+
+/**
+ * An interned string. Ids are dense and stable for the rest of the session,
+ * so handlers can key their own caches (e.g. of platform strings or resolved
+ * prop setters) by id instead of hashing the string.
+ */
+struct Symbol {
+  uint32_t id = 0;
+  std::string_view name;
+};
+
+/**
+ * Interned strings shared by every buffer of a session. Names returned by
+ * get() remain valid until the next buffer is decoded.
+ */
+class StringTable {
+ public:
+  size_t size() const {
+    return strings_.size();
+  }
+
+  Symbol get(uint32_t id) const {
+    return {id, strings_[id]};
+  }
+
+  // Incremented whenever the table is cleared, which invalidates every id
+  // handed out before
+  uint32_t getGeneration() const {
+    return generation_;
+  }
+
+ private:
+  friend class MutationDecoder;
+
+  std::vector<std::string> strings_;
+  uint32_t generation_ = 0;
+};
+
+/**
+ * Bounds checked cursor over a span of bytes. Reads fail, without advancing,
+ * once the span is exhausted.
+ */
+class ByteReader {
+ public:
+  ByteReader() = default;
+  ByteReader(const uint8_t* data, size_t length)
+      : cursor_{data}, end_{data + length} {}
+
+  size_t remaining() const {
+    return static_cast<size_t>(end_ - cursor_);
+  }
+
+  const uint8_t* position() const {
+    return cursor_;
+  }
+
+  template <typename T>
+  bool read(T& value) {
+    if (remaining() < sizeof(T)) {
+      return false;
+    }
+    std::memcpy(&value, cursor_, sizeof(T));
+    cursor_ += sizeof(T);
+    return true;
+  }
+
+  bool readBytes(size_t length, const uint8_t*& bytes) {
+    if (remaining() < length) {
+      return false;
+    }
+    bytes = cursor_;
+    cursor_ += length;
+    return true;
+  }
+
+  bool skip(size_t length) {
+    const uint8_t* bytes = nullptr;
+    return readBytes(length, bytes);
+  }
+
+ private:
+  const uint8_t* cursor_ = nullptr;
+  const uint8_t* end_ = nullptr;
+};
+
+class ListReader;
+class MapReader;
+
+/**
+ * A decoded prop value. Strings and nested containers point into the buffer
+ * being decoded and must not outlive the handler callback they were passed to.
+ */
+class Value {
+ public:
+  ValueType type() const {
+    return type_;
+  }
+
+  bool isNull() const {
+    return type_ == ValueType::Null;
+  }
+
+  bool asBool() const {
+    return type_ == ValueType::True;
+  }
+
+  int64_t asInt() const {
+    return type_ == ValueType::Double ? static_cast<int64_t>(double_)
+                                      : int_;
+  }
+
+  double asDouble() const {
+    return type_ == ValueType::Int ? static_cast<double>(int_) : double_;
+  }
+
+  std::string_view asString() const {
+    return string_;
+  }
+
+  ListReader asList() const;
+  MapReader asMap() const;
+
+ private:
+  friend bool readValue(ByteReader&, const StringTable*, Value&);
+
+  ValueType type_ = ValueType::Null;
+  int64_t int_ = 0;
+  double double_ = 0;
+  std::string_view string_;
+  ByteReader container_;
+  uint32_t count_ = 0;
+  const StringTable* strings_ = nullptr;
+};
+
+class ListReader {
+ public:
+  ListReader(ByteReader items, uint32_t count, const StringTable* strings)
+      : items_{items}, remaining_{count}, count_{count}, strings_{strings} {}
+
+  uint32_t size() const {
+    return count_;
+  }
+
+  // Reads the next item, returning false once every item was read
+  bool next(Value& value);
+
+ private:
+  ByteReader items_;
+  uint32_t remaining_;
+  uint32_t count_;
+  const StringTable* strings_;
+};
+
+class MapReader {
+ public:
+  MapReader(ByteReader entries, uint32_t count, const StringTable* strings)
+      : entries_{entries},
+        remaining_{count},
+        count_{count},
+        strings_{strings} {}
+
+  uint32_t size() const {
+    return count_;
+  }
+
+  // Reads the next entry, returning false once every entry was read
+  bool next(Symbol& key, Value& value);
+
+ private:
+  ByteReader entries_;
+  uint32_t remaining_;
+  uint32_t count_;
+  const StringTable* strings_;
+};
+
+/**
+ * A u32 or i32 array embedded in an op payload. Elements are unaligned, so
+ * they are copied out one at a time.
+ */
+template <typename T>
+class PackedArray {
+ public:
+  PackedArray(const uint8_t* data, uint32_t count)
+      : data_{data}, count_{count} {}
+
+  uint32_t size() const {
+    return count_;
+  }
+
+  T operator[](size_t index) const {
+    T value{};
+    std::memcpy(&value, data_ + index * sizeof(T), sizeof(T));
+    return value;
+  }
+
+ private:
+  const uint8_t* data_;
+  uint32_t count_;
+};
+
+class StringList {
+ public:
+  StringList(PackedArray<uint32_t> ids, const StringTable& strings)
+      : ids_{ids}, strings_{&strings} {}
+
+  uint32_t size() const {
+    return ids_.size();
+  }
+
+  Symbol operator[](size_t index) const {
+    return strings_->get(ids_[index]);
+  }
+
+ private:
+  PackedArray<uint32_t> ids_;
+  const StringTable* strings_;
+};
+
+/**
+ * Receives the ops of a buffer, in buffer order. Handlers are only invoked
+ * once the whole buffer has been validated, so a malformed buffer never
+ * results in a partially applied batch.
+ */
+class MutationHandler {
+ public:
+  virtual ~MutationHandler() = default;
+
+  virtual void
+  createView(int32_t viewId, Symbol viewType, MapReader props) = 0;
+  virtual void updateView(int32_t viewId, MapReader props) = 0;
+  virtual void deleteView(int32_t viewId) = 0;
+  virtual void attachView(int32_t childId, int32_t parentId, int32_t index) = 0;
+  virtual void detachView(int32_t viewId) = 0;
+  virtual void setChildren(int32_t viewId, PackedArray<int32_t> childIds) = 0;
+  virtual void addEventListeners(int32_t viewId, StringList eventTypes) = 0;
+  virtual void removeEventListeners(int32_t viewId, StringList eventTypes) = 0;
+};
+
+enum class DecodeStatus {
+  Ok,
+  Truncated,
+  BadMagic,
+  UnsupportedVersion,
+  // firstStringId does not match the table, e.g. after a lost buffer
+  StringTableMismatch,
+  UnknownString,
+  MalformedOp,
+  MalformedValue,
+  TrailingBytes,
+};
+
+const char* toString(DecodeStatus status);
+
+/**
+ * Decodes mutation buffers and dispatches their ops to a handler. A decoder
+ * owns the string table of a session, so buffers must be decoded by the same
+ * decoder in the order they were encoded. A decoder is not thread-safe.
+ */
+class MutationDecoder {
+ public:
+  DecodeStatus decode(
+      const uint8_t* data,
+      size_t length,
+      MutationHandler& handler);
+
+  const StringTable& strings() const {
+    return strings_;
+  }
+
+ private:
+  StringTable strings_;
+};
+
+} // namespace dcflight::mutation
@@ -0,0 +1,267 @@
+/*
+ * Copyright (c) Dotcorr Studio. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <bit>
+#include <cassert>
+#include <cstring>
+
+#include <dcflight/mutation/MutationEncoder.h>
+
+static_assert(
+    std::endian::native == std::endian::little,
+    "The mutation protocol is written in host byte order");
+
+namespace dcflight::mutation {
+
+namespace {
+
+template <typename T>
+void append(std::vector<uint8_t>& bytes, T value) {
+  const auto offset = bytes.size();
+  bytes.resize(offset + sizeof(T));
+  std::memcpy(bytes.data() + offset, &value, sizeof(T));
+}
+
+template <typename T>
+void patch(std::vector<uint8_t>& bytes, size_t offset, T value) {
+  std::memcpy(bytes.data() + offset, &value, sizeof(T));
+}
+
+void appendString(std::vector<uint8_t>& bytes, std::string_view string) {
+  append(bytes, static_cast<uint32_t>(string.size()));
+  bytes.insert(bytes.end(), string.begin(), string.end());
+}
+
+} // namespace
+
+void MutationEncoder::resetStrings() {
+  ids_.clear();
+  strings_.clear();
+  stringCount_ = 0;
+  firstStringId_ = 0;
+  resetStrings_ = true;
+}
+
+uint32_t MutationEncoder::intern(std::string_view string) {
+  if (auto it = ids_.find(string); it != ids_.end()) {
+    return it->second;
+  }
+  const auto id = static_cast<uint32_t>(ids_.size());
+  ids_.emplace(string, id);
+  appendString(strings_, string);
+  stringCount_++;
+  return id;
+}
+
+template <typename T>
+void MutationEncoder::put(T value) {
+  append(ops_, value);
+}
+
+void MutationEncoder::putType(ValueType type) {
+  if (!containers_.empty()) {
+    // Map entries are counted by their key
+    auto& container = containers_.back();
+    if (container.isList) {
+      container.count++;
+    }
+  }
+  put(static_cast<uint8_t>(type));
+}
+
+void MutationEncoder::beginOp(OpCode opcode) {
+  assert(containers_.empty() && "Op started before the previous one ended");
+  put(static_cast<uint8_t>(opcode));
+  opOffset_ = ops_.size();
+  put(uint32_t{0});
+}
+
+void MutationEncoder::endOp() {
+  patch(
+      ops_,
+      opOffset_,
+      static_cast<uint32_t>(ops_.size() - opOffset_ - sizeof(uint32_t)));
+  opCount_++;
+}
+
+void MutationEncoder::beginContainer(bool isList) {
+  containers_.push_back({ops_.size(), 0, isList});
+  put(uint32_t{0});
+  put(uint32_t{0});
+}
+
+void MutationEncoder::endContainer() {
+  assert(!containers_.empty() && "Unbalanced container");
+  const auto container = containers_.back();
+  containers_.pop_back();
+  patch(
+      ops_,
+      container.offset,
+      static_cast<uint32_t>(
+          ops_.size() - container.offset - sizeof(uint32_t)));
+  patch(ops_, container.offset + sizeof(uint32_t), container.count);
+}
+
+void MutationEncoder::putStringIds(
+    const std::string_view* strings,
+    size_t count) {
+  put(static_cast<uint32_t>(count));
+  for (size_t i = 0; i < count; i++) {
+    put(intern(strings[i]));
+  }
+}
+
+void MutationEncoder::beginCreateView(
+    int32_t viewId,
+    std::string_view viewType) {
+  beginOp(OpCode::CreateView);
+  put(viewId);
+  put(intern(viewType));
+  beginContainer(false);
+}
+
+void MutationEncoder::beginUpdateView(int32_t viewId) {
+  beginOp(OpCode::UpdateView);
+  put(viewId);
+  beginContainer(false);
+}
+
+void MutationEncoder::endView() {
+  endContainer();
+  endOp();
+}
+
+void MutationEncoder::key(std::string_view key) {
+  assert(!containers_.empty() && "Key written outside of a map");
+  containers_.back().count++;
+  put(intern(key));
+}
+
+void MutationEncoder::writeNull() {
+  putType(ValueType::Null);
+}
+
+void MutationEncoder::writeBool(bool value) {
+  putType(value ? ValueType::True : ValueType::False);
+}
+
+void MutationEncoder::writeInt(int64_t value) {
+  putType(ValueType::Int);
+  put(value);
+}
+
+void MutationEncoder::writeDouble(double value) {
+  putType(ValueType::Double);
+  put(value);
+}
+
+void MutationEncoder::writeString(std::string_view value) {
+  putType(ValueType::String);
+  appendString(ops_, value);
+}
+
+void MutationEncoder::beginList() {
+  putType(ValueType::List);
+  beginContainer(true);
+}
+
+void MutationEncoder::endList() {
+  endContainer();
+}
+
+void MutationEncoder::beginMap() {
+  putType(ValueType::Map);
+  beginContainer(false);
+}
+
+void MutationEncoder::endMap() {
+  endContainer();
+}
+
+void MutationEncoder::deleteView(int32_t viewId) {
+  beginOp(OpCode::DeleteView);
+  put(viewId);
+  endOp();
+}
+
+void MutationEncoder::attachView(
+    int32_t childId,
+    int32_t parentId,
+    int32_t index) {
+  beginOp(OpCode::AttachView);
+  put(childId);
+  put(parentId);
+  put(index);
+  endOp();
+}
+
+void MutationEncoder::detachView(int32_t viewId) {
+  beginOp(OpCode::DetachView);
+  put(viewId);
+  endOp();
+}
+
+void MutationEncoder::setChildren(
+    int32_t viewId,
+    const int32_t* childIds,
+    size_t count) {
+  beginOp(OpCode::SetChildren);
+  put(viewId);
+  put(static_cast<uint32_t>(count));
+  for (size_t i = 0; i < count; i++) {
+    put(childIds[i]);
+  }
+  endOp();
+}
+
+void MutationEncoder::addEventListeners(
+    int32_t viewId,
+    const std::string_view* eventTypes,
+    size_t count) {
+  beginOp(OpCode::AddEventListeners);
+  put(viewId);
+  putStringIds(eventTypes, count);
+  endOp();
+}
+
+void MutationEncoder::removeEventListeners(
+    int32_t viewId,
+    const std::string_view* eventTypes,
+    size_t count) {
+  beginOp(OpCode::RemoveEventListeners);
+  put(viewId);
+  putStringIds(eventTypes, count);
+  endOp();
+}
+
+const std::vector<uint8_t>& MutationEncoder::finish() {
+  assert(containers_.empty() && "Buffer finished inside of an op");
+
+  buffer_.clear();
+  buffer_.reserve(HeaderSize + strings_.size() + ops_.size());
+  append(buffer_, ProtocolMagic);
+  append(buffer_, ProtocolVersion);
+  append(
+      buffer_,
+      static_cast<uint16_t>(
+          resetStrings_ ? HeaderFlags::ResetStrings : HeaderFlags::None));
+  append(buffer_, firstStringId_);
+  append(buffer_, stringCount_);
+  append(buffer_, opCount_);
+  buffer_.insert(buffer_.end(), strings_.begin(), strings_.end());
+  buffer_.insert(buffer_.end(), ops_.begin(), ops_.end());
+
+  firstStringId_ += stringCount_;
+  stringCount_ = 0;
+  strings_.clear();
+  resetStrings_ = false;
+  ops_.clear();
+  opCount_ = 0;
+  return buffer_;
+}
+
+} // namespace dcflight::mutation
@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) Dotcorr Studio. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <dcflight/mutation/MutationProtocol.h>
+
+namespace dcflight::mutation {
+
+/**
+ * Builds mutation buffers. Props are written between beginCreateView() or
+ * beginUpdateView() and endView(), as a sequence of key() followed by a value.
+ * Nested lists and maps are written the same way between begin/end calls,
+ * except that list items take no key.
+ *
+ * An encoder remembers the strings it has interned across buffers, so the
+ * buffers it produces must be decoded in order by a single decoder.
+ */
+class MutationEncoder {
+ public:
+  MutationEncoder() = default;
+
+  // Forgets every interned string. The next buffer asks the decoder to do
+  // the same, e.g. to recover after a buffer failed to decode. Must be called
+  // between buffers.
+  void resetStrings();
+
+  void beginCreateView(int32_t viewId, std::string_view viewType);
+  void beginUpdateView(int32_t viewId);
+  void endView();
+
+  void key(std::string_view key);
+  void writeNull();
+  void writeBool(bool value);
+  void writeInt(int64_t value);
+  void writeDouble(double value);
+  void writeString(std::string_view value);
+  void beginList();
+  void endList();
+  void beginMap();
+  void endMap();
+
+  void deleteView(int32_t viewId);
+  void attachView(int32_t childId, int32_t parentId, int32_t index);
+  void detachView(int32_t viewId);
+  void setChildren(int32_t viewId, const int32_t* childIds, size_t count);
+  void addEventListeners(
+      int32_t viewId,
+      const std::string_view* eventTypes,
+      size_t count);
+  void removeEventListeners(
+      int32_t viewId,
+      const std::string_view* eventTypes,
+      size_t count);
+
+  size_t getOpCount() const {
+    return opCount_;
+  }
+
+  // Returns the buffer holding every op written since the last call, and
+  // starts a new one. The buffer is valid until the next call to finish().
+  const std::vector<uint8_t>& finish();
+
+ private:
+  struct Container {
+    size_t offset;
+    uint32_t count;
+    bool isList;
+  };
+
+  uint32_t intern(std::string_view string);
+
+  template <typename T>
+  void put(T value);
+  void putType(ValueType type);
+  void beginOp(OpCode opcode);
+  void endOp();
+  void beginContainer(bool isList);
+  void endContainer();
+  void putStringIds(const std::string_view* strings, size_t count);
+
+  std::map<std::string, uint32_t, std::less<>> ids_;
+  uint32_t firstStringId_ = 0;
+  bool resetStrings_ = true;
+  std::vector<uint8_t> strings_;
+  uint32_t stringCount_ = 0;
+
+  std::vector<uint8_t> ops_;
+  uint32_t opCount_ = 0;
+  size_t opOffset_ = 0;
+  std::vector<Container> containers_;
+
+  std::vector<uint8_t> buffer_;
+};
+
+} // namespace dcflight::mutation
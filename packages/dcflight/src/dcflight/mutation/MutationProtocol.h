@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) Dotcorr Studio. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Binary mutation protocol used to commit a batch of view tree mutations from
+ * Dart to the native side in a single buffer.
+ *
+ * All integers are little-endian and unaligned. A buffer is laid out as:
+ *
+ *   Header
+ *     u32 magic          'DCFM'
+ *     u16 version        ProtocolVersion
+ *     u16 flags          HeaderFlags
+ *     u32 firstStringId  id of the first string defined by this buffer
+ *     u32 stringCount    number of strings defined by this buffer
+ *     u32 opCount        number of ops following the string section
+ *
+ *   String section, stringCount times
+ *     u32 length, followed by length bytes of UTF-8
+ *
+ *   Ops, opCount times
+ *     u8  opcode         OpCode
+ *     u32 length         byte length of the payload
+ *     payload
+ *
+ * View types, prop keys and event types are interned: a buffer defines the
+ * strings it introduces once, and every later reference (in the same buffer
+ * or in any later buffer) is a u32 id. The table lives for the lifetime of a
+ * session and is only cleared by a buffer with HeaderFlags::ResetStrings set,
+ * so an encoder and decoder stay in sync as long as every buffer is decoded
+ * in the order it was encoded. firstStringId lets the decoder detect when
+ * that is not the case.
+ *
+ * Payloads by opcode:
+ *
+ *   CreateView            i32 viewId, u32 viewTypeId, Map props
+ *   UpdateView            i32 viewId, Map props
+ *   DeleteView            i32 viewId
+ *   AttachView            i32 childId, i32 parentId, i32 index
+ *   DetachView            i32 viewId
+ *   SetChildren           i32 viewId, u32 count, i32 childIds[count]
+ *   AddEventListeners     i32 viewId, u32 count, u32 eventTypeIds[count]
+ *   RemoveEventListeners  i32 viewId, u32 count, u32 eventTypeIds[count]
+ *
+ * Ops with an opcode the decoder does not know are skipped using their length,
+ * so new ops can be added without bumping the version.
+ *
+ * Values are a u8 ValueType followed by:
+ *
+ *   Null, False, True     nothing
+ *   Int                   i64
+ *   Double                f64
+ *   String                u32 length, followed by length bytes of UTF-8
+ *   List                  u32 byteLength, u32 count, Value items[count]
+ *   Map                   u32 byteLength, u32 count, {u32 keyId, Value}[count]
+ *
+ * byteLength covers everything after itself, so nested containers can be
+ * skipped without being decoded. Props are a Map without its ValueType tag.
+ */
+
+namespace dcflight::mutation {
+
+inline constexpr uint32_t ProtocolMagic = 0x4d464344; // 'DCFM'
+inline constexpr uint16_t ProtocolVersion = 1;
+
+inline constexpr size_t HeaderSize = 20;
+inline constexpr size_t OpHeaderSize = 5;
+
+// Containers nested deeper than this are rejected as malformed
+inline constexpr size_t MaxValueDepth = 64;
+
+enum class HeaderFlags : uint16_t {
+  None = 0,
+  // Clear the string table before applying the string section
+  ResetStrings = 1 << 0,
+};
+
+enum class OpCode : uint8_t {
+  CreateView = 1,
+  UpdateView = 2,
+  DeleteView = 3,
+  AttachView = 4,
+  DetachView = 5,
+  SetChildren = 6,
+  AddEventListeners = 7,
+  RemoveEventListeners = 8,
+};
+
+enum class ValueType : uint8_t {
+  Null = 0,
+  False = 1,
+  True = 2,
+  Int = 3,
+  Double = 4,
+  String = 5,
+  List = 6,
+  Map = 7,
+};
+
+} // namespace dcflight::mutation
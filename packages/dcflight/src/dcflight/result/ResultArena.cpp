@@ -0,0 +1,49 @@
+/*
+ * Copyright (c) Dotcorr Studio. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <algorithm>
+#include <cstring>
+
+#include <dcflight/result/ResultArena.h>
+
+namespace dcflight::result {
+
+ResultArena::ResultArena(size_t chunkSize) : chunkSize_(chunkSize) {}
+
+uint8_t* ResultArena::allocate(size_t length) {
+  // Chunks too full for the result are left for the next release
+  for (; current_ < chunks_.size(); current_++, offset_ = 0) {
+    Chunk& chunk = chunks_[current_];
+    if (chunk.size - offset_ >= length) {
+      uint8_t* bytes = chunk.bytes.get() + offset_;
+      offset_ += length;
+      return bytes;
+    }
+  }
+
+  const size_t size = std::max(chunkSize_, length);
+  chunks_.push_back({std::make_unique<uint8_t[]>(size), size});
+  offset_ = length;
+  return chunks_.back().bytes.get();
+}
+
+ResultSlice ResultArena::copy(const uint8_t* bytes, size_t length) {
+  uint8_t* data = allocate(length);
+  if (length > 0) {
+    std::memcpy(data, bytes, length);
+  }
+  usedBytes_ += length;
+  return {data, static_cast<uint32_t>(length)};
+}
+
+void ResultArena::releaseAll() {
+  current_ = 0;
+  offset_ = 0;
+  usedBytes_ = 0;
+}
+
+} // namespace dcflight::result
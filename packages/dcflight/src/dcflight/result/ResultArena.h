@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) Dotcorr Studio. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <dcflight/result/ResultProtocol.h>
+
+namespace dcflight::result {
+
+/**
+ * Holds the results returned to a caller until it releases them all at once,
+ * so that a result of any size is returned without the caller guessing the
+ * size of a buffer, and read in place.
+ *
+ * Results are copied into chunks which are never moved nor freed, so a
+ * result keeps its address until releaseAll(). Released chunks are reused,
+ * so a caller releasing its results after reading them stops allocating once
+ * the chunks hold the results it reads between two releases. A result larger
+ * than a chunk gets a chunk of its own.
+ *
+ * An arena must only be used from one thread at a time.
+ */
+class ResultArena {
+ public:
+  explicit ResultArena(size_t chunkSize = 16 * 1024);
+
+  ResultArena(const ResultArena&) = delete;
+  ResultArena& operator=(const ResultArena&) = delete;
+
+  // Copies a result into the arena
+  ResultSlice copy(const uint8_t* bytes, size_t length);
+
+  // Releases every result, keeping the chunks to hold the next ones
+  void releaseAll();
+
+  // Number of bytes held by the results not released yet
+  size_t getUsedBytes() const {
+    return usedBytes_;
+  }
+
+  size_t getChunkCount() const {
+    return chunks_.size();
+  }
+
+ private:
+  struct Chunk {
+    std::unique_ptr<uint8_t[]> bytes;
+    size_t size;
+  };
+
+  uint8_t* allocate(size_t length);
+
+  size_t chunkSize_;
+  std::vector<Chunk> chunks_;
+  // The chunk results are copied to, and the offset of its free space
+  size_t current_ = 0;
+  size_t offset_ = 0;
+  size_t usedBytes_ = 0;
+};
+
+} // namespace dcflight::result
@@ -0,0 +1,39 @@
+/*
+ * Copyright (c) Dotcorr Studio. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#include <dcflight/mutation/MutationProtocol.h>
+
+/**
+ * Binary encoding of the results native code returns to Dart, such as the
+ * result of a tunnel method or the screen dimensions, in place of JSON.
+ *
+ * A result is a single Value, encoded as in MutationProtocol.h but for map
+ * keys: a result is read once, so its keys are not interned but written in
+ * place as a u32 length followed by length bytes of UTF-8.
+ *
+ *   Map                   u32 byteLength, u32 count,
+ *                         {u32 keyLength, u8 key[keyLength], Value}[count]
+ *
+ * Results are written into a ResultArena owned by native code, and read by
+ * Dart in place from the pointer and length it is given.
+ */
+
+namespace dcflight::result {
+
+using mutation::ValueType;
+
+// A result in a ResultArena, valid until the arena releases it
+struct ResultSlice {
+  const uint8_t* data = nullptr;
+  uint32_t length = 0;
+};
+
+} // namespace dcflight::result
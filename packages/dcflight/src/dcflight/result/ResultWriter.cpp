@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) Dotcorr Studio. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <bit>
+#include <cassert>
+#include <cstring>
+
+#include <dcflight/result/ResultWriter.h>
+
+static_assert(
+    std::endian::native == std::endian::little,
+    "Results are written in host byte order");
+
+namespace dcflight::result {
+
+namespace {
+
+template <typename T>
+void patch(std::vector<uint8_t>& bytes, size_t offset, T value) {
+  std::memcpy(bytes.data() + offset, &value, sizeof(T));
+}
+
+} // namespace
+
+template <typename T>
+void ResultWriter::put(T value) {
+  const auto* bytes = reinterpret_cast<const uint8_t*>(&value);
+  bytes_.insert(bytes_.end(), bytes, bytes + sizeof(T));
+}
+
+void ResultWriter::putType(ValueType type) {
+  if (!containers_.empty()) {
+    // Map entries are counted by their key
+    auto& container = containers_.back();
+    if (container.isList) {
+      container.count++;
+    }
+  }
+  put(static_cast<uint8_t>(type));
+}
+
+void ResultWriter::beginContainer(bool isList) {
+  containers_.push_back({bytes_.size(), 0, isList});
+  put(uint32_t{0});
+  put(uint32_t{0});
+}
+
+void ResultWriter::endContainer() {
+  assert(!containers_.empty() && "Unbalanced container");
+  const auto container = containers_.back();
+  containers_.pop_back();
+  patch(
+      bytes_,
+      container.offset,
+      static_cast<uint32_t>(
+          bytes_.size() - container.offset - sizeof(uint32_t)));
+  patch(bytes_, container.offset + sizeof(uint32_t), container.count);
+}
+
+void ResultWriter::key(std::string_view key) {
+  assert(!containers_.empty() && "Key written outside of a map");
+  containers_.back().count++;
+  put(static_cast<uint32_t>(key.size()));
+  bytes_.insert(bytes_.end(), key.begin(), key.end());
+}
+
+void ResultWriter::writeNull() {
+  putType(ValueType::Null);
+}
+
+void ResultWriter::writeBool(bool value) {
+  putType(value ? ValueType::True : ValueType::False);
+}
+
+void ResultWriter::writeInt(int64_t value) {
+  putType(ValueType::Int);
+  put(value);
+}
+
+void ResultWriter::writeDouble(double value) {
+  putType(ValueType::Double);
+  put(value);
+}
+
+void ResultWriter::writeString(std::string_view value) {
+  putType(ValueType::String);
+  put(static_cast<uint32_t>(value.size()));
+  bytes_.insert(bytes_.end(), value.begin(), value.end());
+}
+
+void ResultWriter::beginList() {
+  putType(ValueType::List);
+  beginContainer(true);
+}
+
+void ResultWriter::endList() {
+  endContainer();
+}
+
+void ResultWriter::beginMap() {
+  putType(ValueType::Map);
+  beginContainer(false);
+}
+
+void ResultWriter::endMap() {
+  endContainer();
+}
+
+ResultSlice ResultWriter::finish(ResultArena& arena) {
+  assert(containers_.empty() && "Result finished inside of a container");
+  const ResultSlice slice = arena.copy(bytes_.data(), bytes_.size());
+  bytes_.clear();
+  return slice;
+}
+
+void ResultWriter::reset() {
+  bytes_.clear();
+  containers_.clear();
+}
+
+} // namespace dcflight::result
@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) Dotcorr Studio. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#include <dcflight/result/ResultArena.h>
+#include <dcflight/result/ResultProtocol.h>
+
+namespace dcflight::result {
+
+/**
+ * Builds a result (see ResultProtocol.h): a single value, written the same
+ * way as the props of a MutationEncoder. Map entries are a key() followed by
+ * a value, and list items take no key.
+ *
+ * The writer keeps its buffer across results, so that writing stops
+ * allocating once it has held the largest one.
+ */
+class ResultWriter {
+ public:
+  ResultWriter() = default;
+
+  void key(std::string_view key);
+  void writeNull();
+  void writeBool(bool value);
+  void writeInt(int64_t value);
+  void writeDouble(double value);
+  void writeString(std::string_view value);
+  void beginList();
+  void endList();
+  void beginMap();
+  void endMap();
+
+  // Copies the value written since the last call into `arena`, and starts a
+  // new one
+  ResultSlice finish(ResultArena& arena);
+
+  // Drops the value being written, e.g. after part of it failed to convert
+  void reset();
+
+ private:
+  struct Container {
+    size_t offset;
+    uint32_t count;
+    bool isList;
+  };
+
+  template <typename T>
+  void put(T value);
+  void putType(ValueType type);
+  void beginContainer(bool isList);
+  void endContainer();
+
+  std::vector<uint8_t> bytes_;
+  std::vector<Container> containers_;
+};
+
+} // namespace dcflight::result
@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) Dotcorr Studio. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <algorithm>
+#include <cstring>
+
+#include <dcflight/shadow/ChildrenDiff.h>
+
+namespace dcflight::shadow {
+
+bool ChildrenDiff::diff(
+    const int32_t* oldIds,
+    size_t oldCount,
+    const int32_t* newIds,
+    size_t newCount) {
+  removals_.clear();
+  insertions_.clear();
+  // Most updates leave the children as they were
+  if (oldCount == newCount &&
+      (oldCount == 0 ||
+       std::memcmp(oldIds, newIds, oldCount * sizeof(int32_t)) == 0)) {
+    return true;
+  }
+
+  positions_.clear();
+  positions_.reserve(newCount);
+  for (size_t i = 0; i < newCount; i++) {
+    if (!positions_.emplace(newIds[i], static_cast<uint32_t>(i)).second) {
+      return false;
+    }
+  }
+
+  isKept_.assign(newCount, 0);
+  newIndices_.resize(oldCount);
+  for (size_t i = 0; i < oldCount; i++) {
+    const auto position = positions_.find(oldIds[i]);
+    if (position == positions_.end()) {
+      newIndices_[i] = kNone;
+      continue;
+    }
+    // Flags the new children found so far, to catch an old duplicate
+    if (isKept_[position->second] != 0) {
+      return false;
+    }
+    isKept_[position->second] = 1;
+    newIndices_[i] = position->second;
+  }
+
+  isKept_.assign(newCount, 0);
+  markLongestIncreasingRun();
+
+  for (size_t i = oldCount; i-- > 0;) {
+    if (newIndices_[i] == kNone || isKept_[newIndices_[i]] == 0) {
+      removals_.push_back(static_cast<uint32_t>(i));
+    }
+  }
+  for (size_t i = 0; i < newCount; i++) {
+    if (isKept_[i] == 0) {
+      insertions_.push_back(static_cast<uint32_t>(i));
+    }
+  }
+  return true;
+}
+
+void ChildrenDiff::markLongestIncreasingRun() {
+  tails_.clear();
+  previous_.resize(newIndices_.size());
+  for (size_t i = 0; i < newIndices_.size(); i++) {
+    const uint32_t index = newIndices_[i];
+    if (index == kNone) {
+      continue;
+    }
+    // The first run whose tail does not come before this child in the new
+    // list, which this child ends instead
+    const auto tail = std::lower_bound(
+        tails_.begin(), tails_.end(), index, [&](uint32_t run, uint32_t value) {
+          return newIndices_[run] < value;
+        });
+    previous_[i] = tail == tails_.begin() ? kNone : *(tail - 1);
+    if (tail == tails_.end()) {
+      tails_.push_back(static_cast<uint32_t>(i));
+    } else {
+      *tail = static_cast<uint32_t>(i);
+    }
+  }
+
+  for (uint32_t i = tails_.empty() ? kNone : tails_.back(); i != kNone;
+       i = previous_[i]) {
+    isKept_[newIndices_[i]] = 1;
+  }
+}
+
+} // namespace dcflight::shadow
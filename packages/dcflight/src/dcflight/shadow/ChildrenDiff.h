@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) Dotcorr Studio. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace dcflight::shadow {
+
+/**
+ * Computes the fewest removals and insertions turning the children of a view
+ * into a new list of children, identified by their view id, so that a
+ * reorder only moves the children which changed place.
+ *
+ * The children kept in place are the longest subsequence of the old list
+ * found in the same order in the new one (a longest increasing subsequence
+ * of their new indices, found in O(n log n)). Every other old child is
+ * removed, and every other new child, added or moved, is inserted.
+ *
+ * The removals, applied first from the last to the first, and the
+ * insertions, applied from the first to the last, index into the list as it
+ * is when applying each of them: removing oldIds[i] at index i, and
+ * inserting newIds[i] at index i.
+ *
+ * Reusing a diff reuses its storage, so that diffing frame after frame stops
+ * allocating.
+ */
+class ChildrenDiff {
+ public:
+  /**
+   * Diffs two lists of children.
+   *
+   * @returns false, with no removals or insertions, if either list has a view
+   * id more than once, in which case the children should be replaced at once
+   */
+  bool diff(
+      const int32_t* oldIds,
+      size_t oldCount,
+      const int32_t* newIds,
+      size_t newCount);
+
+  // The indices in the old list of the children to remove, decreasing
+  const std::vector<uint32_t>& getRemovals() const {
+    return removals_;
+  }
+
+  // The indices in the new list of the children to insert, increasing
+  const std::vector<uint32_t>& getInsertions() const {
+    return insertions_;
+  }
+
+ private:
+  static constexpr uint32_t kNone = UINT32_MAX;
+
+  // Marks the children of `newIndices_` left in place in `isKept_`
+  void markLongestIncreasingRun();
+
+  std::vector<uint32_t> removals_;
+  std::vector<uint32_t> insertions_;
+
+  // The index in the new list of every new child
+  std::unordered_map<int32_t, uint32_t> positions_;
+  // The index in the new list of every old child, or kNone
+  std::vector<uint32_t> newIndices_;
+  // Whether every new child is left in place
+  std::vector<uint8_t> isKept_;
+  // The longest increasing runs ending on a child of `newIndices_`: the
+  // child ending the shortest one of each length, and the one before each
+  std::vector<uint32_t> tails_;
+  std::vector<uint32_t> previous_;
+};
+
+} // namespace dcflight::shadow
@@ -0,0 +1,392 @@
+/*
+ * Copyright (c) Dotcorr Studio. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <dcflight/shadow/LayoutProps.h>
+
+namespace dcflight::shadow {
+
+namespace {
+
+struct PropName {
+  std::string_view key;
+  LayoutProp prop;
+};
+
+constexpr PropName kPropNames[] = {
+    {"width", LayoutProp::Width},
+    {"height", LayoutProp::Height},
+    {"minWidth", LayoutProp::MinWidth},
+    {"minHeight", LayoutProp::MinHeight},
+    {"maxWidth", LayoutProp::MaxWidth},
+    {"maxHeight", LayoutProp::MaxHeight},
+    {"aspectRatio", LayoutProp::AspectRatio},
+    {"flex", LayoutProp::Flex},
+    {"flexGrow", LayoutProp::FlexGrow},
+    {"flexShrink", LayoutProp::FlexShrink},
+    {"flexBasis", LayoutProp::FlexBasis},
+    {"flexDirection", LayoutProp::FlexDirection},
+    {"flexWrap", LayoutProp::FlexWrap},
+    {"justifyContent", LayoutProp::JustifyContent},
+    {"alignItems", LayoutProp::AlignItems},
+    {"alignSelf", LayoutProp::AlignSelf},
+    {"alignContent", LayoutProp::AlignContent},
+    {"direction", LayoutProp::Direction},
+    {"display", LayoutProp::Display},
+    {"overflow", LayoutProp::Overflow},
+    {"position", LayoutProp::PositionType},
+    {"left", LayoutProp::Left},
+    {"top", LayoutProp::Top},
+    {"right", LayoutProp::Right},
+    {"bottom", LayoutProp::Bottom},
+    {"margin", LayoutProp::Margin},
+    {"marginHorizontal", LayoutProp::MarginHorizontal},
+    {"marginVertical", LayoutProp::MarginVertical},
+    {"marginLeft", LayoutProp::MarginLeft},
+    {"marginTop", LayoutProp::MarginTop},
+    {"marginRight", LayoutProp::MarginRight},
+    {"marginBottom", LayoutProp::MarginBottom},
+    {"padding", LayoutProp::Padding},
+    {"paddingHorizontal", LayoutProp::PaddingHorizontal},
+    {"paddingVertical", LayoutProp::PaddingVertical},
+    {"paddingLeft", LayoutProp::PaddingLeft},
+    {"paddingTop", LayoutProp::PaddingTop},
+    {"paddingRight", LayoutProp::PaddingRight},
+    {"paddingBottom", LayoutProp::PaddingBottom},
+    {"borderWidth", LayoutProp::BorderWidth},
+    {"borderLeftWidth", LayoutProp::BorderLeftWidth},
+    {"borderTopWidth", LayoutProp::BorderTopWidth},
+    {"borderRightWidth", LayoutProp::BorderRightWidth},
+    {"borderBottomWidth", LayoutProp::BorderBottomWidth},
+    {"gap", LayoutProp::Gap},
+    {"rowGap", LayoutProp::RowGap},
+    {"columnGap", LayoutProp::ColumnGap},
+};
+
+struct Keyword {
+  std::string_view name;
+  int value;
+};
+
+constexpr Keyword kFlexDirections[] = {
+    {"column", YGFlexDirectionColumn},
+    {"columnReverse", YGFlexDirectionColumnReverse},
+    {"row", YGFlexDirectionRow},
+    {"rowReverse", YGFlexDirectionRowReverse},
+};
+
+constexpr Keyword kWraps[] = {
+    {"nowrap", YGWrapNoWrap},
+    {"wrap", YGWrapWrap},
+    {"wrapReverse", YGWrapWrapReverse},
+};
+
+constexpr Keyword kJustifies[] = {
+    {"flexStart", YGJustifyFlexStart},
+    {"center", YGJustifyCenter},
+    {"flexEnd", YGJustifyFlexEnd},
+    {"spaceBetween", YGJustifySpaceBetween},
+    {"spaceAround", YGJustifySpaceAround},
+    {"spaceEvenly", YGJustifySpaceEvenly},
+};
+
+constexpr Keyword kAligns[] = {
+    {"auto", YGAlignAuto},
+    {"flexStart", YGAlignFlexStart},
+    {"center", YGAlignCenter},
+    {"flexEnd", YGAlignFlexEnd},
+    {"stretch", YGAlignStretch},
+    {"baseline", YGAlignBaseline},
+    {"spaceBetween", YGAlignSpaceBetween},
+    {"spaceAround", YGAlignSpaceAround},
+    {"spaceEvenly", YGAlignSpaceEvenly},
+};
+
+constexpr Keyword kDirections[] = {
+    {"inherit", YGDirectionInherit},
+    {"ltr", YGDirectionLTR},
+    {"rtl", YGDirectionRTL},
+};
+
+constexpr Keyword kDisplays[] = {
+    {"flex", YGDisplayFlex},
+    {"none", YGDisplayNone},
+};
+
+constexpr Keyword kOverflows[] = {
+    {"visible", YGOverflowVisible},
+    {"hidden", YGOverflowHidden},
+    {"scroll", YGOverflowScroll},
+};
+
+constexpr Keyword kPositionTypes[] = {
+    {"static", YGPositionTypeStatic},
+    {"relative", YGPositionTypeRelative},
+    {"absolute", YGPositionTypeAbsolute},
+};
+
+template <size_t N>
+std::optional<int> findKeyword(
+    const Keyword (&keywords)[N],
+    std::string_view name) {
+  for (const auto& keyword : keywords) {
+    if (keyword.name == name) {
+      return keyword.value;
+    }
+  }
+  return std::nullopt;
+}
+
+YGStyleUpdate makeUpdate(
+    YGStyleProperty property,
+    int index,
+    YGUnit unit,
+    float value) {
+  return {
+      static_cast<uint16_t>(property),
+      static_cast<uint8_t>(index),
+      static_cast<uint8_t>(unit),
+      value};
+}
+
+std::optional<YGStyleUpdate> keyword(
+    YGStyleProperty property,
+    const LayoutValue& value,
+    int last) {
+  const auto ordinal = static_cast<int>(value.value);
+  if (!(value.value >= 0) || ordinal > last) {
+    return std::nullopt;
+  }
+  return makeUpdate(
+      property, 0, YGUnitUndefined, static_cast<float>(ordinal));
+}
+
+// A float style which is either a number or undefined
+std::optional<YGStyleUpdate> number(
+    YGStyleProperty property,
+    const LayoutValue& value) {
+  switch (value.unit) {
+    case LayoutUnit::Undefined:
+      return makeUpdate(property, 0, YGUnitUndefined, YGUndefined);
+    case LayoutUnit::Point:
+      return makeUpdate(property, 0, YGUnitUndefined, value.value);
+    default:
+      return std::nullopt;
+  }
+}
+
+// A length on `index`, the edge or gutter of the style if it has one
+std::optional<YGStyleUpdate> length(
+    YGStyleProperty property,
+    const LayoutValue& value,
+    int index,
+    bool allowsPercent,
+    bool allowsAuto) {
+  switch (value.unit) {
+    case LayoutUnit::Undefined:
+      return makeUpdate(property, index, YGUnitUndefined, YGUndefined);
+    case LayoutUnit::Point:
+      return makeUpdate(property, index, YGUnitPoint, value.value);
+    case LayoutUnit::Percent:
+      if (!allowsPercent) {
+        return std::nullopt;
+      }
+      return makeUpdate(property, index, YGUnitPercent, value.value);
+    case LayoutUnit::Auto:
+      if (!allowsAuto) {
+        return std::nullopt;
+      }
+      return makeUpdate(property, index, YGUnitAuto, YGUndefined);
+  }
+  return std::nullopt;
+}
+
+std::optional<YGStyleUpdate> margin(const LayoutValue& value, YGEdge edge) {
+  return length(YGStylePropertyMargin, value, edge, true, true);
+}
+
+std::optional<YGStyleUpdate> padding(const LayoutValue& value, YGEdge edge) {
+  return length(YGStylePropertyPadding, value, edge, true, false);
+}
+
+std::optional<YGStyleUpdate> position(const LayoutValue& value, YGEdge edge) {
+  return length(YGStylePropertyPosition, value, edge, true, false);
+}
+
+std::optional<YGStyleUpdate> border(const LayoutValue& value, YGEdge edge) {
+  return length(YGStylePropertyBorder, value, edge, false, false);
+}
+
+std::optional<YGStyleUpdate> gap(const LayoutValue& value, YGGutter gutter) {
+  return length(YGStylePropertyGap, value, gutter, false, false);
+}
+
+} // namespace
+
+std::optional<LayoutProp> lookupLayoutProp(std::string_view key) {
+  for (const auto& name : kPropNames) {
+    if (name.key == key) {
+      return name.prop;
+    }
+  }
+  return std::nullopt;
+}
+
+bool isLayoutOnlyProp(std::string_view key) {
+  const auto prop = lookupLayoutProp(key);
+  if (!prop) {
+    return false;
+  }
+  switch (*prop) {
+    // Borders are drawn, in a default color when none is set
+    case LayoutProp::BorderWidth:
+    case LayoutProp::BorderLeftWidth:
+    case LayoutProp::BorderTopWidth:
+    case LayoutProp::BorderRightWidth:
+    case LayoutProp::BorderBottomWidth:
+      return false;
+    default:
+      return true;
+  }
+}
+
+std::optional<int> lookupLayoutKeyword(
+    LayoutProp prop,
+    std::string_view keyword) {
+  switch (prop) {
+    case LayoutProp::FlexDirection:
+      return findKeyword(kFlexDirections, keyword);
+    case LayoutProp::FlexWrap:
+      return findKeyword(kWraps, keyword);
+    case LayoutProp::JustifyContent:
+      return findKeyword(kJustifies, keyword);
+    case LayoutProp::AlignItems:
+    case LayoutProp::AlignSelf:
+    case LayoutProp::AlignContent:
+      return findKeyword(kAligns, keyword);
+    case LayoutProp::Direction:
+      return findKeyword(kDirections, keyword);
+    case LayoutProp::Display:
+      return findKeyword(kDisplays, keyword);
+    case LayoutProp::Overflow:
+      return findKeyword(kOverflows, keyword);
+    case LayoutProp::PositionType:
+      return findKeyword(kPositionTypes, keyword);
+    default:
+      return std::nullopt;
+  }
+}
+
+std::optional<YGStyleUpdate> toStyleUpdate(const LayoutValue& value) {
+  switch (value.prop) {
+    case LayoutProp::Width:
+      return length(YGStylePropertyWidth, value, 0, true, true);
+    case LayoutProp::Height:
+      return length(YGStylePropertyHeight, value, 0, true, true);
+    case LayoutProp::MinWidth:
+      return length(YGStylePropertyMinWidth, value, 0, true, false);
+    case LayoutProp::MinHeight:
+      return length(YGStylePropertyMinHeight, value, 0, true, false);
+    case LayoutProp::MaxWidth:
+      return length(YGStylePropertyMaxWidth, value, 0, true, false);
+    case LayoutProp::MaxHeight:
+      return length(YGStylePropertyMaxHeight, value, 0, true, false);
+    case LayoutProp::AspectRatio:
+      return number(YGStylePropertyAspectRatio, value);
+
+    case LayoutProp::Flex:
+      return number(YGStylePropertyFlex, value);
+    case LayoutProp::FlexGrow:
+      return number(YGStylePropertyFlexGrow, value);
+    case LayoutProp::FlexShrink:
+      return number(YGStylePropertyFlexShrink, value);
+    case LayoutProp::FlexBasis:
+      return length(YGStylePropertyFlexBasis, value, 0, true, true);
+    case LayoutProp::FlexDirection:
+      return keyword(
+          YGStylePropertyFlexDirection, value, YGFlexDirectionRowReverse);
+    case LayoutProp::FlexWrap:
+      return keyword(YGStylePropertyFlexWrap, value, YGWrapWrapReverse);
+    case LayoutProp::JustifyContent:
+      return keyword(
+          YGStylePropertyJustifyContent, value, YGJustifySpaceEvenly);
+    case LayoutProp::AlignItems:
+      return keyword(YGStylePropertyAlignItems, value, YGAlignSpaceEvenly);
+    case LayoutProp::AlignSelf:
+      return keyword(YGStylePropertyAlignSelf, value, YGAlignSpaceEvenly);
+    case LayoutProp::AlignContent:
+      return keyword(YGStylePropertyAlignContent, value, YGAlignSpaceEvenly);
+    case LayoutProp::Direction:
+      return keyword(YGStylePropertyDirection, value, YGDirectionRTL);
+    case LayoutProp::Display:
+      return keyword(YGStylePropertyDisplay, value, YGDisplayNone);
+    case LayoutProp::Overflow:
+      return keyword(YGStylePropertyOverflow, value, YGOverflowScroll);
+
+    case LayoutProp::PositionType:
+      return keyword(
+          YGStylePropertyPositionType, value, YGPositionTypeAbsolute);
+    case LayoutProp::Left:
+      return position(value, YGEdgeLeft);
+    case LayoutProp::Top:
+      return position(value, YGEdgeTop);
+    case LayoutProp::Right:
+      return position(value, YGEdgeRight);
+    case LayoutProp::Bottom:
+      return position(value, YGEdgeBottom);
+
+    case LayoutProp::Margin:
+      return margin(value, YGEdgeAll);
+    case LayoutProp::MarginHorizontal:
+      return margin(value, YGEdgeHorizontal);
+    case LayoutProp::MarginVertical:
+      return margin(value, YGEdgeVertical);
+    case LayoutProp::MarginLeft:
+      return margin(value, YGEdgeLeft);
+    case LayoutProp::MarginTop:
+      return margin(value, YGEdgeTop);
+    case LayoutProp::MarginRight:
+      return margin(value, YGEdgeRight);
+    case LayoutProp::MarginBottom:
+      return margin(value, YGEdgeBottom);
+
+    case LayoutProp::Padding:
+      return padding(value, YGEdgeAll);
+    case LayoutProp::PaddingHorizontal:
+      return padding(value, YGEdgeHorizontal);
+    case LayoutProp::PaddingVertical:
+      return padding(value, YGEdgeVertical);
+    case LayoutProp::PaddingLeft:
+      return padding(value, YGEdgeLeft);
+    case LayoutProp::PaddingTop:
+      return padding(value, YGEdgeTop);
+    case LayoutProp::PaddingRight:
+      return padding(value, YGEdgeRight);
+    case LayoutProp::PaddingBottom:
+      return padding(value, YGEdgeBottom);
+
+    case LayoutProp::BorderWidth:
+      return border(value, YGEdgeAll);
+    case LayoutProp::BorderLeftWidth:
+      return border(value, YGEdgeLeft);
+    case LayoutProp::BorderTopWidth:
+      return border(value, YGEdgeTop);
+    case LayoutProp::BorderRightWidth:
+      return border(value, YGEdgeRight);
+    case LayoutProp::BorderBottomWidth:
+      return border(value, YGEdgeBottom);
+
+    case LayoutProp::Gap:
+      return gap(value, YGGutterAll);
+    case LayoutProp::RowGap:
+      return gap(value, YGGutterRow);
+    case LayoutProp::ColumnGap:
+      return gap(value, YGGutterColumn);
+  }
+  return std::nullopt;
+}
+
+} // namespace dcflight::shadow
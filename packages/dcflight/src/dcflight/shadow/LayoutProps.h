@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) Dotcorr Studio. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+#include <yoga/Yoga.h>
+
+namespace dcflight::shadow {
+
+/**
+ * Layout props understood by the shadow tree, named after the component prop
+ * they are read from. Edge props map to the Yoga edge of the same name, so
+ * that Yoga resolves e.g. marginTop over marginVertical over margin.
+ */
+enum class LayoutProp : uint16_t {
+  Width,
+  Height,
+  MinWidth,
+  MinHeight,
+  MaxWidth,
+  MaxHeight,
+  AspectRatio,
+
+  Flex,
+  FlexGrow,
+  FlexShrink,
+  FlexBasis,
+  FlexDirection,
+  FlexWrap,
+  JustifyContent,
+  AlignItems,
+  AlignSelf,
+  AlignContent,
+  Direction,
+  Display,
+  Overflow,
+
+  // The "position" prop
+  PositionType,
+  Left,
+  Top,
+  Right,
+  Bottom,
+
+  Margin,
+  MarginHorizontal,
+  MarginVertical,
+  MarginLeft,
+  MarginTop,
+  MarginRight,
+  MarginBottom,
+
+  Padding,
+  PaddingHorizontal,
+  PaddingVertical,
+  PaddingLeft,
+  PaddingTop,
+  PaddingRight,
+  PaddingBottom,
+
+  BorderWidth,
+  BorderLeftWidth,
+  BorderTopWidth,
+  BorderRightWidth,
+  BorderBottomWidth,
+
+  Gap,
+  RowGap,
+  ColumnGap,
+};
+
+constexpr uint16_t LayoutPropCount =
+    static_cast<uint16_t>(LayoutProp::ColumnGap) + 1;
+
+// Same values as YGUnit
+enum class LayoutUnit : uint16_t {
+  Undefined = YGUnitUndefined,
+  Point = YGUnitPoint,
+  Percent = YGUnitPercent,
+  Auto = YGUnitAuto,
+};
+
+/**
+ * One layout prop to apply. Keyword props (e.g. FlexDirection) hold the value
+ * of the Yoga enum in `value` and ignore `unit`. Props which do not support a
+ * unit, e.g. a percentage border, are rejected.
+ */
+struct LayoutValue {
+  LayoutProp prop;
+  LayoutUnit unit;
+  float value;
+};
+
+// Returns the layout prop read from the component prop `key`, if any
+std::optional<LayoutProp> lookupLayoutProp(std::string_view key);
+
+// Whether the component prop `key` only affects layout, so that a view
+// whose props all do draws nothing (see ShadowTree::setLayoutOnly()). Overflow
+// is, as the tree checks whether a view clips from its style.
+bool isLayoutOnlyProp(std::string_view key);
+
+// Returns the value of the Yoga enum named `keyword` for a keyword prop, e.g.
+// YGJustifySpaceBetween for (JustifyContent, "spaceBetween")
+std::optional<int> lookupLayoutKeyword(
+    LayoutProp prop,
+    std::string_view keyword);
+
+/**
+ * Returns the Yoga style update applying `value`, for
+ * YGNodeStyleApplyUpdates(), or nothing if the prop does not support its unit
+ * or keyword.
+ */
+std::optional<YGStyleUpdate> toStyleUpdate(const LayoutValue& value);
+
+} // namespace dcflight::shadow
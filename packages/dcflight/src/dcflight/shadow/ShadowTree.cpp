@@ -0,0 +1,670 @@
+/*
+ * Copyright (c) Dotcorr Studio. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+#include <dcflight/shadow/ShadowTree.h>
+
+namespace dcflight::shadow {
+
+namespace {
+
+// The context of every Yoga node is its view id
+void* toContext(int32_t viewId) {
+  return reinterpret_cast<void*>(static_cast<intptr_t>(viewId));
+}
+
+int32_t toViewId(void* context) {
+  return static_cast<int32_t>(reinterpret_cast<intptr_t>(context));
+}
+
+int32_t getViewId(YGNodeConstRef node) {
+  return toViewId(YGNodeGetContext(node));
+}
+
+bool isSameValue(float a, float b) {
+  return a == b || (std::isnan(a) && std::isnan(b));
+}
+
+} // namespace
+
+ShadowTree::ShadowTree(bool useWebDefaults)
+    : config_{YGConfigNew()}, useWebDefaults_{useWebDefaults} {
+  // Same configuration as the platform shadow views
+  YGConfigSetPointScaleFactor(config_, 0.0f);
+  YGConfigSetErrata(config_, YGErrataClassic);
+  YGConfigSetContext(config_, this);
+  // Fixed-size views, such as the fields of a form, take the relayout of a
+  // change within them rather than the whole screen
+  YGConfigSetUseLayoutBoundaries(config_, true);
+
+  createNode(RootViewId);
+  YGNodeRef root = getNode(RootViewId);
+  YGNodeStyleSetFlexDirection(root, YGFlexDirectionColumn);
+  YGNodeStyleSetDirection(root, YGDirectionLTR);
+  YGNodeStyleSetFlexShrink(root, 0.0f);
+}
+
+ShadowTree::~ShadowTree() {
+  for (auto& entry : entries_) {
+    if (entry.node != nullptr) {
+      YGNodeFree(entry.node);
+    }
+  }
+  YGConfigFree(config_);
+}
+
+bool ShadowTree::createNode(int32_t viewId) {
+  Entry* entry = addEntry(viewId);
+  if (entry == nullptr) {
+    return false;
+  }
+
+  if (useWebDefaults_) {
+    YGNodeStyleSetFlexDirection(entry->node, YGFlexDirectionRow);
+    YGNodeStyleSetFlexShrink(entry->node, 1.0f);
+  } else {
+    YGNodeStyleSetFlexDirection(entry->node, YGFlexDirectionColumn);
+    YGNodeStyleSetFlexShrink(entry->node, 0.0f);
+  }
+  return true;
+}
+
+bool ShadowTree::createScreenRoot(int32_t viewId, float width, float height) {
+  Entry* entry = addEntry(viewId);
+  if (entry == nullptr) {
+    return false;
+  }
+
+  entry->isScreenRoot = true;
+  screenRoots_.push_back(viewId);
+
+  YGNodeRef node = entry->node;
+  YGNodeStyleSetDirection(node, YGDirectionLTR);
+  YGNodeStyleSetFlexDirection(node, YGFlexDirectionColumn);
+  YGNodeStyleSetWidth(node, width);
+  YGNodeStyleSetHeight(node, height);
+  YGNodeStyleSetPosition(node, YGEdgeLeft, 0.0f);
+  YGNodeStyleSetPosition(node, YGEdgeTop, 0.0f);
+  YGNodeStyleSetPositionType(node, YGPositionTypeAbsolute);
+  return true;
+}
+
+bool ShadowTree::removeNode(int32_t viewId) {
+  Entry* entry = getEntry(viewId);
+  if (entry == nullptr || viewId == RootViewId) {
+    return false;
+  }
+
+  detach(*entry);
+  YGNodeRemoveAllChildren(entry->node);
+  YGNodeFree(entry->node);
+
+  if (entry->isScreenRoot) {
+    screenRoots_.erase(
+        std::find(screenRoots_.begin(), screenRoots_.end(), viewId));
+  }
+  *entry = Entry{};
+  nodeCount_--;
+  return true;
+}
+
+bool ShadowTree::insertChild(int32_t parentId, int32_t childId, size_t index) {
+  Entry* parent = getEntry(parentId);
+  Entry* child = getEntry(childId);
+  if (parent == nullptr || child == nullptr || child->isScreenRoot ||
+      childId == RootViewId) {
+    return false;
+  }
+
+  // A node cannot become a descendant of itself
+  for (YGNodeRef ancestor = parent->node; ancestor != nullptr;
+       ancestor = YGNodeGetOwner(ancestor)) {
+    if (ancestor == child->node) {
+      return false;
+    }
+  }
+
+  detach(*child);
+  YGNodeSetMeasureFunc(parent->node, nullptr);
+  parent->isChildIndexDirty = true;
+  YGNodeInsertChild(
+      parent->node,
+      child->node,
+      std::min(index, YGNodeGetChildCount(parent->node)));
+  markMovedFrameStale(*child);
+  return true;
+}
+
+bool ShadowTree::detachNode(int32_t viewId) {
+  Entry* entry = getEntry(viewId);
+  if (entry == nullptr) {
+    return false;
+  }
+  detach(*entry);
+  return true;
+}
+
+bool ShadowTree::setChildren(
+    int32_t parentId,
+    const int32_t* childIds,
+    size_t count) {
+  Entry* parent = getEntry(parentId);
+  if (parent == nullptr || (childIds == nullptr && count > 0)) {
+    return false;
+  }
+
+  // Validate everything up front so that a bad id leaves the tree untouched
+  for (size_t i = 0; i < count; i++) {
+    const Entry* child = getEntry(childIds[i]);
+    if (child == nullptr || child->isScreenRoot || childIds[i] == RootViewId) {
+      return false;
+    }
+    for (YGNodeRef ancestor = parent->node; ancestor != nullptr;
+         ancestor = YGNodeGetOwner(ancestor)) {
+      if (ancestor == child->node) {
+        return false;
+      }
+    }
+  }
+
+  oldChildIds_.clear();
+  for (size_t i = 0; i < YGNodeGetChildCount(parent->node); i++) {
+    oldChildIds_.push_back(getViewId(YGNodeGetChild(parent->node, i)));
+  }
+
+  // Only the children which were added or changed place are moved, so that
+  // a reorder leaves the others, and the layout of an unchanged list, alone
+  if (childrenDiff_.diff(
+          oldChildIds_.data(), oldChildIds_.size(), childIds, count)) {
+    const auto& removals = childrenDiff_.getRemovals();
+    const auto& insertions = childrenDiff_.getInsertions();
+    if (removals.empty() && insertions.empty()) {
+      return true;
+    }
+    for (uint32_t index : removals) {
+      YGNodeRemoveChild(parent->node, getEntry(oldChildIds_[index])->node);
+    }
+    YGNodeSetMeasureFunc(parent->node, nullptr);
+    parent->isChildIndexDirty = true;
+    for (uint32_t index : insertions) {
+      Entry& child = *getEntry(childIds[index]);
+      detach(child);
+      YGNodeInsertChild(parent->node, child.node, index);
+      markMovedFrameStale(child);
+    }
+    updateMeasureFunction(*parent);
+    return true;
+  }
+
+  YGNodeRemoveAllChildren(parent->node);
+  YGNodeSetMeasureFunc(parent->node, nullptr);
+  parent->isChildIndexDirty = true;
+  for (size_t i = 0; i < count; i++) {
+    Entry& child = *getEntry(childIds[i]);
+    // A duplicate id is already a child by now
+    if (YGNodeGetOwner(child.node) == parent->node) {
+      continue;
+    }
+    detach(child);
+    YGNodeInsertChild(
+        parent->node, child.node, YGNodeGetChildCount(parent->node));
+    markMovedFrameStale(child);
+  }
+  updateMeasureFunction(*parent);
+  return true;
+}
+
+int32_t ShadowTree::setProps(
+    int32_t viewId,
+    const LayoutValue* values,
+    size_t count) {
+  Entry* entry = getEntry(viewId);
+  if (entry == nullptr) {
+    return -1;
+  }
+
+  styleUpdates_.clear();
+  for (size_t i = 0; i < count; i++) {
+    if (const auto update = toStyleUpdate(values[i])) {
+      styleUpdates_.push_back(*update);
+    }
+  }
+  const YGDisplay display = YGNodeStyleGetDisplay(entry->node);
+  const size_t changed = YGNodeStyleApplyUpdates(
+      entry->node, styleUpdates_.data(), styleUpdates_.size());
+  if (changed > 0) {
+    updateFlattening(*entry);
+    // Hidden views are left out of the index of their parent
+    if (YGNodeStyleGetDisplay(entry->node) != display) {
+      markChildIndexDirty(YGNodeGetOwner(entry->node));
+    }
+  }
+  return static_cast<int32_t>(changed);
+}
+
+bool ShadowTree::setMeasureFunction(
+    int32_t viewId,
+    MeasureFunction measure,
+    void* context) {
+  Entry* entry = getEntry(viewId);
+  if (entry == nullptr) {
+    return false;
+  }
+
+  entry->measure = measure;
+  entry->measureContext = context;
+  updateMeasureFunction(*entry);
+  updateFlattening(*entry);
+  if (YGNodeHasMeasureFunc(entry->node)) {
+    YGNodeMarkDirty(entry->node);
+  }
+  return true;
+}
+
+bool ShadowTree::markDirty(int32_t viewId) {
+  Entry* entry = getEntry(viewId);
+  if (entry == nullptr || !YGNodeHasMeasureFunc(entry->node)) {
+    return false;
+  }
+  YGNodeMarkDirty(entry->node);
+  return true;
+}
+
+bool ShadowTree::setIntrinsicSizes(
+    int32_t viewId,
+    const YGSize* sizes,
+    size_t count) {
+  Entry* entry = getEntry(viewId);
+  if (entry == nullptr) {
+    return false;
+  }
+  YGNodeSetIntrinsicSizes(entry->node, sizes, count);
+  return true;
+}
+
+bool ShadowTree::setVirtualized(
+    int32_t viewId,
+    bool virtualized,
+    float estimatedExtent) {
+  Entry* entry = getEntry(viewId);
+  if (entry == nullptr) {
+    return false;
+  }
+  YGNodeSetVirtualizesChildren(entry->node, virtualized, estimatedExtent);
+  updateFlattening(*entry);
+  return true;
+}
+
+bool ShadowTree::setScrollWindow(
+    int32_t viewId,
+    float offset,
+    float extent,
+    float overscan) {
+  Entry* entry = getEntry(viewId);
+  if (entry == nullptr || !YGNodeGetVirtualizesChildren(entry->node)) {
+    return false;
+  }
+  YGNodeSetVirtualizedWindow(entry->node, offset, extent, overscan);
+  return true;
+}
+
+bool ShadowTree::setLayoutOnly(int32_t viewId, bool layoutOnly) {
+  Entry* entry = getEntry(viewId);
+  if (entry == nullptr || entry->isScreenRoot || viewId == RootViewId) {
+    return false;
+  }
+  entry->isLayoutOnly = layoutOnly;
+  updateFlattening(*entry);
+  return true;
+}
+
+bool ShadowTree::isFlattened(int32_t viewId) const {
+  const Entry* entry = getEntry(viewId);
+  return entry != nullptr && entry->isFlattened;
+}
+
+int32_t ShadowTree::getMountedParent(int32_t viewId) const {
+  const Entry* entry = getEntry(viewId);
+  if (entry == nullptr) {
+    return -1;
+  }
+  for (YGNodeRef owner = YGNodeGetOwner(entry->node); owner != nullptr;
+       owner = YGNodeGetOwner(owner)) {
+    const int32_t ownerId = getViewId(owner);
+    if (!entries_[static_cast<size_t>(ownerId)].isFlattened) {
+      return ownerId;
+    }
+  }
+  return -1;
+}
+
+const std::vector<LayoutUpdate>& ShadowTree::calculateLayout(
+    float width,
+    float height) {
+  updates_.clear();
+  contexts_.resize(nodeCount_);
+  left_.resize(nodeCount_);
+  top_.resize(nodeCount_);
+  width_.resize(nodeCount_);
+  height_.resize(nodeCount_);
+
+  YGNodeRef root = getNode(RootViewId);
+  YGNodeCalculateLayoutIncremental(root, width, height, YGDirectionLTR);
+  collectLayouts(root);
+
+  for (int32_t viewId : screenRoots_) {
+    YGNodeRef screenRoot = getNode(viewId);
+    YGNodeStyleSetWidth(screenRoot, width);
+    YGNodeStyleSetHeight(screenRoot, height);
+    YGNodeCalculateLayoutIncremental(
+        screenRoot, width, height, YGDirectionLTR);
+    collectLayouts(screenRoot);
+  }
+
+  updateStaleFrames();
+  return updates_;
+}
+
+const std::vector<int32_t>&
+ShadowTree::queryPoint(int32_t viewId, float x, float y) {
+  return query(viewId, Rect{x, y, x, y});
+}
+
+const std::vector<int32_t>& ShadowTree::queryRect(
+    int32_t viewId,
+    float left,
+    float top,
+    float width,
+    float height) {
+  return query(viewId, Rect{left, top, left + width, top + height});
+}
+
+YGSize ShadowTree::measure(
+    YGNodeConstRef node,
+    float width,
+    YGMeasureMode widthMode,
+    float height,
+    YGMeasureMode heightMode) {
+  // YGNodeGetConfig() does not modify the node
+  auto tree = static_cast<ShadowTree*>(
+      YGConfigGetContext(YGNodeGetConfig(const_cast<YGNodeRef>(node))));
+  const int32_t viewId = getViewId(node);
+  const Entry* entry = tree->getEntry(viewId);
+  return entry->measure(
+      entry->measureContext, viewId, width, widthMode, height, heightMode);
+}
+
+ShadowTree::Entry* ShadowTree::getEntry(int32_t viewId) {
+  if (viewId < 0 || static_cast<size_t>(viewId) >= entries_.size()) {
+    return nullptr;
+  }
+  Entry& entry = entries_[static_cast<size_t>(viewId)];
+  return entry.node != nullptr ? &entry : nullptr;
+}
+
+const ShadowTree::Entry* ShadowTree::getEntry(int32_t viewId) const {
+  return const_cast<ShadowTree*>(this)->getEntry(viewId);
+}
+
+ShadowTree::Entry* ShadowTree::addEntry(int32_t viewId) {
+  if (viewId < 0 || getEntry(viewId) != nullptr) {
+    return nullptr;
+  }
+  if (static_cast<size_t>(viewId) >= entries_.size()) {
+    entries_.resize(static_cast<size_t>(viewId) + 1);
+  }
+
+  Entry& entry = entries_[static_cast<size_t>(viewId)];
+  entry.node = YGNodeNewWithConfig(config_);
+  YGNodeSetContext(entry.node, toContext(viewId));
+  nodeCount_++;
+  return &entry;
+}
+
+void ShadowTree::detach(Entry& entry) {
+  YGNodeRef owner = YGNodeGetOwner(entry.node);
+  if (owner == nullptr) {
+    return;
+  }
+  YGNodeRemoveChild(owner, entry.node);
+  Entry& ownerEntry = *getEntry(getViewId(owner));
+  ownerEntry.isChildIndexDirty = true;
+  updateMeasureFunction(ownerEntry);
+}
+
+void ShadowTree::updateMeasureFunction(Entry& entry) {
+  const bool canMeasure =
+      entry.measure != nullptr && YGNodeGetChildCount(entry.node) == 0;
+  if (canMeasure != YGNodeHasMeasureFunc(entry.node)) {
+    YGNodeSetMeasureFunc(entry.node, canMeasure ? &measure : nullptr);
+  }
+}
+
+void ShadowTree::collectLayouts(YGNodeRef root) {
+  const size_t count = YGNodeLayoutCollectNewLayouts(
+      root,
+      contexts_.size(),
+      contexts_.data(),
+      left_.data(),
+      top_.data(),
+      width_.data(),
+      height_.data());
+
+  for (size_t i = 0; i < count; i++) {
+    const int32_t viewId = toViewId(contexts_[i]);
+    Entry& entry = entries_[static_cast<size_t>(viewId)];
+    const bool moved = !isSameValue(entry.frame.left, left_[i]) ||
+        !isSameValue(entry.frame.top, top_[i]);
+    if (!moved && isSameValue(entry.frame.width, width_[i]) &&
+        isSameValue(entry.frame.height, height_[i])) {
+      continue;
+    }
+    entry.frame = {left_[i], top_[i], width_[i], height_[i]};
+    markChildIndexDirty(YGNodeGetOwner(entry.node));
+
+    if (entry.isFlattened) {
+      // Children without a new layout of their own move with it, so they are
+      // offset once every new layout has been read
+      if (moved) {
+        staleFrames_.push_back(viewId);
+      }
+      continue;
+    }
+    // Views are read parents first, so flattened ancestors are up to date
+    float offsetLeft;
+    float offsetTop;
+    getMountedOffset(entry, offsetLeft, offsetTop);
+    updateMountedFrames(entry, offsetLeft, offsetTop);
+  }
+}
+
+void ShadowTree::updateFlattening(Entry& entry) {
+  const bool isFlattened = entry.isLayoutOnly && entry.measure == nullptr &&
+      !YGNodeGetVirtualizesChildren(entry.node) &&
+      YGNodeStyleGetOverflow(entry.node) == YGOverflowVisible;
+  if (isFlattened == entry.isFlattened) {
+    return;
+  }
+
+  // The view enters or leaves the mounted hierarchy, and its children are
+  // mounted in another view
+  entry.isFlattened = isFlattened;
+  entry.mountedFrame = Frame{};
+  markMountedFrameStale(entry);
+  for (size_t i = 0; i < YGNodeGetChildCount(entry.node); i++) {
+    Entry& child = entries_[static_cast<size_t>(
+        getViewId(YGNodeGetChild(entry.node, i)))];
+    child.mountedFrame = Frame{};
+    markMountedFrameStale(child);
+  }
+}
+
+void ShadowTree::markMountedFrameStale(Entry& entry) {
+  staleFrames_.push_back(getViewId(entry.node));
+}
+
+void ShadowTree::markMovedFrameStale(Entry& entry) {
+  // A view laid out before may keep its frame in its new parent, while its
+  // mounted parent changed. New views are returned by their first layout.
+  if (!std::isnan(entry.frame.width)) {
+    markMountedFrameStale(entry);
+  }
+}
+
+void ShadowTree::updateStaleFrames() {
+  for (int32_t viewId : staleFrames_) {
+    Entry* entry = getEntry(viewId);
+    if (entry == nullptr) {
+      continue;
+    }
+    // Views detached from every root are not mounted
+    YGNodeRef top = entry->node;
+    while (YGNodeGetOwner(top) != nullptr) {
+      top = YGNodeGetOwner(top);
+    }
+    const int32_t topId = getViewId(top);
+    if (topId != RootViewId &&
+        !entries_[static_cast<size_t>(topId)].isScreenRoot) {
+      continue;
+    }
+
+    float offsetLeft;
+    float offsetTop;
+    getMountedOffset(*entry, offsetLeft, offsetTop);
+    updateMountedFrames(*entry, offsetLeft, offsetTop);
+  }
+  staleFrames_.clear();
+}
+
+void ShadowTree::getMountedOffset(
+    const Entry& entry,
+    float& left,
+    float& top) const {
+  left = 0.0f;
+  top = 0.0f;
+  for (YGNodeRef owner = YGNodeGetOwner(entry.node); owner != nullptr;
+       owner = YGNodeGetOwner(owner)) {
+    const Entry& ancestor = entries_[static_cast<size_t>(getViewId(owner))];
+    if (!ancestor.isFlattened) {
+      return;
+    }
+    left += ancestor.frame.left;
+    top += ancestor.frame.top;
+  }
+}
+
+void ShadowTree::updateMountedFrames(
+    Entry& entry,
+    float offsetLeft,
+    float offsetTop) {
+  // Not laid out yet, e.g. outside the window of a virtualizing node
+  if (std::isnan(entry.frame.width)) {
+    return;
+  }
+
+  if (entry.isFlattened) {
+    for (size_t i = 0; i < YGNodeGetChildCount(entry.node); i++) {
+      updateMountedFrames(
+          entries_[static_cast<size_t>(
+              getViewId(YGNodeGetChild(entry.node, i)))],
+          offsetLeft + entry.frame.left,
+          offsetTop + entry.frame.top);
+    }
+    return;
+  }
+
+  const Frame frame{
+      entry.frame.left + offsetLeft,
+      entry.frame.top + offsetTop,
+      entry.frame.width,
+      entry.frame.height};
+  if (isSameValue(entry.mountedFrame.left, frame.left) &&
+      isSameValue(entry.mountedFrame.top, frame.top) &&
+      isSameValue(entry.mountedFrame.width, frame.width) &&
+      isSameValue(entry.mountedFrame.height, frame.height)) {
+    return;
+  }
+  entry.mountedFrame = frame;
+  updates_.push_back(
+      {getViewId(entry.node), frame.left, frame.top, frame.width, frame.height});
+}
+
+void ShadowTree::markChildIndexDirty(YGNodeRef parent) {
+  if (parent != nullptr) {
+    entries_[static_cast<size_t>(getViewId(parent))].isChildIndexDirty = true;
+  }
+}
+
+const std::vector<int32_t>& ShadowTree::query(
+    int32_t viewId,
+    const Rect& area) {
+  hits_.clear();
+  Entry* entry = getEntry(viewId);
+  if (entry != nullptr &&
+      YGNodeStyleGetDisplay(entry->node) != YGDisplayNone &&
+      intersects(
+          Rect{0.0f, 0.0f, entry->frame.width, entry->frame.height}, area)) {
+    if (!entry->isFlattened) {
+      hits_.push_back(viewId);
+    }
+    queryChildren(*entry, area);
+  }
+  return hits_;
+}
+
+void ShadowTree::queryChildren(Entry& entry, const Rect& area) {
+  const size_t childCount = YGNodeGetChildCount(entry.node);
+  if (childCount == 0) {
+    return;
+  }
+  if (entry.isChildIndexDirty) {
+    childFrames_.clear();
+    for (size_t i = 0; i < childCount; i++) {
+      const int32_t childId = getViewId(YGNodeGetChild(entry.node, i));
+      const Entry& child = entries_[static_cast<size_t>(childId)];
+      // A hidden view and its subtree take no events; a NaN frame leaves it
+      // out of the index
+      if (YGNodeStyleGetDisplay(child.node) == YGDisplayNone) {
+        childFrames_.push_back({NAN, NAN, NAN, NAN});
+        continue;
+      }
+      childFrames_.push_back(
+          {child.frame.left,
+           child.frame.top,
+           child.frame.left + child.frame.width,
+           child.frame.top + child.frame.height});
+    }
+    entry.childIndex.assign(childFrames_);
+    entry.isChildIndexDirty = false;
+  }
+
+  // childHits_ is shared by the whole descent, each level using its end
+  const size_t first = childHits_.size();
+  entry.childIndex.query(area, childHits_);
+  const size_t end = childHits_.size();
+  for (size_t i = first; i < end; i++) {
+    const int32_t childId =
+        getViewId(YGNodeGetChild(entry.node, childHits_[i]));
+    Entry& child = entries_[static_cast<size_t>(childId)];
+    if (!child.isFlattened) {
+      hits_.push_back(childId);
+    }
+    queryChildren(
+        child,
+        Rect{
+            area.left - child.frame.left,
+            area.top - child.frame.top,
+            area.right - child.frame.left,
+            area.bottom - child.frame.top});
+  }
+  childHits_.resize(first);
+}
+
+} // namespace dcflight::shadow
@@ -0,0 +1,295 @@
+/*
+ * Copyright (c) Dotcorr Studio. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <yoga/Yoga.h>
+
+#include <dcflight/shadow/ChildrenDiff.h>
+#include <dcflight/shadow/LayoutProps.h>
+#include <dcflight/shadow/SpatialIndex.h>
+
+namespace dcflight::shadow {
+
+/**
+ * Measures a leaf node whose size depends on its content, such as text. The
+ * width and height are the space available to the node, constrained as the
+ * measure modes say.
+ */
+using MeasureFunction = YGSize (*)(
+    void* context,
+    int32_t viewId,
+    float width,
+    YGMeasureMode widthMode,
+    float height,
+    YGMeasureMode heightMode);
+
+// A frame to apply to a view, relative to its parent
+struct LayoutUpdate {
+  int32_t viewId;
+  float left;
+  float top;
+  float width;
+  float height;
+};
+
+/**
+ * The layout tree of the views of an app, mirroring the view hierarchy.
+ *
+ * Views are identified by their integer view id and looked up in a table
+ * indexed by id, as ids are allocated densely from zero. View 0 is the root
+ * of the app and exists from construction. Screen roots are laid out on their
+ * own, filling the screen, rather than as part of the tree they belong to.
+ *
+ * calculateLayout() lays out every root and returns the views whose frame
+ * changed since it was last returned, so that a platform only touches the
+ * views which moved. Views with a fixed width and height are Yoga layout
+ * boundaries: a change within one is laid out from that view rather than
+ * from its root.
+ *
+ * Views which only group their children for layout are flattened: they stay
+ * in the Yoga tree but are left out of the mounted hierarchy, their children
+ * being mounted in their place with frames relative to the nearest view
+ * which is mounted. Layout-only wrappers then cost no native view.
+ *
+ * queryPoint() and queryRect() find views by their last returned frame for
+ * hit testing and culling, descending through a SpatialIndex of the children
+ * of each view. An index is only rebuilt when queried after a child moved.
+ *
+ * A tree must only be used from one thread at a time.
+ */
+class ShadowTree {
+ public:
+  static constexpr int32_t RootViewId = 0;
+
+  // With web defaults, nodes lay out in rows and shrink like CSS flexbox
+  // rather than in columns as in React Native
+  explicit ShadowTree(bool useWebDefaults = false);
+  ~ShadowTree();
+
+  ShadowTree(const ShadowTree&) = delete;
+  ShadowTree& operator=(const ShadowTree&) = delete;
+
+  // The node operations below return false when a view id is invalid, not
+  // (or already) in the tree, or the operation would break the tree
+
+  bool createNode(int32_t viewId);
+  bool createScreenRoot(int32_t viewId, float width, float height);
+
+  // Removes a node from its parent and from the tree. Its children are
+  // detached and stay in the tree, to be attached elsewhere or removed.
+  bool removeNode(int32_t viewId);
+
+  // Moves a node under a new parent, at `index` among its children or last
+  // if the index is out of range
+  bool insertChild(int32_t parentId, int32_t childId, size_t index);
+  bool detachNode(int32_t viewId);
+
+  // Replaces the children of a node at once, only moving those which were
+  // added or changed place (see ChildrenDiff)
+  bool setChildren(int32_t parentId, const int32_t* childIds, size_t count);
+
+  /**
+   * Applies a batch of layout props to a node, marking it dirty at most once.
+   * Props with a unit or keyword they do not support are ignored.
+   *
+   * @returns the number of props which changed its style, or -1 if there is
+   * no such node
+   */
+  int32_t setProps(int32_t viewId, const LayoutValue* values, size_t count);
+
+  // Sets or, given nullptr, clears the measure function of a node. It is only
+  // used while the node has no children.
+  bool setMeasureFunction(
+      int32_t viewId,
+      MeasureFunction measure,
+      void* context);
+
+  // Invalidates the measurement of a node, e.g. after its text changed
+  bool markDirty(int32_t viewId);
+
+  /**
+   * Sets the sizes a measured node takes in each way its content wraps, by
+   * increasing width, so that Yoga measures it without calling back (see
+   * YGNodeSetIntrinsicSizes()). For a text, the platform shapes it once and
+   * passes the size of each of its line breaks, from the widest word to a
+   * single line. A count of 0 clears them.
+   */
+  bool setIntrinsicSizes(int32_t viewId, const YGSize* sizes, size_t count);
+
+  /**
+   * Sets whether a node, such as the content of a long scroll view, only lays
+   * out the children within its scroll window (see
+   * YGNodeSetVirtualizesChildren()). Children not laid out yet are assumed to
+   * span `estimatedExtent` along its main axis.
+   */
+  bool setVirtualized(int32_t viewId, bool virtualized, float estimatedExtent);
+
+  // Sets the visible part of a virtualizing node along its main axis, and
+  // the extent past either side to lay out ahead of scrolling. Returns false
+  // if the node does not virtualize its children.
+  bool setScrollWindow(
+      int32_t viewId,
+      float offset,
+      float extent,
+      float overscan);
+
+  /**
+   * Sets whether a view only groups its children for layout, drawing nothing
+   * and taking no events, e.g. a view whose props all pass
+   * isLayoutOnlyProp(). Such a view is flattened unless it clips its children
+   * (its overflow is not visible), measures its content or virtualizes its
+   * children. The root and screen roots are never flattened.
+   */
+  bool setLayoutOnly(int32_t viewId, bool layoutOnly);
+
+  // Whether a view is left out of the mounted hierarchy, and its children
+  // mounted in its place
+  bool isFlattened(int32_t viewId) const;
+
+  // The view a view is mounted in: its nearest ancestor which is not
+  // flattened, or -1 if it has none
+  int32_t getMountedParent(int32_t viewId) const;
+
+  /**
+   * Lays out the root and every screen root in the given size.
+   *
+   * @returns the views whose frame relative to their mounted parent changed,
+   * in pre-order per root, followed by the children of views which were
+   * flattened, moved or attached since the last call. Flattened views are
+   * not returned. The array is valid until the next call.
+   */
+  const std::vector<LayoutUpdate>& calculateLayout(float width, float height);
+
+  /**
+   * Finds the views containing a point, in the coordinates of a view, for hit
+   * testing. Views only contain points within their parent. Flattened views,
+   * which take no events, are left out, as are hidden (`display: none`) views
+   * and their subtrees.
+   *
+   * @returns the views, parents before their children and siblings in order,
+   * so that the last one is the view on top. The array is valid until the
+   * next query.
+   */
+  const std::vector<int32_t>& queryPoint(int32_t viewId, float x, float y);
+
+  // Finds the views intersecting a rect in the coordinates of a view, e.g.
+  // its visible part, in the same order as queryPoint()
+  const std::vector<int32_t>& queryRect(
+      int32_t viewId,
+      float left,
+      float top,
+      float width,
+      float height);
+
+  bool contains(int32_t viewId) const {
+    return getEntry(viewId) != nullptr;
+  }
+
+  size_t getNodeCount() const {
+    return nodeCount_;
+  }
+
+  // The Yoga node of a view, for platform specific setup
+  YGNodeRef getNode(int32_t viewId) const {
+    const Entry* entry = getEntry(viewId);
+    return entry != nullptr ? entry->node : nullptr;
+  }
+
+ private:
+  struct Frame {
+    float left = YGUndefined;
+    float top = YGUndefined;
+    float width = YGUndefined;
+    float height = YGUndefined;
+  };
+
+  struct Entry {
+    YGNodeRef node = nullptr;
+    bool isScreenRoot = false;
+    bool isLayoutOnly = false;
+    bool isFlattened = false;
+    MeasureFunction measure = nullptr;
+    void* measureContext = nullptr;
+    // Layout last read from Yoga, relative to the parent, NaN if none
+    Frame frame;
+    // Frame last returned by calculateLayout(), relative to the mounted
+    // parent, NaN if none
+    Frame mountedFrame;
+    // The frames of the children, rebuilt by the first query after one moved
+    SpatialIndex childIndex;
+    bool isChildIndexDirty = true;
+  };
+
+  static YGSize measure(
+      YGNodeConstRef node,
+      float width,
+      YGMeasureMode widthMode,
+      float height,
+      YGMeasureMode heightMode);
+
+  Entry* getEntry(int32_t viewId);
+  const Entry* getEntry(int32_t viewId) const;
+  Entry* addEntry(int32_t viewId);
+
+  // Detaches a node from its parent, if any
+  void detach(Entry& entry);
+
+  // Yoga nodes cannot have both children and a measure function
+  void updateMeasureFunction(Entry& entry);
+
+  void collectLayouts(YGNodeRef root);
+
+  // Flattens or restores a view after a change to what it draws
+  void updateFlattening(Entry& entry);
+  // Has the mounted frame of a view returned by the next calculateLayout(),
+  // or those of its children if it is flattened
+  void markMountedFrameStale(Entry& entry);
+  // Same for a view attached to a new parent
+  void markMovedFrameStale(Entry& entry);
+  void updateStaleFrames();
+  // The position of the parent of a view relative to its mounted parent
+  void getMountedOffset(const Entry& entry, float& left, float& top) const;
+  // Returns the frame of a view offset by the position of its parent relative
+  // to its mounted parent if it changed, or those of its children if it is
+  // flattened
+  void updateMountedFrames(Entry& entry, float offsetLeft, float offsetTop);
+
+  void markChildIndexDirty(YGNodeRef parent);
+  const std::vector<int32_t>& query(int32_t viewId, const Rect& area);
+  // Appends the descendants of a view intersecting an area in its
+  // coordinates to hits_
+  void queryChildren(Entry& entry, const Rect& area);
+
+  YGConfigRef config_;
+  bool useWebDefaults_;
+  std::vector<Entry> entries_;
+  std::vector<int32_t> screenRoots_;
+  std::vector<int32_t> staleFrames_;
+  size_t nodeCount_ = 0;
+
+  ChildrenDiff childrenDiff_;
+  std::vector<int32_t> oldChildIds_;
+
+  std::vector<YGStyleUpdate> styleUpdates_;
+  std::vector<LayoutUpdate> updates_;
+  std::vector<void*> contexts_;
+  std::vector<float> left_;
+  std::vector<float> top_;
+  std::vector<float> width_;
+  std::vector<float> height_;
+
+  std::vector<int32_t> hits_;
+  std::vector<size_t> childHits_;
+  std::vector<Rect> childFrames_;
+};
+
+} // namespace dcflight::shadow
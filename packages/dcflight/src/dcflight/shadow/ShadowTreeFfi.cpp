@@ -0,0 +1,268 @@
+/*
+ * Copyright (c) Dotcorr Studio. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include <dcflight/shadow/ChildrenDiff.h>
+#include <dcflight/shadow/ShadowTree.h>
+#include <dcflight/shadow/ShadowTreeFfi.h>
+
+using namespace dcflight::shadow;
+
+static_assert(sizeof(DCFlightLayoutValue) == sizeof(LayoutValue));
+static_assert(
+    offsetof(DCFlightLayoutValue, prop) == offsetof(LayoutValue, prop));
+static_assert(
+    offsetof(DCFlightLayoutValue, unit) == offsetof(LayoutValue, unit));
+static_assert(
+    offsetof(DCFlightLayoutValue, value) == offsetof(LayoutValue, value));
+
+static_assert(sizeof(DCFlightLayoutUpdate) == sizeof(LayoutUpdate));
+static_assert(
+    offsetof(DCFlightLayoutUpdate, viewId) == offsetof(LayoutUpdate, viewId));
+static_assert(
+    offsetof(DCFlightLayoutUpdate, height) == offsetof(LayoutUpdate, height));
+
+static_assert(std::is_same_v<DCFlightMeasureCallback, MeasureFunction>);
+
+namespace {
+
+ShadowTree* unwrap(DCFlightShadowTree* tree) {
+  return reinterpret_cast<ShadowTree*>(tree);
+}
+
+} // namespace
+
+DCFlightShadowTree* dcflight_shadow_tree_new(bool useWebDefaults) {
+  return reinterpret_cast<DCFlightShadowTree*>(new ShadowTree(useWebDefaults));
+}
+
+void dcflight_shadow_tree_free(DCFlightShadowTree* tree) {
+  delete unwrap(tree);
+}
+
+int32_t dcflight_shadow_lookup_prop(const char* key) {
+  if (key == nullptr) {
+    return -1;
+  }
+  const auto prop = lookupLayoutProp(key);
+  return prop ? static_cast<int32_t>(*prop) : -1;
+}
+
+bool dcflight_shadow_is_layout_only_prop(const char* key) {
+  return key != nullptr && isLayoutOnlyProp(key);
+}
+
+int32_t dcflight_shadow_lookup_keyword(int32_t prop, const char* keyword) {
+  if (prop < 0 || prop >= LayoutPropCount || keyword == nullptr) {
+    return -1;
+  }
+  return lookupLayoutKeyword(static_cast<LayoutProp>(prop), keyword)
+      .value_or(-1);
+}
+
+bool dcflight_shadow_create_node(DCFlightShadowTree* tree, int32_t viewId) {
+  return tree != nullptr && unwrap(tree)->createNode(viewId);
+}
+
+bool dcflight_shadow_create_screen_root(
+    DCFlightShadowTree* tree,
+    int32_t viewId,
+    float width,
+    float height) {
+  return tree != nullptr &&
+      unwrap(tree)->createScreenRoot(viewId, width, height);
+}
+
+bool dcflight_shadow_remove_node(DCFlightShadowTree* tree, int32_t viewId) {
+  return tree != nullptr && unwrap(tree)->removeNode(viewId);
+}
+
+bool dcflight_shadow_insert_child(
+    DCFlightShadowTree* tree,
+    int32_t parentId,
+    int32_t childId,
+    int32_t index) {
+  return tree != nullptr &&
+      unwrap(tree)->insertChild(
+          parentId,
+          childId,
+          index < 0 ? SIZE_MAX : static_cast<size_t>(index));
+}
+
+bool dcflight_shadow_detach_node(DCFlightShadowTree* tree, int32_t viewId) {
+  return tree != nullptr && unwrap(tree)->detachNode(viewId);
+}
+
+bool dcflight_shadow_set_children(
+    DCFlightShadowTree* tree,
+    int32_t parentId,
+    const int32_t* childIds,
+    int32_t count) {
+  return tree != nullptr && count >= 0 &&
+      unwrap(tree)->setChildren(
+          parentId, childIds, static_cast<size_t>(count));
+}
+
+bool dcflight_shadow_diff_children(
+    const int32_t* oldIds,
+    int32_t oldCount,
+    const int32_t* newIds,
+    int32_t newCount,
+    int32_t* removals,
+    int32_t* removalCount,
+    int32_t* insertions,
+    int32_t* insertionCount) {
+  if (oldCount < 0 || newCount < 0 || (oldIds == nullptr && oldCount > 0) ||
+      (newIds == nullptr && newCount > 0) ||
+      (removals == nullptr && oldCount > 0) ||
+      (insertions == nullptr && newCount > 0) || removalCount == nullptr ||
+      insertionCount == nullptr) {
+    return false;
+  }
+  // Reused by every call on the thread, so that diffing stops allocating
+  thread_local ChildrenDiff diff;
+  if (!diff.diff(
+          oldIds,
+          static_cast<size_t>(oldCount),
+          newIds,
+          static_cast<size_t>(newCount))) {
+    return false;
+  }
+  std::copy(
+      diff.getRemovals().begin(), diff.getRemovals().end(), removals);
+  std::copy(
+      diff.getInsertions().begin(), diff.getInsertions().end(), insertions);
+  *removalCount = static_cast<int32_t>(diff.getRemovals().size());
+  *insertionCount = static_cast<int32_t>(diff.getInsertions().size());
+  return true;
+}
+
+int32_t dcflight_shadow_set_props(
+    DCFlightShadowTree* tree,
+    int32_t viewId,
+    const DCFlightLayoutValue* values,
+    int32_t count) {
+  if (tree == nullptr || count < 0 || (values == nullptr && count > 0)) {
+    return -1;
+  }
+  for (int32_t i = 0; i < count; i++) {
+    if (values[i].prop >= LayoutPropCount || values[i].unit > YGUnitAuto) {
+      return -1;
+    }
+  }
+  return unwrap(tree)->setProps(
+      viewId,
+      reinterpret_cast<const LayoutValue*>(values),
+      static_cast<size_t>(count));
+}
+
+bool dcflight_shadow_set_measure_callback(
+    DCFlightShadowTree* tree,
+    int32_t viewId,
+    DCFlightMeasureCallback callback,
+    void* context) {
+  return tree != nullptr &&
+      unwrap(tree)->setMeasureFunction(viewId, callback, context);
+}
+
+bool dcflight_shadow_mark_dirty(DCFlightShadowTree* tree, int32_t viewId) {
+  return tree != nullptr && unwrap(tree)->markDirty(viewId);
+}
+
+bool dcflight_shadow_set_intrinsic_sizes(
+    DCFlightShadowTree* tree,
+    int32_t viewId,
+    const YGSize* sizes,
+    int32_t count) {
+  return tree != nullptr && count >= 0 &&
+      unwrap(tree)->setIntrinsicSizes(
+          viewId, sizes, static_cast<size_t>(count));
+}
+
+bool dcflight_shadow_set_virtualized(
+    DCFlightShadowTree* tree,
+    int32_t viewId,
+    bool virtualized,
+    float estimatedExtent) {
+  return tree != nullptr &&
+      unwrap(tree)->setVirtualized(viewId, virtualized, estimatedExtent);
+}
+
+bool dcflight_shadow_set_scroll_window(
+    DCFlightShadowTree* tree,
+    int32_t viewId,
+    float offset,
+    float extent,
+    float overscan) {
+  return tree != nullptr &&
+      unwrap(tree)->setScrollWindow(viewId, offset, extent, overscan);
+}
+
+bool dcflight_shadow_set_layout_only(
+    DCFlightShadowTree* tree,
+    int32_t viewId,
+    bool layoutOnly) {
+  return tree != nullptr && unwrap(tree)->setLayoutOnly(viewId, layoutOnly);
+}
+
+bool dcflight_shadow_is_flattened(DCFlightShadowTree* tree, int32_t viewId) {
+  return tree != nullptr && unwrap(tree)->isFlattened(viewId);
+}
+
+int32_t dcflight_shadow_get_mounted_parent(
+    DCFlightShadowTree* tree,
+    int32_t viewId) {
+  return tree != nullptr ? unwrap(tree)->getMountedParent(viewId) : -1;
+}
+
+uint32_t dcflight_shadow_calculate_layout(
+    DCFlightShadowTree* tree,
+    float width,
+    float height,
+    const DCFlightLayoutUpdate** updates) {
+  if (tree == nullptr || updates == nullptr) {
+    return 0;
+  }
+  const auto& changed = unwrap(tree)->calculateLayout(width, height);
+  *updates = reinterpret_cast<const DCFlightLayoutUpdate*>(changed.data());
+  return static_cast<uint32_t>(changed.size());
+}
+
+uint32_t dcflight_shadow_query_point(
+    DCFlightShadowTree* tree,
+    int32_t viewId,
+    float x,
+    float y,
+    const int32_t** viewIds) {
+  if (tree == nullptr || viewIds == nullptr) {
+    return 0;
+  }
+  const auto& hits = unwrap(tree)->queryPoint(viewId, x, y);
+  *viewIds = hits.data();
+  return static_cast<uint32_t>(hits.size());
+}
+
+uint32_t dcflight_shadow_query_rect(
+    DCFlightShadowTree* tree,
+    int32_t viewId,
+    float left,
+    float top,
+    float width,
+    float height,
+    const int32_t** viewIds) {
+  if (tree == nullptr || viewIds == nullptr) {
+    return 0;
+  }
+  const auto& hits =
+      unwrap(tree)->queryRect(viewId, left, top, width, height);
+  *viewIds = hits.data();
+  return static_cast<uint32_t>(hits.size());
+}
@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) Dotcorr Studio. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#ifndef DCFLIGHT_SHADOW_TREE_FFI_H
+#define DCFLIGHT_SHADOW_TREE_FFI_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <yoga/Yoga.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// C interface of dcflight::shadow::ShadowTree (see ShadowTree.h), for the
+// platform bridges. Trees are not thread safe; see ShadowTree.
+
+typedef struct DCFlightShadowTree DCFlightShadowTree;
+
+// A layout prop to apply, laid out as dcflight::shadow::LayoutValue. prop is
+// a value returned by dcflight_shadow_lookup_prop(), unit a YGUnit, and value
+// the number, or the value returned by dcflight_shadow_lookup_keyword() for
+// keyword props such as flexDirection.
+typedef struct {
+    uint16_t prop;
+    uint16_t unit;
+    float value;
+} DCFlightLayoutValue;
+
+// A frame to apply to a view, relative to its parent, laid out as
+// dcflight::shadow::LayoutUpdate
+typedef struct {
+    int32_t viewId;
+    float left;
+    float top;
+    float width;
+    float height;
+} DCFlightLayoutUpdate;
+
+typedef YGSize (*DCFlightMeasureCallback)(
+    void* context,
+    int32_t viewId,
+    float width,
+    YGMeasureMode widthMode,
+    float height,
+    YGMeasureMode heightMode);
+
+DCFlightShadowTree* dcflight_shadow_tree_new(bool useWebDefaults);
+void dcflight_shadow_tree_free(DCFlightShadowTree* tree);
+
+// Returns the prop id for a component prop name, or -1 if it is not a layout
+// prop. Ids are stable for the lifetime of the process.
+int32_t dcflight_shadow_lookup_prop(const char* key);
+// Returns the value of a keyword for a keyword prop, or -1 if it is unknown
+int32_t dcflight_shadow_lookup_keyword(int32_t prop, const char* keyword);
+// Whether a component prop only affects layout; a view whose props all do
+// may be marked layout-only
+bool dcflight_shadow_is_layout_only_prop(const char* key);
+
+bool dcflight_shadow_create_node(DCFlightShadowTree* tree, int32_t viewId);
+bool dcflight_shadow_create_screen_root(DCFlightShadowTree* tree, int32_t viewId, float width, float height);
+bool dcflight_shadow_remove_node(DCFlightShadowTree* tree, int32_t viewId);
+// A negative index appends the child
+bool dcflight_shadow_insert_child(DCFlightShadowTree* tree, int32_t parentId, int32_t childId, int32_t index);
+bool dcflight_shadow_detach_node(DCFlightShadowTree* tree, int32_t viewId);
+bool dcflight_shadow_set_children(DCFlightShadowTree* tree, int32_t parentId, const int32_t* childIds, int32_t count);
+
+// Computes the fewest moves turning the children oldIds of a view into
+// newIds, for a platform to move only those native views (see ChildrenDiff).
+// Writes the indices in oldIds of the children to remove, decreasing, to
+// removals, and the indices in newIds of the children to insert, increasing,
+// to insertions, which must hold oldCount and newCount entries. Returns false
+// if a list has an id more than once, or is NULL while not empty.
+bool dcflight_shadow_diff_children(const int32_t* oldIds, int32_t oldCount, const int32_t* newIds, int32_t newCount, int32_t* removals, int32_t* removalCount, int32_t* insertions, int32_t* insertionCount);
+
+// Applies a batch of layout props to a node. Returns the number of props
+// which changed its style, or -1 if there is no such node.
+int32_t dcflight_shadow_set_props(DCFlightShadowTree* tree, int32_t viewId, const DCFlightLayoutValue* values, int32_t count);
+
+// Sets or, given NULL, clears the measure callback of a leaf node
+bool dcflight_shadow_set_measure_callback(DCFlightShadowTree* tree, int32_t viewId, DCFlightMeasureCallback callback, void* context);
+bool dcflight_shadow_mark_dirty(DCFlightShadowTree* tree, int32_t viewId);
+// Sets the sizes of a measured node in each way its content wraps, by
+// increasing width, to measure it without calling back. A count of 0 clears
+// them.
+bool dcflight_shadow_set_intrinsic_sizes(DCFlightShadowTree* tree, int32_t viewId, const YGSize* sizes, int32_t count);
+
+// Makes a node lay out only the children within its scroll window, assuming
+// the others span estimatedExtent along its main axis
+bool dcflight_shadow_set_virtualized(DCFlightShadowTree* tree, int32_t viewId, bool virtualized, float estimatedExtent);
+// Returns false if the node does not virtualize its children
+bool dcflight_shadow_set_scroll_window(DCFlightShadowTree* tree, int32_t viewId, float offset, float extent, float overscan);
+
+// Marks a view which only groups its children for layout, to leave it out of
+// the mounted hierarchy when possible (see ShadowTree::setLayoutOnly)
+bool dcflight_shadow_set_layout_only(DCFlightShadowTree* tree, int32_t viewId, bool layoutOnly);
+bool dcflight_shadow_is_flattened(DCFlightShadowTree* tree, int32_t viewId);
+// Returns the nearest ancestor of a view which is not flattened, or -1
+int32_t dcflight_shadow_get_mounted_parent(DCFlightShadowTree* tree, int32_t viewId);
+
+// Lays out every root, and points updates at the frames, relative to the
+// mounted parent, which changed since the last call. They stay valid until
+// the tree is next modified.
+uint32_t dcflight_shadow_calculate_layout(DCFlightShadowTree* tree, float width, float height, const DCFlightLayoutUpdate** updates);
+
+// Finds the views containing a point or intersecting a rect, in the
+// coordinates of a view, and points viewIds at them: parents before their
+// children and siblings in order, so that the last view containing a point is
+// the one on top. They stay valid until the next query.
+uint32_t dcflight_shadow_query_point(DCFlightShadowTree* tree, int32_t viewId, float x, float y, const int32_t** viewIds);
+uint32_t dcflight_shadow_query_rect(DCFlightShadowTree* tree, int32_t viewId, float left, float top, float width, float height, const int32_t** viewIds);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // DCFLIGHT_SHADOW_TREE_FFI_H
@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) Dotcorr Studio. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+
+#include <dcflight/shadow/SpatialIndex.h>
+
+namespace dcflight::shadow {
+
+void SpatialIndex::assign(const std::vector<Rect>& frames) {
+  items_.clear();
+  Rect bounds{
+      std::numeric_limits<float>::infinity(),
+      std::numeric_limits<float>::infinity(),
+      -std::numeric_limits<float>::infinity(),
+      -std::numeric_limits<float>::infinity()};
+  for (size_t i = 0; i < frames.size(); i++) {
+    const Rect& frame = frames[i];
+    if (std::isnan(frame.left) || std::isnan(frame.top) ||
+        std::isnan(frame.right) || std::isnan(frame.bottom)) {
+      continue;
+    }
+    items_.push_back({frame, i});
+    bounds.left = std::min(bounds.left, frame.left);
+    bounds.top = std::min(bounds.top, frame.top);
+    bounds.right = std::max(bounds.right, frame.right);
+    bounds.bottom = std::max(bounds.bottom, frame.bottom);
+  }
+
+  isHorizontal_ = !items_.empty() &&
+      bounds.right - bounds.left > bounds.bottom - bounds.top;
+  std::sort(items_.begin(), items_.end(), [&](const auto& a, const auto& b) {
+    return getStart(a.frame) < getStart(b.frame);
+  });
+  maxEnds_.resize(items_.size());
+  build(0, items_.size());
+}
+
+void SpatialIndex::query(const Rect& area, std::vector<size_t>& children)
+    const {
+  const size_t first = children.size();
+  query(0, items_.size(), area, children);
+  // The tree visits frames by their start rather than in child order
+  std::sort(children.begin() + static_cast<ptrdiff_t>(first), children.end());
+}
+
+float SpatialIndex::build(size_t begin, size_t end) {
+  if (begin == end) {
+    return -std::numeric_limits<float>::infinity();
+  }
+  const size_t middle = begin + (end - begin) / 2;
+  maxEnds_[middle] = std::max(
+      {getEnd(items_[middle].frame),
+       build(begin, middle),
+       build(middle + 1, end)});
+  return maxEnds_[middle];
+}
+
+void SpatialIndex::query(
+    size_t begin,
+    size_t end,
+    const Rect& area,
+    std::vector<size_t>& children) const {
+  while (begin < end) {
+    const size_t middle = begin + (end - begin) / 2;
+    if (maxEnds_[middle] <= getStart(area)) {
+      return;
+    }
+    query(begin, middle, area, children);
+    // The items after this one start no earlier
+    if (getStart(items_[middle].frame) > getEnd(area)) {
+      return;
+    }
+    if (intersects(items_[middle].frame, area)) {
+      children.push_back(items_[middle].child);
+    }
+    begin = middle + 1;
+  }
+}
+
+} // namespace dcflight::shadow
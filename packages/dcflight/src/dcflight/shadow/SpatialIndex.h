@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) Dotcorr Studio. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace dcflight::shadow {
+
+// An area from its left and top edges to before its right and bottom edges
+struct Rect {
+  float left;
+  float top;
+  float right;
+  float bottom;
+};
+
+// Whether a frame overlaps an area or starts on its right or bottom edge, so
+// that the area of a point intersects the frames containing it
+inline bool intersects(const Rect& frame, const Rect& area) {
+  return frame.left <= area.right && frame.right > area.left &&
+      frame.top <= area.bottom && frame.bottom > area.top;
+}
+
+/**
+ * The frames of the children of a view, to find those within an area in
+ * O(log n + k) rather than by testing every child.
+ *
+ * Frames are sorted by their start along the axis the children spread the
+ * most on, and the sorted array is an implicit balanced tree whose nodes
+ * record the furthest end of the frames below them: an interval tree, in
+ * which subtrees ending before the area or starting after it are skipped.
+ *
+ * Frames with a NaN edge, of views not laid out yet, are left out.
+ */
+class SpatialIndex {
+ public:
+  // Replaces the frames indexed, `frames[i]` being the frame of child i
+  void assign(const std::vector<Rect>& frames);
+
+  // Appends the index of every child whose frame intersects `area` to
+  // `children`, in increasing order
+  void query(const Rect& area, std::vector<size_t>& children) const;
+
+ private:
+  struct Item {
+    Rect frame;
+    size_t child;
+  };
+
+  float getStart(const Rect& rect) const {
+    return isHorizontal_ ? rect.left : rect.top;
+  }
+
+  float getEnd(const Rect& rect) const {
+    return isHorizontal_ ? rect.right : rect.bottom;
+  }
+
+  float build(size_t begin, size_t end);
+  void query(
+      size_t begin,
+      size_t end,
+      const Rect& area,
+      std::vector<size_t>& children) const;
+
+  std::vector<Item> items_;
+  // The furthest end of the items of the subtree rooted at each item
+  std::vector<float> maxEnds_;
+  bool isHorizontal_ = false;
+};
+
+} // namespace dcflight::shadow
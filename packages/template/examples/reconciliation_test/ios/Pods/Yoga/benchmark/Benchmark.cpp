@@ -0,0 +1,1249 @@
+/*
+ * Copyright (c) Dotcorr Studio. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <thread>
+
+#include <Benchmark.h>
+#include <ThreadPool.h>
+#include <yoga/event/event.h>
+#include <yoga/node/Node.h>
+
+// Every allocation made by the process is counted so that the harness can
+// report allocations per layout pass.
+namespace {
+std::atomic<size_t> gAllocationCount{0};
+} // namespace
+
+void* operator new(size_t size) {
+  gAllocationCount.fetch_add(1, std::memory_order_relaxed);
+  if (void* ptr = std::malloc(size == 0 ? 1 : size)) {
+    return ptr;
+  }
+  throw std::bad_alloc{};
+}
+
+void operator delete(void* ptr) noexcept {
+  std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t /*size*/) noexcept {
+  std::free(ptr);
+}
+
+namespace facebook::yoga::benchmark {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr size_t kDefaultIterations = 50;
+
+// Counters reported by the most recent LayoutPassEnd event on this thread.
+thread_local LayoutData gLastLayoutData{};
+
+struct PassSample {
+  double nanos;
+  size_t allocations;
+  LayoutData layoutData;
+};
+
+struct ScenarioResult {
+  size_t nodeCount = 0;
+  std::vector<PassSample> samples;
+};
+
+PassSample timeLayout(YGNodeRef root, bool incremental = false) {
+  gLastLayoutData = {};
+  const size_t allocationsBefore =
+      gAllocationCount.load(std::memory_order_relaxed);
+  const auto start = Clock::now();
+  if (incremental) {
+    YGNodeCalculateLayoutIncremental(
+        root, kViewportWidth, kViewportHeight, YGDirectionLTR);
+  } else {
+    YGNodeCalculateLayout(
+        root, kViewportWidth, kViewportHeight, YGDirectionLTR);
+  }
+  const auto end = Clock::now();
+  return PassSample{
+      std::chrono::duration<double, std::nano>(end - start).count(),
+      gAllocationCount.load(std::memory_order_relaxed) - allocationsBefore,
+      gLastLayoutData};
+}
+
+ScenarioResult runScenario(
+    const Scenario& scenario,
+    YGConfigRef config,
+    size_t iterations) {
+  ScenarioResult result;
+  result.samples.reserve(iterations);
+
+  if (scenario.mutate) {
+    auto tree = scenario.build(config, nullptr);
+    result.nodeCount = tree.nodeCount;
+    YGNodeCalculateLayout(
+        tree.root, kViewportWidth, kViewportHeight, YGDirectionLTR);
+    for (size_t i = 0; i < iterations; i++) {
+      scenario.mutate(tree, i);
+      result.samples.push_back(timeLayout(tree.root));
+    }
+    YGNodeFreeRecursive(tree.root);
+  } else {
+    for (size_t i = 0; i < iterations; i++) {
+      auto tree = scenario.build(config, nullptr);
+      result.nodeCount = tree.nodeCount;
+      result.samples.push_back(timeLayout(tree.root));
+      YGNodeFreeRecursive(tree.root);
+    }
+  }
+  return result;
+}
+
+struct ChurnSample {
+  double nanos;
+  size_t allocations;
+};
+
+// Times building, laying out and tearing down a whole tree, as happens when a
+// screen is mounted and unmounted. With an arena the tree is released in bulk.
+ChurnSample timeChurn(
+    const Scenario& scenario,
+    YGConfigRef config,
+    bool useArena) {
+  const size_t allocationsBefore =
+      gAllocationCount.load(std::memory_order_relaxed);
+  const auto start = Clock::now();
+  YGNodeArenaRef arena = useArena ? YGNodeArenaNew() : nullptr;
+  auto tree = scenario.build(config, arena);
+  YGNodeCalculateLayout(
+      tree.root, kViewportWidth, kViewportHeight, YGDirectionLTR);
+  if (arena != nullptr) {
+    YGNodeArenaFree(arena);
+  } else {
+    YGNodeFreeRecursive(tree.root);
+  }
+  const auto end = Clock::now();
+  return ChurnSample{
+      std::chrono::duration<double, std::nano>(end - start).count(),
+      gAllocationCount.load(std::memory_order_relaxed) - allocationsBefore};
+}
+
+ChurnSample medianChurn(
+    const Scenario& scenario,
+    YGConfigRef config,
+    bool useArena,
+    size_t iterations) {
+  std::vector<ChurnSample> samples;
+  samples.reserve(iterations);
+  for (size_t i = 0; i < iterations; i++) {
+    samples.push_back(timeChurn(scenario, config, useArena));
+  }
+  std::sort(samples.begin(), samples.end(), [](const auto& a, const auto& b) {
+    return a.nanos < b.nanos;
+  });
+  return samples[samples.size() / 2];
+}
+
+void reportChurn(
+    const Scenario& scenario,
+    YGConfigRef config,
+    size_t iterations) {
+  const auto heap = medianChurn(scenario, config, false, iterations);
+  const auto arena = medianChurn(scenario, config, true, iterations);
+  std::printf(
+      "%-24s %12.0f %12zu %12.0f %12zu\n",
+      scenario.name,
+      heap.nanos / 1000.0,
+      heap.allocations,
+      arena.nanos / 1000.0,
+      arena.allocations);
+}
+
+// Executor backed by the ThreadPool stored in the config context.
+void runOnThreadPool(
+    YGConfigConstRef config,
+    YGTaskFunc task,
+    void* taskData,
+    size_t count) {
+  static_cast<ThreadPool*>(YGConfigGetContext(config))
+      ->run(task, taskData, count);
+}
+
+bool sameLayout(YGNodeConstRef a, YGNodeConstRef b) {
+  if (YGNodeLayoutGetLeft(a) != YGNodeLayoutGetLeft(b) ||
+      YGNodeLayoutGetTop(a) != YGNodeLayoutGetTop(b) ||
+      YGNodeLayoutGetWidth(a) != YGNodeLayoutGetWidth(b) ||
+      YGNodeLayoutGetHeight(a) != YGNodeLayoutGetHeight(b) ||
+      YGNodeGetChildCount(a) != YGNodeGetChildCount(b)) {
+    return false;
+  }
+  for (size_t i = 0; i < YGNodeGetChildCount(a); i++) {
+    if (!sameLayout(
+            YGNodeGetChild(const_cast<YGNodeRef>(a), i),
+            YGNodeGetChild(const_cast<YGNodeRef>(b), i))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+double medianLayoutNanos(
+    const Scenario& scenario,
+    YGConfigRef config,
+    size_t iterations) {
+  std::vector<double> samples;
+  samples.reserve(iterations);
+  for (size_t i = 0; i < iterations; i++) {
+    auto tree = scenario.build(config, nullptr);
+    samples.push_back(timeLayout(tree.root).nanos);
+    YGNodeFreeRecursive(tree.root);
+  }
+  std::sort(samples.begin(), samples.end());
+  return samples[samples.size() / 2];
+}
+
+// Compares layout on the calling thread against layout fanned out over a
+// thread pool, and checks that both produce the same results.
+void reportParallel(
+    const Scenario& scenario,
+    YGConfigRef serialConfig,
+    YGConfigRef parallelConfig,
+    size_t iterations) {
+  const double serial = medianLayoutNanos(scenario, serialConfig, iterations);
+  const double parallel =
+      medianLayoutNanos(scenario, parallelConfig, iterations);
+
+  auto serialTree = scenario.build(serialConfig, nullptr);
+  auto parallelTree = scenario.build(parallelConfig, nullptr);
+  YGNodeCalculateLayout(
+      serialTree.root, kViewportWidth, kViewportHeight, YGDirectionLTR);
+  YGNodeCalculateLayout(
+      parallelTree.root, kViewportWidth, kViewportHeight, YGDirectionLTR);
+  const bool matches = sameLayout(serialTree.root, parallelTree.root);
+  YGNodeFreeRecursive(serialTree.root);
+  YGNodeFreeRecursive(parallelTree.root);
+
+  std::printf(
+      "%-24s %12.0f %12.0f %8.2fx %8s\n",
+      scenario.name,
+      serial / 1000.0,
+      parallel / 1000.0,
+      serial / parallel,
+      matches ? "yes" : "NO");
+}
+
+struct TreeLayoutBatch {
+  std::vector<BenchmarkTree> trees;
+};
+
+void layoutTree(void* taskData, size_t index) {
+  auto& batch = *static_cast<TreeLayoutBatch*>(taskData);
+  YGNodeCalculateLayout(
+      batch.trees[index].root, kViewportWidth, kViewportHeight, YGDirectionLTR);
+}
+
+// Times laying out one independent tree per thread of the pool, as when
+// several screens are laid out at once, one after the other on the calling
+// thread and concurrently on the pool.
+double medianTreesNanos(
+    const Scenario& scenario,
+    YGConfigRef config,
+    ThreadPool* pool,
+    size_t treeCount,
+    size_t iterations) {
+  std::vector<double> samples;
+  samples.reserve(iterations);
+  TreeLayoutBatch batch;
+  for (size_t i = 0; i < iterations; i++) {
+    for (size_t j = 0; j < treeCount; j++) {
+      batch.trees.push_back(scenario.build(config, nullptr));
+    }
+    const auto start = Clock::now();
+    if (pool != nullptr) {
+      pool->run(layoutTree, &batch, treeCount);
+    } else {
+      for (size_t j = 0; j < treeCount; j++) {
+        layoutTree(&batch, j);
+      }
+    }
+    samples.push_back(
+        std::chrono::duration<double, std::nano>(Clock::now() - start)
+            .count());
+    for (auto& tree : batch.trees) {
+      YGNodeFreeRecursive(tree.root);
+    }
+    batch.trees.clear();
+  }
+  std::sort(samples.begin(), samples.end());
+  return samples[samples.size() / 2];
+}
+
+// Compares laying out independent trees one after the other against laying
+// them out concurrently, and checks that each concurrent layout matches.
+void reportConcurrentTrees(
+    const Scenario& scenario,
+    YGConfigRef config,
+    ThreadPool& pool,
+    size_t iterations) {
+  const size_t treeCount = pool.workerCount() + 1;
+  const double serial =
+      medianTreesNanos(scenario, config, nullptr, treeCount, iterations);
+  const double concurrent =
+      medianTreesNanos(scenario, config, &pool, treeCount, iterations);
+
+  auto serialTree = scenario.build(config, nullptr);
+  YGNodeCalculateLayout(
+      serialTree.root, kViewportWidth, kViewportHeight, YGDirectionLTR);
+  TreeLayoutBatch batch;
+  for (size_t i = 0; i < treeCount; i++) {
+    batch.trees.push_back(scenario.build(config, nullptr));
+  }
+  pool.run(layoutTree, &batch, treeCount);
+  bool matches = true;
+  for (auto& tree : batch.trees) {
+    matches = matches && sameLayout(serialTree.root, tree.root);
+    YGNodeFreeRecursive(tree.root);
+  }
+  YGNodeFreeRecursive(serialTree.root);
+
+  std::printf(
+      "%-24s %12.0f %12.0f %9.2fx %8s\n",
+      scenario.name,
+      serial / 1000.0,
+      concurrent / 1000.0,
+      serial / concurrent,
+      matches ? "yes" : "NO");
+}
+
+// Reads frames back the way a host walking the tree node by node does.
+size_t readFramesPerNode(YGNodeRef node, std::vector<float>& frames) {
+  if (!YGNodeGetHasNewLayout(node)) {
+    return 0;
+  }
+  YGNodeSetHasNewLayout(node, false);
+  frames.push_back(YGNodeLayoutGetLeft(node));
+  frames.push_back(YGNodeLayoutGetTop(node));
+  frames.push_back(YGNodeLayoutGetWidth(node));
+  frames.push_back(YGNodeLayoutGetHeight(node));
+  size_t count = 1;
+  for (size_t i = 0; i < YGNodeGetChildCount(node); i++) {
+    count += readFramesPerNode(YGNodeGetChild(node, i), frames);
+  }
+  return count;
+}
+
+// Compares reading every new frame of a freshly laid out tree back per node
+// against a single call to YGNodeLayoutCollectNewLayouts.
+void reportReadback(
+    const Scenario& scenario,
+    YGConfigRef config,
+    size_t iterations) {
+  std::vector<double> perNode;
+  std::vector<double> bulk;
+  std::vector<float> frames;
+  std::vector<void*> contexts;
+  std::vector<float> left, top, width, height;
+  for (size_t i = 0; i < iterations; i++) {
+    auto tree = scenario.build(config, nullptr);
+    YGNodeCalculateLayout(
+        tree.root, kViewportWidth, kViewportHeight, YGDirectionLTR);
+    frames.clear();
+    frames.reserve(tree.nodeCount * 4);
+    auto start = Clock::now();
+    readFramesPerNode(tree.root, frames);
+    perNode.push_back(
+        std::chrono::duration<double, std::nano>(Clock::now() - start)
+            .count());
+    YGNodeFreeRecursive(tree.root);
+
+    tree = scenario.build(config, nullptr);
+    YGNodeCalculateLayout(
+        tree.root, kViewportWidth, kViewportHeight, YGDirectionLTR);
+    contexts.resize(tree.nodeCount);
+    left.resize(tree.nodeCount);
+    top.resize(tree.nodeCount);
+    width.resize(tree.nodeCount);
+    height.resize(tree.nodeCount);
+    start = Clock::now();
+    YGNodeLayoutCollectNewLayouts(
+        tree.root,
+        tree.nodeCount,
+        contexts.data(),
+        left.data(),
+        top.data(),
+        width.data(),
+        height.data());
+    bulk.push_back(
+        std::chrono::duration<double, std::nano>(Clock::now() - start)
+            .count());
+    YGNodeFreeRecursive(tree.root);
+  }
+
+  std::sort(perNode.begin(), perNode.end());
+  std::sort(bulk.begin(), bulk.end());
+  std::printf(
+      "%-24s %12.1f %12.1f\n",
+      scenario.name,
+      perNode[perNode.size() / 2] / 1000.0,
+      bulk[bulk.size() / 2] / 1000.0);
+}
+
+void collectNodes(YGNodeRef node, std::vector<YGNodeRef>& nodes) {
+  nodes.push_back(node);
+  for (size_t i = 0; i < YGNodeGetChildCount(node); i++) {
+    collectNodes(YGNodeGetChild(node, i), nodes);
+  }
+}
+
+YGStyleUpdate
+styleUpdate(YGStyleProperty property, int index, YGUnit unit, float value) {
+  return {
+      static_cast<uint16_t>(property),
+      static_cast<uint8_t>(index),
+      static_cast<uint8_t>(unit),
+      value};
+}
+
+// Props a recycled list row might receive, alternating between two sets of
+// values so that every application changes the style.
+void setStylesPerSetter(YGNodeRef node, size_t iteration) {
+  const float offset = static_cast<float>(iteration % 2);
+  YGNodeStyleSetMargin(node, YGEdgeAll, 2.0f + offset);
+  YGNodeStyleSetPadding(node, YGEdgeHorizontal, 4.0f + offset);
+  YGNodeStyleSetPadding(node, YGEdgeVertical, 1.0f + offset);
+  YGNodeStyleSetBorder(node, YGEdgeBottom, offset);
+  YGNodeStyleSetMinHeight(node, 10.0f + offset);
+  YGNodeStyleSetFlexShrink(node, offset);
+  YGNodeStyleSetAlignSelf(node, offset == 0 ? YGAlignAuto : YGAlignStretch);
+  YGNodeStyleSetOverflow(
+      node, offset == 0 ? YGOverflowVisible : YGOverflowHidden);
+}
+
+// The updates matching setStylesPerSetter()
+void appendStyleUpdates(
+    std::vector<YGStyleUpdate>& updates,
+    size_t iteration) {
+  const float offset = static_cast<float>(iteration % 2);
+  const auto add = [&](YGStyleProperty property,
+                       int index,
+                       YGUnit unit,
+                       float value) {
+    updates.push_back(styleUpdate(property, index, unit, value));
+  };
+  add(YGStylePropertyMargin, YGEdgeAll, YGUnitPoint, 2.0f + offset);
+  add(YGStylePropertyPadding, YGEdgeHorizontal, YGUnitPoint, 4.0f + offset);
+  add(YGStylePropertyPadding, YGEdgeVertical, YGUnitPoint, 1.0f + offset);
+  add(YGStylePropertyBorder, YGEdgeBottom, YGUnitPoint, offset);
+  add(YGStylePropertyMinHeight, 0, YGUnitPoint, 10.0f + offset);
+  add(YGStylePropertyFlexShrink, 0, YGUnitUndefined, offset);
+  add(YGStylePropertyAlignSelf,
+      0,
+      YGUnitUndefined,
+      offset == 0 ? YGAlignAuto : YGAlignStretch);
+  add(YGStylePropertyOverflow,
+      0,
+      YGUnitUndefined,
+      offset == 0 ? YGOverflowVisible : YGOverflowHidden);
+}
+
+// Compares restyling every node of a laid out tree through the individual
+// setters against a single YGNodeStyleApplyUpdatesToNodes() call, and checks
+// that both produce the same layout.
+void reportStyleUpdates(
+    const Scenario& scenario,
+    YGConfigRef config,
+    size_t iterations) {
+  auto setterTree = scenario.build(config, nullptr);
+  auto batchTree = scenario.build(config, nullptr);
+  std::vector<YGNodeRef> setterNodes;
+  std::vector<YGNodeRef> batchNodes;
+  collectNodes(setterTree.root, setterNodes);
+  collectNodes(batchTree.root, batchNodes);
+
+  std::vector<double> perSetter;
+  std::vector<double> batch;
+  std::vector<YGStyleUpdate> updates;
+  std::vector<size_t> updateCounts;
+  for (size_t i = 0; i < iterations; i++) {
+    YGNodeCalculateLayout(
+        setterTree.root, kViewportWidth, kViewportHeight, YGDirectionLTR);
+    auto start = Clock::now();
+    for (YGNodeRef node : setterNodes) {
+      setStylesPerSetter(node, i);
+    }
+    perSetter.push_back(
+        std::chrono::duration<double, std::nano>(Clock::now() - start)
+            .count());
+
+    YGNodeCalculateLayout(
+        batchTree.root, kViewportWidth, kViewportHeight, YGDirectionLTR);
+    updates.clear();
+    updateCounts.clear();
+    for (size_t node = 0; node < batchNodes.size(); node++) {
+      const size_t before = updates.size();
+      appendStyleUpdates(updates, i);
+      updateCounts.push_back(updates.size() - before);
+    }
+    start = Clock::now();
+    YGNodeStyleApplyUpdatesToNodes(
+        batchNodes.data(),
+        batchNodes.size(),
+        updates.data(),
+        updateCounts.data());
+    batch.push_back(
+        std::chrono::duration<double, std::nano>(Clock::now() - start)
+            .count());
+  }
+
+  YGNodeCalculateLayout(
+      setterTree.root, kViewportWidth, kViewportHeight, YGDirectionLTR);
+  YGNodeCalculateLayout(
+      batchTree.root, kViewportWidth, kViewportHeight, YGDirectionLTR);
+  const bool matches = sameLayout(setterTree.root, batchTree.root);
+  YGNodeFreeRecursive(setterTree.root);
+  YGNodeFreeRecursive(batchTree.root);
+
+  std::sort(perSetter.begin(), perSetter.end());
+  std::sort(batch.begin(), batch.end());
+  std::printf(
+      "%-24s %12.1f %12.1f %8s\n",
+      scenario.name,
+      perSetter[perSetter.size() / 2] / 1000.0,
+      batch[batch.size() / 2] / 1000.0,
+      matches ? "yes" : "NO");
+}
+
+// A freshly pushed form screen, flattened for YGTreeBuild(): rows holding a
+// label and a field, below a padded column.
+struct FlatTree {
+  std::vector<int32_t> parents;
+  std::vector<YGStyleUpdate> styles;
+  std::vector<size_t> styleCounts;
+};
+
+FlatTree flatFormScreen(size_t rowCount) {
+  FlatTree tree;
+  const auto addNode = [&](int32_t parent,
+                           std::initializer_list<YGStyleUpdate> styles) {
+    tree.parents.push_back(parent);
+    tree.styles.insert(tree.styles.end(), styles);
+    tree.styleCounts.push_back(styles.size());
+    return static_cast<int32_t>(tree.parents.size() - 1);
+  };
+
+  const int32_t root = addNode(
+      -1,
+      {styleUpdate(
+           YGStylePropertyFlexDirection,
+           0,
+           YGUnitUndefined,
+           YGFlexDirectionColumn),
+       styleUpdate(YGStylePropertyPadding, YGEdgeAll, YGUnitPoint, 16.0f)});
+  for (size_t i = 0; i < rowCount; i++) {
+    const int32_t row = addNode(
+        root,
+        {styleUpdate(
+             YGStylePropertyFlexDirection,
+             0,
+             YGUnitUndefined,
+             YGFlexDirectionRow),
+         styleUpdate(
+             YGStylePropertyAlignItems, 0, YGUnitUndefined, YGAlignCenter),
+         styleUpdate(YGStylePropertyMargin, YGEdgeBottom, YGUnitPoint, 8.0f),
+         styleUpdate(YGStylePropertyHeight, 0, YGUnitPoint, 44.0f)});
+    addNode(
+        row,
+        {styleUpdate(YGStylePropertyWidth, 0, YGUnitPercent, 30.0f),
+         styleUpdate(YGStylePropertyMargin, YGEdgeRight, YGUnitPoint, 8.0f),
+         styleUpdate(YGStylePropertyHeight, 0, YGUnitPoint, 20.0f)});
+    addNode(
+        row,
+        {styleUpdate(YGStylePropertyFlexGrow, 0, YGUnitUndefined, 1.0f),
+         styleUpdate(YGStylePropertyHeight, 0, YGUnitPoint, 36.0f),
+         styleUpdate(YGStylePropertyBorder, YGEdgeAll, YGUnitPoint, 1.0f),
+         styleUpdate(
+             YGStylePropertyPadding, YGEdgeHorizontal, YGUnitPoint, 8.0f)});
+  }
+  return tree;
+}
+
+// Builds the tree node by node, as a host mounting a screen view by view does
+YGNodeRef buildPerNode(
+    const FlatTree& tree,
+    YGConfigRef config,
+    YGNodeArenaRef arena,
+    std::vector<YGNodeRef>& nodes) {
+  const YGStyleUpdate* styles = tree.styles.data();
+  for (size_t i = 0; i < tree.parents.size(); i++) {
+    nodes[i] = arena != nullptr ? YGNodeNewInArena(arena, config)
+                                : YGNodeNewWithConfig(config);
+    YGNodeStyleApplyUpdates(nodes[i], styles, tree.styleCounts[i]);
+    styles += tree.styleCounts[i];
+    if (tree.parents[i] >= 0) {
+      YGNodeRef parent = nodes[static_cast<size_t>(tree.parents[i])];
+      YGNodeInsertChild(parent, nodes[i], YGNodeGetChildCount(parent));
+    }
+  }
+  return nodes[0];
+}
+
+// Times building a form screen and laying it out for the first time, node by
+// node on the heap and in an arena, and with YGTreeBuild().
+void reportTreeBuild(size_t rowCount, YGConfigRef config, size_t iterations) {
+  const auto tree = flatFormScreen(rowCount);
+  std::vector<YGNodeRef> nodes(tree.parents.size());
+  std::vector<ChurnSample> heap;
+  std::vector<ChurnSample> arena;
+  std::vector<ChurnSample> bulk;
+  const auto time = [&](auto build) {
+    const size_t allocationsBefore =
+        gAllocationCount.load(std::memory_order_relaxed);
+    const auto start = Clock::now();
+    YGNodeArenaRef nodeArena = build();
+    const auto end = Clock::now();
+    const size_t allocations =
+        gAllocationCount.load(std::memory_order_relaxed) - allocationsBefore;
+    if (nodeArena != nullptr) {
+      YGNodeArenaFree(nodeArena);
+    } else {
+      YGNodeFreeRecursive(nodes[0]);
+    }
+    return ChurnSample{
+        std::chrono::duration<double, std::nano>(end - start).count(),
+        allocations};
+  };
+
+  for (size_t i = 0; i < iterations; i++) {
+    heap.push_back(time([&]() -> YGNodeArenaRef {
+      YGNodeCalculateLayout(
+          buildPerNode(tree, config, nullptr, nodes),
+          kViewportWidth,
+          kViewportHeight,
+          YGDirectionLTR);
+      return nullptr;
+    }));
+    arena.push_back(time([&]() {
+      YGNodeArenaRef nodeArena = YGNodeArenaNew();
+      YGNodeCalculateLayout(
+          buildPerNode(tree, config, nodeArena, nodes),
+          kViewportWidth,
+          kViewportHeight,
+          YGDirectionLTR);
+      return nodeArena;
+    }));
+    bulk.push_back(time([&]() {
+      YGNodeArenaRef nodeArena = YGNodeArenaNew();
+      YGNodeRef root = YGTreeBuild(
+          config,
+          nodeArena,
+          tree.parents.size(),
+          tree.parents.data(),
+          tree.styles.data(),
+          tree.styleCounts.data(),
+          nullptr,
+          nodes.data());
+      YGNodeCalculateLayout(
+          root, kViewportWidth, kViewportHeight, YGDirectionLTR);
+      return nodeArena;
+    }));
+  }
+
+  std::vector<YGNodeRef> builtNodes(tree.parents.size());
+  YGNodeRef perNodeRoot = buildPerNode(tree, config, nullptr, nodes);
+  YGNodeRef builtRoot = YGTreeBuild(
+      config,
+      nullptr,
+      tree.parents.size(),
+      tree.parents.data(),
+      tree.styles.data(),
+      tree.styleCounts.data(),
+      nullptr,
+      builtNodes.data());
+  YGNodeCalculateLayout(
+      perNodeRoot, kViewportWidth, kViewportHeight, YGDirectionLTR);
+  YGNodeCalculateLayout(
+      builtRoot, kViewportWidth, kViewportHeight, YGDirectionLTR);
+  const bool matches = sameLayout(perNodeRoot, builtRoot);
+  YGNodeFreeRecursive(perNodeRoot);
+  YGNodeFreeRecursive(builtRoot);
+
+  const auto median = [](std::vector<ChurnSample>& samples) {
+    std::sort(samples.begin(), samples.end(), [](const auto& a, const auto& b) {
+      return a.nanos < b.nanos;
+    });
+    return samples[samples.size() / 2];
+  };
+  const auto heapSample = median(heap);
+  const auto arenaSample = median(arena);
+  const auto bulkSample = median(bulk);
+  char name[32];
+  std::snprintf(name, sizeof(name), "form of %zu rows", rowCount);
+  std::printf(
+      "%-24s %10.0f %10zu %10.0f %10zu %10.0f %10zu %8s\n",
+      name,
+      heapSample.nanos / 1000.0,
+      heapSample.allocations,
+      arenaSample.nanos / 1000.0,
+      arenaSample.allocations,
+      bulkSample.nanos / 1000.0,
+      bulkSample.allocations,
+      matches ? "yes" : "NO");
+}
+
+// Compares laying out from the root against restarting layout at the dirty
+// layout boundaries after each mutation, on a config using boundaries, and
+// checks that both produce the same results.
+void reportBoundaries(
+    const Scenario& scenario,
+    YGConfigRef config,
+    size_t iterations) {
+  auto fullTree = scenario.build(config, nullptr);
+  auto incrementalTree = scenario.build(config, nullptr);
+  YGNodeCalculateLayout(
+      fullTree.root, kViewportWidth, kViewportHeight, YGDirectionLTR);
+  YGNodeCalculateLayout(
+      incrementalTree.root, kViewportWidth, kViewportHeight, YGDirectionLTR);
+
+  std::vector<PassSample> full;
+  std::vector<PassSample> incremental;
+  for (size_t i = 0; i < iterations; i++) {
+    scenario.mutate(fullTree, i);
+    full.push_back(timeLayout(fullTree.root));
+    scenario.mutate(incrementalTree, i);
+    incremental.push_back(timeLayout(incrementalTree.root, true));
+  }
+  const bool matches = sameLayout(fullTree.root, incrementalTree.root);
+  YGNodeFreeRecursive(fullTree.root);
+  YGNodeFreeRecursive(incrementalTree.root);
+
+  const auto byTime = [](const auto& a, const auto& b) {
+    return a.nanos < b.nanos;
+  };
+  std::sort(full.begin(), full.end(), byTime);
+  std::sort(incremental.begin(), incremental.end(), byTime);
+  const auto& fullMedian = full[full.size() / 2];
+  const auto& incrementalMedian = incremental[incremental.size() / 2];
+  std::printf(
+      "%-24s %10.1f %10d %10.1f %10d %8s\n",
+      scenario.name,
+      fullMedian.nanos / 1000.0,
+      fullMedian.layoutData.layouts,
+      incrementalMedian.nanos / 1000.0,
+      incrementalMedian.layoutData.layouts,
+      matches ? "yes" : "NO");
+}
+
+// Times relaying out a tree after each mutation of an incremental scenario.
+// Most of the tree comes from cache, so with and without rounding to the pixel
+// grid the difference is mostly the rounding pass.
+double medianRelayoutNanos(
+    const Scenario& scenario,
+    YGConfigRef config,
+    size_t iterations) {
+  auto tree = scenario.build(config, nullptr);
+  YGNodeCalculateLayout(
+      tree.root, kViewportWidth, kViewportHeight, YGDirectionLTR);
+  std::vector<double> samples;
+  samples.reserve(iterations);
+  for (size_t i = 0; i < iterations; i++) {
+    scenario.mutate(tree, i);
+    samples.push_back(timeLayout(tree.root).nanos);
+  }
+  YGNodeFreeRecursive(tree.root);
+  std::sort(samples.begin(), samples.end());
+  return samples[samples.size() / 2];
+}
+
+void reportPixelGrid(
+    const Scenario& scenario,
+    YGConfigRef unroundedConfig,
+    YGConfigRef roundedConfig,
+    size_t iterations) {
+  const double unrounded =
+      medianRelayoutNanos(scenario, unroundedConfig, iterations);
+  const double rounded =
+      medianRelayoutNanos(scenario, roundedConfig, iterations);
+  std::printf(
+      "%-24s %12.1f %12.1f %12.1f\n",
+      scenario.name,
+      unrounded / 1000.0,
+      rounded / 1000.0,
+      (rounded - unrounded) / 1000.0);
+}
+
+// Compares the first layout of a feed laid out in full against one whose rows
+// are virtualized to the viewport, then times scrolling the virtualized feed
+// one screen per pass and checks the rows laid out against the full layout.
+void reportVirtualizedFeed(
+    size_t rowCount,
+    YGConfigRef config,
+    size_t iterations) {
+  constexpr float kOverscan = kViewportHeight / 2.0f;
+
+  std::vector<PassSample> full;
+  std::vector<PassSample> virtualized;
+  for (size_t i = 0; i < iterations; i++) {
+    auto fullTree = buildFeed(config, rowCount, false);
+    full.push_back(timeLayout(fullTree.root));
+    YGNodeFreeRecursive(fullTree.root);
+
+    auto virtualizedTree = buildFeed(config, rowCount, true);
+    YGNodeSetVirtualizedWindow(
+        virtualizedTree.mutationTargets[0], 0.0f, kViewportHeight, kOverscan);
+    virtualized.push_back(timeLayout(virtualizedTree.root));
+    YGNodeFreeRecursive(virtualizedTree.root);
+  }
+
+  auto fullTree = buildFeed(config, rowCount, false);
+  auto virtualizedTree = buildFeed(config, rowCount, true);
+  YGNodeRef fullContent = fullTree.mutationTargets[0];
+  YGNodeRef content = virtualizedTree.mutationTargets[0];
+  YGNodeCalculateLayout(
+      fullTree.root, kViewportWidth, kViewportHeight, YGDirectionLTR);
+  YGNodeSetVirtualizedWindow(content, 0.0f, kViewportHeight, kOverscan);
+  YGNodeCalculateLayout(
+      virtualizedTree.root, kViewportWidth, kViewportHeight, YGDirectionLTR);
+
+  std::vector<PassSample> scroll;
+  bool matches = true;
+  for (size_t i = 0; i < iterations; i++) {
+    const float offset = static_cast<float>(i + 1) * kViewportHeight;
+    YGNodeSetVirtualizedWindow(content, offset, kViewportHeight, kOverscan);
+    scroll.push_back(timeLayout(virtualizedTree.root));
+
+    size_t first = 0;
+    size_t end = 0;
+    YGNodeGetVirtualizedLaidOutChildren(content, &first, &end);
+    for (size_t row = first; row < end; row++) {
+      if (!sameLayout(
+              YGNodeGetChild(fullContent, row), YGNodeGetChild(content, row))) {
+        matches = false;
+      }
+    }
+  }
+  YGNodeFreeRecursive(fullTree.root);
+  YGNodeFreeRecursive(virtualizedTree.root);
+
+  const auto median = [](std::vector<PassSample>& samples) {
+    std::sort(samples.begin(), samples.end(), [](const auto& a, const auto& b) {
+      return a.nanos < b.nanos;
+    });
+    return samples[samples.size() / 2];
+  };
+  const auto fullMedian = median(full);
+  const auto virtualizedMedian = median(virtualized);
+  const auto scrollMedian = median(scroll);
+  char name[32];
+  std::snprintf(name, sizeof(name), "feed of %zu rows", rowCount);
+  std::printf(
+      "%-24s %10.0f %10d %10.0f %10d %10.0f %10d %8s\n",
+      name,
+      fullMedian.nanos / 1000.0,
+      fullMedian.layoutData.layouts,
+      virtualizedMedian.nanos / 1000.0,
+      virtualizedMedian.layoutData.layouts,
+      scrollMedian.nanos / 1000.0,
+      scrollMedian.layoutData.layouts,
+      matches ? "yes" : "NO");
+}
+
+// Compares the first layout of a feed of a few kinds of identical rows, and
+// its layout again after rotating the screen, on a plain config against one
+// memoizing identical subtrees, and checks that both produce the same layout.
+void reportSubtreeMemo(
+    size_t rowCount,
+    size_t rowKinds,
+    YGConfigRef config,
+    YGConfigRef memoConfig,
+    size_t iterations) {
+  std::vector<PassSample> plain;
+  std::vector<PassSample> memoized;
+  std::vector<PassSample> plainRotated;
+  std::vector<PassSample> memoRotated;
+  bool matches = true;
+  for (size_t i = 0; i < iterations; i++) {
+    auto plainTree = buildTemplatedFeed(config, rowCount, rowKinds);
+    auto memoTree = buildTemplatedFeed(memoConfig, rowCount, rowKinds);
+    plain.push_back(timeLayout(plainTree.root));
+    memoized.push_back(timeLayout(memoTree.root));
+    matches = matches && sameLayout(plainTree.root, memoTree.root);
+
+    YGNodeStyleSetWidth(plainTree.root, kViewportHeight);
+    YGNodeStyleSetWidth(memoTree.root, kViewportHeight);
+    plainRotated.push_back(timeLayout(plainTree.root));
+    memoRotated.push_back(timeLayout(memoTree.root));
+    matches = matches && sameLayout(plainTree.root, memoTree.root);
+
+    YGNodeFreeRecursive(plainTree.root);
+    YGNodeFreeRecursive(memoTree.root);
+  }
+
+  const auto median = [](std::vector<PassSample>& samples) {
+    std::sort(samples.begin(), samples.end(), [](const auto& a, const auto& b) {
+      return a.nanos < b.nanos;
+    });
+    return samples[samples.size() / 2];
+  };
+  const auto memoMedian = median(memoized);
+  char name[32];
+  std::snprintf(name, sizeof(name), "%zu rows of %zu kinds", rowCount, rowKinds);
+  std::printf(
+      "%-24s %10.0f %10.0f %10.0f %10.0f %10d %10d %8s\n",
+      name,
+      median(plain).nanos / 1000.0,
+      memoMedian.nanos / 1000.0,
+      median(plainRotated).nanos / 1000.0,
+      median(memoRotated).nanos / 1000.0,
+      memoMedian.layoutData.layouts,
+      memoMedian.layoutData.memoizedSubtrees,
+      matches ? "yes" : "NO");
+}
+
+// Compares the first layout of rows of wrapping text measured by callbacks
+// against one answered by their intrinsic sizes, and checks that both produce
+// the same layout.
+void reportIntrinsicSizes(
+    size_t rowCount,
+    YGConfigRef config,
+    size_t iterations) {
+  std::vector<PassSample> measured;
+  std::vector<PassSample> intrinsic;
+  bool matches = true;
+  for (size_t i = 0; i < iterations; i++) {
+    auto measuredTree = buildWrappedText(config, rowCount, false);
+    auto intrinsicTree = buildWrappedText(config, rowCount, true);
+    measured.push_back(timeLayout(measuredTree.root));
+    intrinsic.push_back(timeLayout(intrinsicTree.root));
+    matches = matches && sameLayout(measuredTree.root, intrinsicTree.root);
+    YGNodeFreeRecursive(measuredTree.root);
+    YGNodeFreeRecursive(intrinsicTree.root);
+  }
+
+  const auto median = [](std::vector<PassSample>& samples) {
+    std::sort(samples.begin(), samples.end(), [](const auto& a, const auto& b) {
+      return a.nanos < b.nanos;
+    });
+    return samples[samples.size() / 2];
+  };
+  const auto measuredMedian = median(measured);
+  const auto intrinsicMedian = median(intrinsic);
+  char name[32];
+  std::snprintf(name, sizeof(name), "%zu wrapped texts", rowCount);
+  std::printf(
+      "%-24s %10.0f %10d %10.0f %10d %10d %8s\n",
+      name,
+      measuredMedian.nanos / 1000.0,
+      measuredMedian.layoutData.measureCallbacks,
+      intrinsicMedian.nanos / 1000.0,
+      intrinsicMedian.layoutData.measureCallbacks,
+      intrinsicMedian.layoutData.intrinsicSizeHits,
+      matches ? "yes" : "NO");
+}
+
+size_t countSpilledCaches(YGNodeRef node) {
+  size_t count =
+      resolveRef(node)->getLayout().cachedMeasurements.hasOverflow() ? 1 : 0;
+  for (size_t i = 0; i < YGNodeGetChildCount(node); i++) {
+    count += countSpilledCaches(YGNodeGetChild(node, i));
+  }
+  return count;
+}
+
+// Reports the memory taken by the nodes of a scenario, the nodes whose
+// measurement cache outgrew its inline entries, and the first layout time
+void reportFootprint(
+    const Scenario& scenario,
+    YGConfigRef config,
+    size_t iterations) {
+  std::vector<double> nanos;
+  size_t nodeCount = 0;
+  size_t spilled = 0;
+  for (size_t i = 0; i < iterations; i++) {
+    auto tree = scenario.build(config, nullptr);
+    nodeCount = tree.nodeCount;
+    nanos.push_back(timeLayout(tree.root).nanos);
+    spilled = countSpilledCaches(tree.root);
+    YGNodeFreeRecursive(tree.root);
+  }
+  std::sort(nanos.begin(), nanos.end());
+  const double median = nanos[nanos.size() / 2];
+  std::printf(
+      "%-24s %7zu %10.1f %10zu %12.0f %9.1f\n",
+      scenario.name,
+      nodeCount,
+      static_cast<double>(nodeCount * sizeof(yoga::Node)) / 1024.0,
+      spilled,
+      median / 1000.0,
+      median / static_cast<double>(nodeCount));
+}
+
+// Scenarios measured by the comparison tables, which run on plain configs
+bool isBaselineScenario(const Scenario& scenario) {
+  return !scenario.mutate && scenario.measureCacheCapacity == 0;
+}
+
+double ratio(int hits, int misses) {
+  const int total = hits + misses;
+  return total == 0 ? 0.0 : 100.0 * hits / total;
+}
+
+void report(const Scenario& scenario, ScenarioResult& result) {
+  auto& samples = result.samples;
+  std::sort(samples.begin(), samples.end(), [](const auto& a, const auto& b) {
+    return a.nanos < b.nanos;
+  });
+  const auto& median = samples[samples.size() / 2];
+  const auto& data = median.layoutData;
+
+  std::printf(
+      "%-24s %7zu %12.0f %9.1f %8.1f%% %8.1f%% %9d %9d %10zu\n",
+      scenario.name,
+      result.nodeCount,
+      median.nanos / 1000.0,
+      median.nanos / static_cast<double>(result.nodeCount),
+      ratio(data.cachedLayouts, data.layouts),
+      ratio(data.cachedMeasures, data.measures),
+      data.measureCallbacks,
+      data.measureCacheEvictions,
+      median.allocations);
+}
+
+} // namespace
+
+int run(int argc, char* argv[]) {
+  const size_t iterations = argc > 1
+      ? static_cast<size_t>(std::strtoul(argv[1], nullptr, 10))
+      : kDefaultIterations;
+  if (iterations == 0) {
+    std::fprintf(stderr, "usage: %s [iterations]\n", argv[0]);
+    return 1;
+  }
+
+  Event::subscribe([](YGNodeConstRef, Event::Type type, Event::Data data) {
+    if (type == Event::LayoutPassEnd) {
+      gLastLayoutData = *data.get<Event::LayoutPassEnd>().layoutData;
+    }
+  });
+
+  YGConfigRef config = YGConfigNew();
+  YGConfigSetPointScaleFactor(config, 3.0f);
+
+  std::printf(
+      "%-24s %7s %12s %9s %9s %9s %9s %9s %10s\n",
+      "scenario",
+      "nodes",
+      "us/pass",
+      "ns/node",
+      "layout$",
+      "measure$",
+      "callbacks",
+      "evictions",
+      "allocs");
+  for (const auto& scenario : allScenarios()) {
+    YGConfigSetMeasureCacheCapacity(config, scenario.measureCacheCapacity);
+    auto result = runScenario(scenario, config, iterations);
+    report(scenario, result);
+  }
+  YGConfigSetMeasureCacheCapacity(config, 0);
+
+  std::printf(
+      "\n%-24s %7s %10s %10s %12s %9s   (%zu bytes per node)\n",
+      "node footprint",
+      "nodes",
+      "node KB",
+      "spilled",
+      "us/pass",
+      "ns/node",
+      sizeof(yoga::Node));
+  for (const auto& scenario : allScenarios()) {
+    if (isBaselineScenario(scenario)) {
+      reportFootprint(scenario, config, iterations);
+    }
+  }
+
+  std::printf(
+      "\n%-24s %12s %12s %12s %12s\n",
+      "tree churn",
+      "heap us",
+      "heap allocs",
+      "arena us",
+      "arena allocs");
+  for (const auto& scenario : allScenarios()) {
+    if (isBaselineScenario(scenario)) {
+      reportChurn(scenario, config, iterations);
+    }
+  }
+
+  std::printf(
+      "\n%-24s %10s %10s %10s %10s %10s %10s %8s\n",
+      "first layout",
+      "heap us",
+      "allocs",
+      "arena us",
+      "allocs",
+      "build us",
+      "allocs",
+      "matches");
+  for (size_t rowCount : {100, 1000}) {
+    reportTreeBuild(rowCount, config, iterations);
+  }
+
+  std::printf(
+      "\n%-24s %10s %10s %10s %10s %10s %10s %8s\n",
+      "virtualized children",
+      "full us",
+      "layouts",
+      "virtual us",
+      "layouts",
+      "scroll us",
+      "layouts",
+      "matches");
+  for (size_t rowCount : {1000, 10000}) {
+    reportVirtualizedFeed(rowCount, config, iterations);
+  }
+
+  YGConfigRef memoConfig = YGConfigNew();
+  YGConfigSetPointScaleFactor(memoConfig, 3.0f);
+  YGConfigSetUseSubtreeMemoization(memoConfig, true);
+
+  std::printf(
+      "\n%-24s %10s %10s %10s %10s %10s %10s %8s\n",
+      "subtree memoization",
+      "plain us",
+      "memo us",
+      "rotate us",
+      "memo us",
+      "layouts",
+      "memoized",
+      "matches");
+  for (size_t rowKinds : {4, 32}) {
+    reportSubtreeMemo(1000, rowKinds, config, memoConfig, iterations);
+  }
+  YGConfigFree(memoConfig);
+
+  std::printf(
+      "\n%-24s %10s %10s %10s %10s %10s %8s\n",
+      "intrinsic sizes",
+      "measure us",
+      "callbacks",
+      "table us",
+      "callbacks",
+      "hits",
+      "matches");
+  for (size_t rowCount : {100, 1000}) {
+    reportIntrinsicSizes(rowCount, config, iterations);
+  }
+
+  std::printf(
+      "\n%-24s %12s %12s\n", "frame readback", "per-node us", "bulk us");
+  for (const auto& scenario : allScenarios()) {
+    if (isBaselineScenario(scenario)) {
+      reportReadback(scenario, config, iterations);
+    }
+  }
+
+  std::printf(
+      "\n%-24s %12s %12s %8s\n",
+      "style updates",
+      "setters us",
+      "batch us",
+      "matches");
+  for (const auto& scenario : allScenarios()) {
+    if (isBaselineScenario(scenario)) {
+      reportStyleUpdates(scenario, config, iterations);
+    }
+  }
+
+  YGConfigRef unroundedConfig = YGConfigNew();
+  YGConfigSetPointScaleFactor(unroundedConfig, 0.0f);
+
+  std::printf(
+      "\n%-24s %12s %12s %12s\n",
+      "relayout",
+      "unrounded us",
+      "rounded us",
+      "rounding us");
+  for (const auto& scenario : allScenarios()) {
+    if (scenario.mutate) {
+      reportPixelGrid(scenario, unroundedConfig, config, iterations);
+    }
+  }
+  YGConfigFree(unroundedConfig);
+
+  YGConfigRef boundaryConfig = YGConfigNew();
+  YGConfigSetPointScaleFactor(boundaryConfig, 3.0f);
+  YGConfigSetUseLayoutBoundaries(boundaryConfig, true);
+
+  std::printf(
+      "\n%-24s %10s %10s %10s %10s %8s\n",
+      "layout boundaries",
+      "full us",
+      "layouts",
+      "incr us",
+      "layouts",
+      "matches");
+  for (const auto& scenario : allScenarios()) {
+    if (scenario.mutate) {
+      reportBoundaries(scenario, boundaryConfig, iterations);
+    }
+  }
+  YGConfigFree(boundaryConfig);
+
+  const size_t threads = std::max(2u, std::thread::hardware_concurrency());
+  ThreadPool pool{threads - 1};
+  YGConfigRef parallelConfig = YGConfigNew();
+  YGConfigSetPointScaleFactor(parallelConfig, 3.0f);
+  YGConfigSetContext(parallelConfig, &pool);
+  YGConfigSetExecutor(parallelConfig, runOnThreadPool);
+
+  std::printf(
+      "\n%-24s %12s %12s %9s %8s   (%zu threads)\n",
+      "parallel layout",
+      "serial us",
+      "parallel us",
+      "speedup",
+      "matches",
+      threads);
+  for (const auto& scenario : allScenarios()) {
+    if (isBaselineScenario(scenario)) {
+      reportParallel(scenario, config, parallelConfig, iterations);
+    }
+  }
+
+  // The trees use a config without an executor, as the pool is busy laying
+  // out whole trees
+  std::printf(
+      "\n%-24s %12s %12s %9s %8s   (%zu trees)\n",
+      "concurrent trees",
+      "serial us",
+      "threaded us",
+      "speedup",
+      "matches",
+      threads);
+  for (const auto& scenario : allScenarios()) {
+    if (isBaselineScenario(scenario)) {
+      reportConcurrentTrees(scenario, config, pool, iterations);
+    }
+  }
+
+  YGConfigFree(parallelConfig);
+  YGConfigFree(config);
+  Event::reset();
+  return 0;
+}
+
+} // namespace facebook::yoga::benchmark
+
+int main(int argc, char* argv[]) {
+  return facebook::yoga::benchmark::run(argc, argv);
+}
@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) Dotcorr Studio. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+#include <yoga/Yoga.h>
+
+namespace facebook::yoga::benchmark {
+
+// A tree built for one scenario. `mutationTargets` are the nodes an
+// incremental scenario dirties between passes. Nodes are allocated from
+// `arena` when one is set.
+struct BenchmarkTree {
+  YGNodeArenaRef arena = nullptr;
+  YGNodeRef root = nullptr;
+  size_t nodeCount = 0;
+  std::vector<YGNodeRef> mutationTargets;
+};
+
+struct Scenario {
+  const char* name;
+  std::function<BenchmarkTree(YGConfigRef config, YGNodeArenaRef arena)> build;
+  // When set, the tree is built and laid out once, and every timed pass is
+  // preceded by a call to `mutate`. Otherwise every timed pass lays out a
+  // freshly built tree.
+  std::function<void(BenchmarkTree& tree, size_t iteration)> mutate;
+  // Capacity of the config's shared measure cache, or 0 to leave it disabled.
+  size_t measureCacheCapacity = 0;
+};
+
+// Screen-sized root constraints used by every scenario.
+constexpr float kViewportWidth = 390.0f;
+constexpr float kViewportHeight = 844.0f;
+
+std::vector<Scenario> allScenarios();
+
+// A scroll view over a feed of `rowCount` rows of wrapping text. When
+// `virtualized` is set, the content node, the only mutation target,
+// virtualizes its rows.
+BenchmarkTree buildFeed(YGConfigRef config, size_t rowCount, bool virtualized);
+
+// The same feed without virtualization, whose rows cycle through `rowKinds`
+// kinds of identical rows, like the cells of a list built from a few
+// templates.
+BenchmarkTree
+buildTemplatedFeed(YGConfigRef config, size_t rowCount, size_t rowKinds);
+
+// Rows of an avatar next to a text wrapping between words. With
+// `intrinsicSizes`, each text has the sizes of every way it wraps.
+BenchmarkTree
+buildWrappedText(YGConfigRef config, size_t rowCount, bool intrinsicSizes);
+
+} // namespace facebook::yoga::benchmark
@@ -0,0 +1,401 @@
+/*
+ * Copyright (c) Dotcorr Studio. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+#include <Benchmark.h>
+
+namespace facebook::yoga::benchmark {
+
+namespace {
+
+constexpr float kCharWidth = 7.5f;
+constexpr float kLineHeight = 18.0f;
+
+// Approximates a text measurement: the glyph count is stored in the node
+// context and wrapped into as many lines as the width constraint requires.
+YGSize measureText(
+    YGNodeConstRef node,
+    float width,
+    YGMeasureMode widthMode,
+    float /*height*/,
+    YGMeasureMode /*heightMode*/) {
+  const auto glyphs =
+      static_cast<float>(reinterpret_cast<uintptr_t>(YGNodeGetContext(node)));
+  const float naturalWidth = glyphs * kCharWidth;
+  float measuredWidth = naturalWidth;
+  if (widthMode == YGMeasureModeExactly) {
+    measuredWidth = width;
+  } else if (widthMode == YGMeasureModeAtMost) {
+    measuredWidth = std::min(naturalWidth, width);
+  }
+  const float lines = measuredWidth > 0.0f
+      ? std::max(1.0f, std::ceil(naturalWidth / measuredWidth))
+      : 1.0f;
+  return YGSize{measuredWidth, lines * kLineHeight};
+}
+
+// Approximates the measurement of a text wrapping between words of
+// kWordGlyphs glyphs, spaces included: the word count is stored in the node
+// context and laid out greedily in as many words per line as fit the width.
+constexpr size_t kWordGlyphs = 6;
+constexpr float kWordWidth = kWordGlyphs * kCharWidth;
+
+YGSize wrappedTextSize(size_t words, size_t wordsPerLine) {
+  wordsPerLine = std::clamp<size_t>(wordsPerLine, 1, words);
+  const size_t lines = (words + wordsPerLine - 1) / wordsPerLine;
+  return YGSize{
+      static_cast<float>(wordsPerLine) * kWordWidth,
+      static_cast<float>(lines) * kLineHeight};
+}
+
+YGSize measureWords(
+    YGNodeConstRef node,
+    float width,
+    YGMeasureMode widthMode,
+    float /*height*/,
+    YGMeasureMode /*heightMode*/) {
+  const auto words = reinterpret_cast<uintptr_t>(YGNodeGetContext(node));
+  if (widthMode == YGMeasureModeUndefined) {
+    return wrappedTextSize(words, words);
+  }
+  return wrappedTextSize(words, static_cast<size_t>(width / kWordWidth));
+}
+
+YGNodeRef newNode(YGConfigRef config, BenchmarkTree& tree) {
+  tree.nodeCount++;
+  return tree.arena != nullptr ? YGNodeNewInArena(tree.arena, config)
+                               : YGNodeNewWithConfig(config);
+}
+
+YGNodeRef newTextNode(YGConfigRef config, BenchmarkTree& tree, size_t glyphs) {
+  auto node = newNode(config, tree);
+  YGNodeSetContext(node, reinterpret_cast<void*>(glyphs));
+  // Measurements only depend on the glyph count, which makes it a content key
+  YGNodeSetMeasureCacheKey(node, glyphs);
+  YGNodeSetMeasureFunc(node, measureText);
+  return node;
+}
+
+void appendChild(YGNodeRef owner, YGNodeRef child) {
+  YGNodeInsertChild(owner, child, YGNodeGetChildCount(owner));
+}
+
+// Nested column containers, each with a header leaf, mirroring deeply wrapped
+// component trees.
+BenchmarkTree buildDeepColumn(YGConfigRef config, YGNodeArenaRef arena) {
+  constexpr size_t kDepth = 256;
+
+  BenchmarkTree tree{.arena = arena};
+  tree.root = newNode(config, tree);
+  YGNodeRef current = tree.root;
+  for (size_t depth = 0; depth < kDepth; depth++) {
+    YGNodeStyleSetPadding(current, YGEdgeAll, 1);
+
+    auto header = newNode(config, tree);
+    YGNodeStyleSetHeight(header, 4);
+    appendChild(current, header);
+
+    auto container = newNode(config, tree);
+    YGNodeStyleSetFlexDirection(container, YGFlexDirectionColumn);
+    YGNodeStyleSetFlexGrow(container, 1);
+    appendChild(current, container);
+    current = container;
+  }
+  return tree;
+}
+
+// A single wrapping row of heterogeneous chips, like a tag cloud or grid.
+BenchmarkTree buildWideWrap(YGConfigRef config, YGNodeArenaRef arena) {
+  constexpr size_t kChildren = 2000;
+
+  BenchmarkTree tree{.arena = arena};
+  tree.root = newNode(config, tree);
+  YGNodeStyleSetFlexDirection(tree.root, YGFlexDirectionRow);
+  YGNodeStyleSetFlexWrap(tree.root, YGWrapWrap);
+  YGNodeStyleSetAlignContent(tree.root, YGAlignFlexStart);
+  YGNodeStyleSetGap(tree.root, YGGutterAll, 4);
+  for (size_t i = 0; i < kChildren; i++) {
+    auto chip = newNode(config, tree);
+    YGNodeStyleSetWidth(chip, 40.0f + static_cast<float>(i % 7) * 11.5f);
+    YGNodeStyleSetHeight(chip, 24.0f + static_cast<float>(i % 3) * 4.0f);
+    YGNodeStyleSetMargin(chip, YGEdgeAll, 2);
+    appendChild(tree.root, chip);
+  }
+  return tree;
+}
+
+// A feed of rows, each an icon next to a shrinking text leaf and a badge.
+BenchmarkTree buildTextRows(YGConfigRef config, YGNodeArenaRef arena) {
+  constexpr size_t kRows = 500;
+
+  BenchmarkTree tree{.arena = arena};
+  tree.root = newNode(config, tree);
+  for (size_t i = 0; i < kRows; i++) {
+    auto row = newNode(config, tree);
+    YGNodeStyleSetFlexDirection(row, YGFlexDirectionRow);
+    YGNodeStyleSetAlignItems(row, YGAlignCenter);
+    YGNodeStyleSetPadding(row, YGEdgeHorizontal, 16);
+    YGNodeStyleSetPadding(row, YGEdgeVertical, 8);
+    appendChild(tree.root, row);
+
+    auto icon = newNode(config, tree);
+    YGNodeStyleSetWidth(icon, 24);
+    YGNodeStyleSetHeight(icon, 24);
+    YGNodeStyleSetMargin(icon, YGEdgeRight, 12);
+    appendChild(row, icon);
+
+    auto label = newTextNode(config, tree, 12 + (i * 37) % 90);
+    YGNodeStyleSetFlexShrink(label, 1);
+    YGNodeStyleSetFlexGrow(label, 1);
+    appendChild(row, label);
+    tree.mutationTargets.push_back(label);
+
+    auto badge = newTextNode(config, tree, 2);
+    YGNodeStyleSetMargin(badge, YGEdgeLeft, 8);
+    appendChild(row, badge);
+  }
+  return tree;
+}
+
+// Cards whose content is covered by absolutely positioned overlays (badges,
+// scrims, close buttons), exercising layoutAbsoluteDescendants.
+BenchmarkTree buildAbsoluteOverlays(
+    YGConfigRef config,
+    YGNodeArenaRef arena) {
+  constexpr size_t kCards = 200;
+
+  BenchmarkTree tree{.arena = arena};
+  tree.root = newNode(config, tree);
+  YGNodeStyleSetPadding(tree.root, YGEdgeAll, 8);
+  for (size_t i = 0; i < kCards; i++) {
+    auto card = newNode(config, tree);
+    YGNodeStyleSetPositionType(card, YGPositionTypeRelative);
+    YGNodeStyleSetMargin(card, YGEdgeBottom, 8);
+    appendChild(tree.root, card);
+
+    auto content = newTextNode(config, tree, 40 + i % 60);
+    YGNodeStyleSetMargin(content, YGEdgeAll, 12);
+    appendChild(card, content);
+
+    auto scrim = newNode(config, tree);
+    YGNodeStyleSetPositionType(scrim, YGPositionTypeAbsolute);
+    YGNodeStyleSetPosition(scrim, YGEdgeAll, 0);
+    appendChild(card, scrim);
+
+    auto badge = newNode(config, tree);
+    YGNodeStyleSetPositionType(badge, YGPositionTypeAbsolute);
+    YGNodeStyleSetPosition(badge, YGEdgeTop, 4);
+    YGNodeStyleSetPosition(badge, YGEdgeRight, 4);
+    YGNodeStyleSetWidthPercent(badge, 10);
+    YGNodeStyleSetAspectRatio(badge, 1);
+    appendChild(card, badge);
+  }
+  return tree;
+}
+
+// A tablet dashboard: several heavy panels side by side, each an independent
+// feed of text rows.
+BenchmarkTree buildDashboardPanels(YGConfigRef config, YGNodeArenaRef arena) {
+  constexpr size_t kPanels = 4;
+  constexpr size_t kRowsPerPanel = 250;
+
+  BenchmarkTree tree{.arena = arena};
+  tree.root = newNode(config, tree);
+  YGNodeStyleSetFlexDirection(tree.root, YGFlexDirectionRow);
+  for (size_t panelIndex = 0; panelIndex < kPanels; panelIndex++) {
+    auto panel = newNode(config, tree);
+    YGNodeStyleSetFlexGrow(panel, 1);
+    YGNodeStyleSetFlexBasis(panel, 0);
+    YGNodeStyleSetPadding(panel, YGEdgeAll, 8);
+    appendChild(tree.root, panel);
+
+    for (size_t i = 0; i < kRowsPerPanel; i++) {
+      auto row = newNode(config, tree);
+      YGNodeStyleSetFlexDirection(row, YGFlexDirectionRow);
+      YGNodeStyleSetAlignItems(row, YGAlignCenter);
+      YGNodeStyleSetPadding(row, YGEdgeVertical, 4);
+      appendChild(panel, row);
+
+      auto icon = newNode(config, tree);
+      YGNodeStyleSetWidth(icon, 16);
+      YGNodeStyleSetHeight(icon, 16);
+      YGNodeStyleSetMargin(icon, YGEdgeRight, 6);
+      appendChild(row, icon);
+
+      auto label =
+          newTextNode(config, tree, 8 + (panelIndex * 31 + i * 17) % 40);
+      YGNodeStyleSetFlexShrink(label, 1);
+      appendChild(row, label);
+    }
+  }
+  return tree;
+}
+
+// A long form of fixed size fields, each a label above an input box holding
+// the text typed so far. Fields are layout boundaries when enabled.
+BenchmarkTree buildForm(YGConfigRef config, YGNodeArenaRef arena) {
+  constexpr size_t kFields = 300;
+
+  BenchmarkTree tree{.arena = arena};
+  tree.root = newNode(config, tree);
+  YGNodeStyleSetPadding(tree.root, YGEdgeAll, 16);
+  for (size_t i = 0; i < kFields; i++) {
+    auto field = newNode(config, tree);
+    YGNodeStyleSetWidth(field, kViewportWidth - 32.0f);
+    YGNodeStyleSetHeight(field, 72);
+    YGNodeStyleSetMargin(field, YGEdgeBottom, 12);
+    appendChild(tree.root, field);
+
+    auto label = newTextNode(config, tree, 6 + i % 20);
+    YGNodeStyleSetMargin(label, YGEdgeBottom, 4);
+    appendChild(field, label);
+
+    auto box = newNode(config, tree);
+    YGNodeStyleSetFlexDirection(box, YGFlexDirectionRow);
+    YGNodeStyleSetFlexGrow(box, 1);
+    YGNodeStyleSetBorder(box, YGEdgeAll, 1);
+    YGNodeStyleSetPadding(box, YGEdgeHorizontal, 8);
+    appendChild(field, box);
+
+    auto input = newTextNode(config, tree, 1 + (i * 13) % 30);
+    YGNodeStyleSetFlexShrink(input, 1);
+    appendChild(box, input);
+    tree.mutationTargets.push_back(input);
+  }
+  return tree;
+}
+
+// Changes one text leaf per pass, as a keystroke or label update would.
+void dirtySingleLeaf(BenchmarkTree& tree, size_t iteration) {
+  auto target = tree.mutationTargets[(iteration * 7919) %
+                                     tree.mutationTargets.size()];
+  const auto glyphs = reinterpret_cast<uintptr_t>(YGNodeGetContext(target));
+  YGNodeSetContext(target, reinterpret_cast<void*>(glyphs % 90 + 1));
+  YGNodeSetMeasureCacheKey(target, glyphs % 90 + 1);
+  YGNodeMarkDirty(target);
+}
+
+// A feed row: an avatar next to a title and a body of wrapping text, whose
+// lengths follow `variant`
+void appendFeedRow(
+    YGConfigRef config,
+    BenchmarkTree& tree,
+    YGNodeRef content,
+    size_t variant) {
+  auto row = newNode(config, tree);
+  YGNodeStyleSetFlexDirection(row, YGFlexDirectionRow);
+  YGNodeStyleSetPadding(row, YGEdgeHorizontal, 16);
+  YGNodeStyleSetPadding(row, YGEdgeVertical, 12);
+  appendChild(content, row);
+
+  auto avatar = newNode(config, tree);
+  YGNodeStyleSetWidth(avatar, 40);
+  YGNodeStyleSetHeight(avatar, 40);
+  YGNodeStyleSetMargin(avatar, YGEdgeRight, 12);
+  appendChild(row, avatar);
+
+  auto body = newNode(config, tree);
+  YGNodeStyleSetFlexShrink(body, 1);
+  YGNodeStyleSetFlexGrow(body, 1);
+  appendChild(row, body);
+
+  appendChild(body, newTextNode(config, tree, 8 + (variant * 11) % 20));
+  appendChild(body, newTextNode(config, tree, 20 + (variant * 37) % 160));
+}
+
+BenchmarkTree newFeed(YGConfigRef config, bool virtualized) {
+  BenchmarkTree tree;
+  tree.root = newNode(config, tree);
+  YGNodeStyleSetOverflow(tree.root, YGOverflowScroll);
+
+  auto content = newNode(config, tree);
+  YGNodeStyleSetPadding(content, YGEdgeVertical, 8);
+  YGNodeStyleSetGap(content, YGGutterRow, 1);
+  if (virtualized) {
+    YGNodeSetVirtualizesChildren(content, true, 64.0f);
+  }
+  appendChild(tree.root, content);
+  tree.mutationTargets.push_back(content);
+  return tree;
+}
+
+} // namespace
+
+BenchmarkTree buildFeed(YGConfigRef config, size_t rowCount, bool virtualized) {
+  BenchmarkTree tree = newFeed(config, virtualized);
+  YGNodeRef content = tree.mutationTargets[0];
+  for (size_t i = 0; i < rowCount; i++) {
+    appendFeedRow(config, tree, content, i);
+    // A few rows are hidden, e.g. filtered out, and take no gap
+    if (i % 50 == 1) {
+      YGNodeStyleSetDisplay(YGNodeGetChild(content, i), YGDisplayNone);
+    }
+  }
+  return tree;
+}
+
+BenchmarkTree
+buildTemplatedFeed(YGConfigRef config, size_t rowCount, size_t rowKinds) {
+  BenchmarkTree tree = newFeed(config, false);
+  for (size_t i = 0; i < rowCount; i++) {
+    appendFeedRow(config, tree, tree.mutationTargets[0], i % rowKinds);
+  }
+  return tree;
+}
+
+BenchmarkTree
+buildWrappedText(YGConfigRef config, size_t rowCount, bool intrinsicSizes) {
+  BenchmarkTree tree;
+  tree.root = newNode(config, tree);
+  std::vector<YGSize> sizes;
+  for (size_t i = 0; i < rowCount; i++) {
+    auto row = newNode(config, tree);
+    YGNodeStyleSetFlexDirection(row, YGFlexDirectionRow);
+    YGNodeStyleSetPadding(row, YGEdgeAll, 12);
+    appendChild(tree.root, row);
+
+    auto avatar = newNode(config, tree);
+    YGNodeStyleSetWidth(avatar, 40);
+    YGNodeStyleSetHeight(avatar, 40);
+    YGNodeStyleSetMargin(avatar, YGEdgeRight, 12);
+    appendChild(row, avatar);
+
+    const size_t words = 2 + (i * 7) % 40;
+    auto text = newNode(config, tree);
+    YGNodeStyleSetFlexShrink(text, 1);
+    YGNodeSetContext(text, reinterpret_cast<void*>(words));
+    YGNodeSetMeasureFunc(text, measureWords);
+    if (intrinsicSizes) {
+      // One size per number of words on the longest line
+      sizes.clear();
+      for (size_t wordsPerLine = 1; wordsPerLine <= words; wordsPerLine++) {
+        sizes.push_back(wrappedTextSize(words, wordsPerLine));
+      }
+      YGNodeSetIntrinsicSizes(text, sizes.data(), sizes.size());
+    }
+    appendChild(row, text);
+  }
+  return tree;
+}
+
+std::vector<Scenario> allScenarios() {
+  return {
+      {"deep column stack", buildDeepColumn, nullptr},
+      {"wide wrapping row", buildWideWrap, nullptr},
+      {"text measure leaves", buildTextRows, nullptr},
+      {"absolute overlays", buildAbsoluteOverlays, nullptr},
+      {"dashboard panels", buildDashboardPanels, nullptr},
+      {"incremental dirty leaf", buildTextRows, dirtySingleLeaf},
+      {"form keystroke", buildForm, dirtySingleLeaf},
+      {"shared measure cache", buildTextRows, nullptr, 4096},
+  };
+}
+
+} // namespace facebook::yoga::benchmark
@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) Dotcorr Studio. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <ThreadPool.h>
+
+namespace facebook::yoga::benchmark {
+
+ThreadPool::ThreadPool(size_t workerCount) {
+  workers_.reserve(workerCount);
+  for (size_t i = 0; i < workerCount; i++) {
+    workers_.emplace_back([this] { work(); });
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock{mutex_};
+    stopping_ = true;
+  }
+  wake_.notify_all();
+  for (auto& worker : workers_) {
+    worker.join();
+  }
+}
+
+void ThreadPool::run(YGTaskFunc task, void* taskData, size_t count) {
+  std::lock_guard<std::mutex> runLock{runMutex_};
+  Job job{task, taskData, count};
+  {
+    // A worker may still be leaving an already completed job, and would pick
+    // up indices of the new one.
+    std::unique_lock<std::mutex> lock{mutex_};
+    done_.wait(lock, [this] { return activeWorkers_ == 0; });
+    job_ = job;
+    nextIndex_.store(0, std::memory_order_relaxed);
+    remaining_.store(count, std::memory_order_relaxed);
+    jobId_++;
+  }
+  wake_.notify_all();
+
+  drain(job);
+
+  std::unique_lock<std::mutex> lock{mutex_};
+  done_.wait(lock, [this] {
+    return remaining_.load(std::memory_order_acquire) == 0;
+  });
+}
+
+void ThreadPool::work() {
+  uint64_t seenJobId = 0;
+  std::unique_lock<std::mutex> lock{mutex_};
+  while (true) {
+    wake_.wait(lock, [&] { return stopping_ || jobId_ != seenJobId; });
+    if (stopping_) {
+      return;
+    }
+    seenJobId = jobId_;
+    const Job job = job_;
+    activeWorkers_++;
+    lock.unlock();
+
+    drain(job);
+
+    lock.lock();
+    activeWorkers_--;
+    done_.notify_all();
+  }
+}
+
+void ThreadPool::drain(const Job& job) {
+  for (size_t index = nextIndex_.fetch_add(1, std::memory_order_relaxed);
+       index < job.count;
+       index = nextIndex_.fetch_add(1, std::memory_order_relaxed)) {
+    job.task(job.taskData, index);
+    if (remaining_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      std::lock_guard<std::mutex> lock{mutex_};
+      done_.notify_all();
+    }
+  }
+}
+
+} // namespace facebook::yoga::benchmark
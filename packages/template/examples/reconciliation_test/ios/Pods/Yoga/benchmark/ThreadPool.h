@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) Dotcorr Studio. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <yoga/Yoga.h>
+
+namespace facebook::yoga::benchmark {
+
+// A fixed set of workers which, together with the calling thread, drain the
+// indices of one task at a time. Suitable as a YGExecutorFunc backend.
+class ThreadPool {
+ public:
+  explicit ThreadPool(size_t workerCount);
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  size_t workerCount() const {
+    return workers_.size();
+  }
+
+  void run(YGTaskFunc task, void* taskData, size_t count);
+
+ private:
+  struct Job {
+    YGTaskFunc task = nullptr;
+    void* taskData = nullptr;
+    size_t count = 0;
+  };
+
+  void work();
+  void drain(const Job& job);
+
+  std::mutex runMutex_;
+  std::mutex mutex_;
+  std::condition_variable wake_;
+  std::condition_variable done_;
+  std::vector<std::thread> workers_;
+
+  Job job_;
+  uint64_t jobId_ = 0;
+  size_t activeWorkers_ = 0;
+  bool stopping_ = false;
+  std::atomic<size_t> nextIndex_{0};
+  std::atomic<size_t> remaining_{0};
+};
+
+} // namespace facebook::yoga::benchmark
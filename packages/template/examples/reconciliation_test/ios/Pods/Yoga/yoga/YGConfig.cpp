@@ -32,6 +32,26 @@ bool YGConfigGetUseWebDefaults(const YGConfigConstRef config) {
   return resolveRef(config)->useWebDefaults();
 }
 
+void YGConfigSetUseLayoutBoundaries(
+    const YGConfigRef config,
+    const bool enabled) {
+  resolveRef(config)->setUseLayoutBoundaries(enabled);
+}
+
+bool YGConfigGetUseLayoutBoundaries(const YGConfigConstRef config) {
+  return resolveRef(config)->useLayoutBoundaries();
+}
+
+void YGConfigSetUseSubtreeMemoization(
+    const YGConfigRef config,
+    const bool enabled) {
+  resolveRef(config)->setUseSubtreeMemoization(enabled);
+}
+
+bool YGConfigGetUseSubtreeMemoization(const YGConfigConstRef config) {
+  return resolveRef(config)->useSubtreeMemoization();
+}
+
 void YGConfigSetPointScaleFactor(
     const YGConfigRef config,
     const float pixelsInPoint) {
@@ -90,3 +110,31 @@ void YGConfigSetCloneNodeFunc(
     const YGCloneNodeFunc callback) {
   resolveRef(config)->setCloneNodeCallback(callback);
 }
+
+void YGConfigSetMaxCachedMeasurements(
+    const YGConfigRef config,
+    const size_t maxCachedMeasurements) {
+  resolveRef(config)->setMaxCachedMeasurements(maxCachedMeasurements);
+}
+
+size_t YGConfigGetMaxCachedMeasurements(const YGConfigConstRef config) {
+  return resolveRef(config)->getMaxCachedMeasurements();
+}
+
+void YGConfigSetMeasureCacheCapacity(
+    const YGConfigRef config,
+    const size_t capacity) {
+  resolveRef(config)->setMeasureCacheCapacity(capacity);
+}
+
+void YGConfigClearMeasureCache(const YGConfigRef config) {
+  if (auto measureCache = resolveRef(config)->getMeasureCache()) {
+    measureCache->clear();
+  }
+}
+
+void YGConfigSetExecutor(
+    const YGConfigRef config,
+    const YGExecutorFunc executor) {
+  resolveRef(config)->setExecutor(executor);
+}
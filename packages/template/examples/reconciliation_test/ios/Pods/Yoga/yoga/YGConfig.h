@@ -59,6 +59,43 @@ YG_EXPORT void YGConfigSetUseWebDefaults(YGConfigRef config, bool enabled);
  */
 YG_EXPORT bool YGConfigGetUseWebDefaults(YGConfigConstRef config);
 
+/**
+ * Makes nodes whose size cannot depend on their content layout boundaries.
+ * A node is a boundary when it has a width and height in points, is not
+ * positioned absolutely, and is not aligned by its baseline (or on the path
+ * an ancestor's baseline is read from). Marking a node under a boundary dirty
+ * then stops at the boundary rather than dirtying every ancestor up to the
+ * root, and YGNodeCalculateLayoutIncremental() lays out just the dirty
+ * boundaries. Defaults to false.
+ */
+YG_EXPORT void YGConfigSetUseLayoutBoundaries(YGConfigRef config, bool enabled);
+
+/**
+ * Whether the configuration is set to use layout boundaries.
+ */
+YG_EXPORT bool YGConfigGetUseLayoutBoundaries(YGConfigConstRef config);
+
+/**
+ * Reuses the layout of a subtree for structurally identical subtrees laid out
+ * in the same constraints during a layout pass, such as the rows of a list.
+ * Subtrees are identified by a fingerprint hashing the style, node type and
+ * measure cache key (see YGNodeSetMeasureCacheKey()) of their nodes, kept
+ * until a node changes. A match is checked node by node, and its size and
+ * layout copied without running the flex algorithm or measure functions.
+ *
+ * Subtrees with measured leaves without a measure cache key, baseline
+ * functions, virtualized children or absolutely positioned descendants are
+ * always laid out. Defaults to false.
+ */
+YG_EXPORT void YGConfigSetUseSubtreeMemoization(
+    YGConfigRef config,
+    bool enabled);
+
+/**
+ * Whether the configuration is set to reuse the layout of identical subtrees.
+ */
+YG_EXPORT bool YGConfigGetUseSubtreeMemoization(YGConfigConstRef config);
+
 /**
  * Yoga will by deafult round final layout positions and dimensions to the
  * nearst point. `pointScaleFactor` controls the density of the grid used for
@@ -155,4 +192,69 @@ YG_EXPORT void YGConfigSetCloneNodeFunc(
     YGConfigRef config,
     YGCloneNodeFunc callback);
 
+/**
+ * Sets how many measurements of each node are cached, between 1 and 16.
+ * Once full, the least recently used measurement is replaced. Nodes measured
+ * under many distinct constraints in a single layout pass, such as wrapping
+ * text, benefit from a larger cache. Defaults to 8.
+ */
+YG_EXPORT void YGConfigSetMaxCachedMeasurements(
+    YGConfigRef config,
+    size_t maxCachedMeasurements);
+
+/**
+ * Gets the currently set measurement cache size.
+ */
+YG_EXPORT size_t YGConfigGetMaxCachedMeasurements(YGConfigConstRef config);
+
+/**
+ * Enables a measure function result cache shared by every node using the
+ * config, holding up to `capacity` measurements. Nodes opt in by supplying a
+ * content key with YGNodeSetMeasureCacheKey(), and measurements of nodes with
+ * the same key under the same constraints are then reused across nodes and
+ * across layout passes. Pass 0 to disable the cache (the default). Changing
+ * the capacity discards cached measurements.
+ */
+YG_EXPORT void YGConfigSetMeasureCacheCapacity(
+    YGConfigRef config,
+    size_t capacity);
+
+/**
+ * Discards every measurement of the shared measure cache, e.g. when fonts or
+ * other inputs of measure functions not covered by content keys change.
+ */
+YG_EXPORT void YGConfigClearMeasureCache(YGConfigRef config);
+
+/**
+ * Function pointer type for the work handed to a YGExecutorFunc.
+ */
+typedef void (*YGTaskFunc)(void* taskData, size_t index);
+
+/**
+ * Function pointer type for YGConfigSetExecutor. Must call `task` once for
+ * every index in [0, count), possibly concurrently, and only return once every
+ * call has completed.
+ */
+typedef void (*YGExecutorFunc)(
+    YGConfigConstRef config,
+    YGTaskFunc task,
+    void* taskData,
+    size_t count);
+
+/**
+ * Opts into laying out independent sibling subtrees in parallel. Once a
+ * container has resolved the sizes of its flex items, the layout of children
+ * which have children of their own is handed to the executor, and joined
+ * before the children are positioned. Layouts started from within an executor
+ * task run on the calling thread, so the executor is never re-entered.
+ *
+ * While an executor is set, measure, baseline and clone callbacks as well as
+ * event subscribers may be called concurrently from the executor's threads,
+ * and must be thread-safe. Defaults to NULL, which lays out on the calling
+ * thread only.
+ */
+YG_EXPORT void YGConfigSetExecutor(
+    YGConfigRef config,
+    YGExecutorFunc executor);
+
 YG_EXTERN_C_END
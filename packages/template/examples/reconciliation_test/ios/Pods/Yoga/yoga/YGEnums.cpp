@@ -223,6 +223,64 @@ const char* YGPositionTypeToString(const YGPositionType value) {
   return "unknown";
 }
 
+const char* YGStylePropertyToString(const YGStyleProperty value) {
+  switch (value) {
+    case YGStylePropertyDirection:
+      return "direction";
+    case YGStylePropertyFlexDirection:
+      return "flex-direction";
+    case YGStylePropertyJustifyContent:
+      return "justify-content";
+    case YGStylePropertyAlignContent:
+      return "align-content";
+    case YGStylePropertyAlignItems:
+      return "align-items";
+    case YGStylePropertyAlignSelf:
+      return "align-self";
+    case YGStylePropertyPositionType:
+      return "position-type";
+    case YGStylePropertyFlexWrap:
+      return "flex-wrap";
+    case YGStylePropertyOverflow:
+      return "overflow";
+    case YGStylePropertyDisplay:
+      return "display";
+    case YGStylePropertyFlex:
+      return "flex";
+    case YGStylePropertyFlexGrow:
+      return "flex-grow";
+    case YGStylePropertyFlexShrink:
+      return "flex-shrink";
+    case YGStylePropertyFlexBasis:
+      return "flex-basis";
+    case YGStylePropertyPosition:
+      return "position";
+    case YGStylePropertyMargin:
+      return "margin";
+    case YGStylePropertyPadding:
+      return "padding";
+    case YGStylePropertyBorder:
+      return "border";
+    case YGStylePropertyGap:
+      return "gap";
+    case YGStylePropertyAspectRatio:
+      return "aspect-ratio";
+    case YGStylePropertyWidth:
+      return "width";
+    case YGStylePropertyHeight:
+      return "height";
+    case YGStylePropertyMinWidth:
+      return "min-width";
+    case YGStylePropertyMinHeight:
+      return "min-height";
+    case YGStylePropertyMaxWidth:
+      return "max-width";
+    case YGStylePropertyMaxHeight:
+      return "max-height";
+  }
+  return "unknown";
+}
+
 const char* YGUnitToString(const YGUnit value) {
   switch (value) {
     case YGUnitUndefined:
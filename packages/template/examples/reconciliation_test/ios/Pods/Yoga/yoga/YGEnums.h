@@ -120,6 +120,35 @@ YG_ENUM_DECL(
     YGPositionTypeRelative,
     YGPositionTypeAbsolute)
 
+YG_ENUM_DECL(
+    YGStyleProperty,
+    YGStylePropertyDirection,
+    YGStylePropertyFlexDirection,
+    YGStylePropertyJustifyContent,
+    YGStylePropertyAlignContent,
+    YGStylePropertyAlignItems,
+    YGStylePropertyAlignSelf,
+    YGStylePropertyPositionType,
+    YGStylePropertyFlexWrap,
+    YGStylePropertyOverflow,
+    YGStylePropertyDisplay,
+    YGStylePropertyFlex,
+    YGStylePropertyFlexGrow,
+    YGStylePropertyFlexShrink,
+    YGStylePropertyFlexBasis,
+    YGStylePropertyPosition,
+    YGStylePropertyMargin,
+    YGStylePropertyPadding,
+    YGStylePropertyBorder,
+    YGStylePropertyGap,
+    YGStylePropertyAspectRatio,
+    YGStylePropertyWidth,
+    YGStylePropertyHeight,
+    YGStylePropertyMinWidth,
+    YGStylePropertyMinHeight,
+    YGStylePropertyMaxWidth,
+    YGStylePropertyMaxHeight)
+
 YG_ENUM_DECL(
     YGUnit,
     YGUnitUndefined,
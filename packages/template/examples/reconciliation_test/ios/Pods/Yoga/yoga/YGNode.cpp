@@ -55,7 +55,11 @@ void YGNodeFree(const YGNodeRef nodeRef) {
   node->clearChildren();
 
   Event::publish<Event::NodeDeallocation>(node, {YGNodeGetConfig(node)});
-  delete resolveRef(node);
+  if (auto arena = node->getArena()) {
+    arena->deleteNode(node);
+  } else {
+    delete node;
+  }
 }
 
 void YGNodeFreeRecursive(YGNodeRef rootRef) {
@@ -75,9 +79,14 @@ void YGNodeFreeRecursive(YGNodeRef rootRef) {
   YGNodeFree(root);
 }
 
-void YGNodeFinalize(const YGNodeRef node) {
+void YGNodeFinalize(const YGNodeRef nodeRef) {
+  const auto node = resolveRef(nodeRef);
   Event::publish<Event::NodeDeallocation>(node, {YGNodeGetConfig(node)});
-  delete resolveRef(node);
+  if (auto arena = node->getArena()) {
+    arena->deleteNode(node);
+  } else {
+    delete node;
+  }
 }
 
 void YGNodeReset(YGNodeRef node) {
@@ -93,6 +102,15 @@ void YGNodeCalculateLayout(
       resolveRef(node), ownerWidth, ownerHeight, scopedEnum(ownerDirection));
 }
 
+void YGNodeCalculateLayoutIncremental(
+    const YGNodeRef node,
+    const float ownerWidth,
+    const float ownerHeight,
+    const YGDirection ownerDirection) {
+  yoga::calculateLayoutIncremental(
+      resolveRef(node), ownerWidth, ownerHeight, scopedEnum(ownerDirection));
+}
+
 bool YGNodeGetHasNewLayout(YGNodeConstRef node) {
   return resolveRef(node)->getHasNewLayout();
 }
@@ -145,6 +163,9 @@ void YGNodeInsertChild(
   owner->insertChild(child, index);
   child->setOwner(owner);
   owner->markDirtyAndPropagate();
+  if (child->hasDirtyDescendant()) {
+    owner->markHasDirtyDescendant();
+  }
 }
 
 void YGNodeSwapChild(
@@ -156,6 +177,9 @@ void YGNodeSwapChild(
 
   owner->replaceChild(child, index);
   child->setOwner(owner);
+  if (child->hasDirtyDescendant()) {
+    owner->markHasDirtyDescendant();
+  }
 }
 
 void YGNodeRemoveChild(
@@ -245,6 +269,9 @@ void YGNodeSetChildren(
     owner->setChildren(childrenVector);
     for (yoga::Node* child : childrenVector) {
       child->setOwner(owner);
+      if (child->hasDirtyDescendant()) {
+        owner->markHasDirtyDescendant();
+      }
     }
     owner->markDirtyAndPropagate();
   }
@@ -287,6 +314,29 @@ void* YGNodeGetContext(YGNodeConstRef node) {
   return resolveRef(node)->getContext();
 }
 
+void YGNodeSetMeasureCacheKey(YGNodeRef node, uint64_t key) {
+  resolveRef(node)->setMeasureCacheKey(key);
+}
+
+uint64_t YGNodeGetMeasureCacheKey(YGNodeConstRef node) {
+  return resolveRef(node)->getMeasureCacheKey();
+}
+
+void YGNodeSetIntrinsicSizes(
+    YGNodeRef nodeRef,
+    const YGSize* sizes,
+    size_t count) {
+  const auto node = resolveRef(nodeRef);
+  node->setIntrinsicSizes(sizes, count);
+  if (node->hasMeasureFunc()) {
+    node->markDirtyAndPropagate();
+  }
+}
+
+bool YGNodeHasIntrinsicSizes(YGNodeConstRef node) {
+  return resolveRef(node)->getIntrinsicSizes() != nullptr;
+}
+
 void YGNodeSetMeasureFunc(YGNodeRef node, YGMeasureFunc measureFunc) {
   resolveRef(node)->setMeasureFunc(measureFunc);
 }
@@ -307,7 +357,7 @@ void YGNodeSetIsReferenceBaseline(YGNodeRef nodeRef, bool isReferenceBaseline) {
   const auto node = resolveRef(nodeRef);
   if (node->isReferenceBaseline() != isReferenceBaseline) {
     node->setIsReferenceBaseline(isReferenceBaseline);
-    node->markDirtyAndPropagate();
+    node->markStyleDirtyAndPropagate();
   }
 }
 
@@ -9,6 +9,7 @@
 
 #include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
 
 #include <yoga/YGConfig.h>
 #include <yoga/YGEnums.h>
@@ -73,6 +74,15 @@ YG_EXPORT void YGNodeReset(YGNodeRef node);
  *
  * YGNodeGetHasNewLayout() may be read to know if the layout of the node or its
  * subtrees may have changed since the last time YGNodeCalculate() was called.
+ *
+ * The only state layout shares between trees is the measure cache of their
+ * config (see YGConfigSetMeasureCacheCapacity()), which is synchronized, so
+ * disjoint trees may be laid out concurrently on different threads, including
+ * trees sharing a config. Measure, baseline and dirtied functions and event
+ * subscribers may then be called concurrently for different trees. A tree must
+ * only be laid out or modified by one thread at a time, and when it moves to
+ * another thread, e.g. after being laid out speculatively in the background,
+ * the hand-off must synchronize like any other shared data.
  */
 YG_EXPORT void YGNodeCalculateLayout(
     YGNodeRef node,
@@ -80,6 +90,27 @@ YG_EXPORT void YGNodeCalculateLayout(
     float availableHeight,
     YGDirection ownerDirection);
 
+/**
+ * Calculates the layout of the tree rooted at the given node like
+ * YGNodeCalculateLayout(), restarting layout at the dirty layout boundaries
+ * (see YGConfigSetUseLayoutBoundaries()) instead of at the root.
+ *
+ * When only nodes under boundaries changed, the root keeps its cached layout
+ * and each dirty boundary is laid out again in place, at the size and within
+ * the constraints of its last layout, while YGNodeCalculateLayout() lays out
+ * every node on the path from the root to the boundary. Otherwise the root is
+ * laid out as well, followed by the boundaries that pass did not reach.
+ *
+ * A boundary is rounded to the pixel grid from its last rounded position, so
+ * frames may differ from those of YGNodeCalculateLayout() by up to a physical
+ * pixel when positions are fractional.
+ */
+YG_EXPORT void YGNodeCalculateLayoutIncremental(
+    YGNodeRef node,
+    float availableWidth,
+    float availableHeight,
+    YGDirection ownerDirection);
+
 /**
  * Whether the given node may have new layout results. Must be reset by calling
  * YGNodeSetHasNewLayout().
@@ -220,6 +251,41 @@ YG_EXPORT void YGNodeSetMeasureFunc(YGNodeRef node, YGMeasureFunc measureFunc);
  */
 YG_EXPORT bool YGNodeHasMeasureFunc(YGNodeConstRef node);
 
+/**
+ * Sets a key identifying the content measured by the node's measure function
+ * (e.g. a hash of its text and text attributes), letting measurements be
+ * shared with other nodes of the same content through the cache enabled by
+ * YGConfigSetMeasureCacheCapacity(). The measure function must only depend on
+ * the key and the given constraints. 0 (the default) opts out of the cache.
+ */
+YG_EXPORT void YGNodeSetMeasureCacheKey(YGNodeRef node, uint64_t key);
+
+/**
+ * Returns the measure cache key, or 0 if none has been set.
+ */
+YG_EXPORT uint64_t YGNodeGetMeasureCacheKey(YGNodeConstRef node);
+
+/**
+ * Sets the sizes the content of a node with a measure function lays out at,
+ * one per width at which it lays out differently: e.g. the widest line and the
+ * height of each set of line breaks of a text. Sizes are ordered by increasing
+ * width, from the min-content size (the narrowest the content lays out at
+ * without overflowing) to the max-content size.
+ *
+ * Measurements then take the widest size fitting the available width without
+ * calling the measure function, which is only called for widths narrower than
+ * the min-content width and heights shorter than the content. The sizes are
+ * copied, and must be set again, like the node marked dirty, when the content
+ * changes. A count of 0 clears them.
+ */
+YG_EXPORT void
+YGNodeSetIntrinsicSizes(YGNodeRef node, const YGSize* sizes, size_t count);
+
+/**
+ * Whether intrinsic sizes are set.
+ */
+YG_EXPORT bool YGNodeHasIntrinsicSizes(YGNodeConstRef node);
+
 /**
  * @returns a defined offet to baseline (ascent).
  */
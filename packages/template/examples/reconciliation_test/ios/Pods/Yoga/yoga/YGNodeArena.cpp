@@ -0,0 +1,41 @@
+/*
+ * Copyright (c) Dotcorr Studio. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <yoga/Yoga.h>
+
+#include <yoga/debug/AssertFatal.h>
+#include <yoga/event/event.h>
+#include <yoga/node/Node.h>
+#include <yoga/node/NodeArena.h>
+
+using namespace facebook;
+using namespace facebook::yoga;
+
+YGNodeArenaRef YGNodeArenaNew(void) {
+  return new yoga::NodeArena{};
+}
+
+void YGNodeArenaFree(const YGNodeArenaRef arena) {
+  delete resolveRef(arena);
+}
+
+size_t YGNodeArenaGetNodeCount(const YGNodeArenaConstRef arena) {
+  return resolveRef(arena)->getNodeCount();
+}
+
+YGNodeRef YGNodeNewInArena(
+    const YGNodeArenaRef arena,
+    const YGConfigConstRef config) {
+  yoga::assertFatal(
+      arena != nullptr, "Tried to construct YGNode with null arena");
+  yoga::assertFatal(
+      config != nullptr, "Tried to construct YGNode with null config");
+  auto* node = resolveRef(arena)->newNode(resolveRef(config));
+  Event::publish<Event::NodeAllocation>(node, {config});
+
+  return node;
+}
@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) Dotcorr Studio. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <stddef.h>
+
+#include <yoga/YGConfig.h>
+#include <yoga/YGMacros.h>
+#include <yoga/YGNode.h>
+
+YG_EXTERN_C_BEGIN
+
+/**
+ * Handle to a mutable Yoga node arena.
+ */
+typedef struct YGNodeArena* YGNodeArenaRef;
+
+/**
+ * Handle to an immutable Yoga node arena.
+ */
+typedef const struct YGNodeArena* YGNodeArenaConstRef;
+
+/**
+ * Allocates a new arena. Nodes allocated from an arena, along with their child
+ * lists, are carved from large slabs instead of being heap allocated one by
+ * one. An arena is not thread-safe.
+ */
+YG_EXPORT YGNodeArenaRef YGNodeArenaNew(void);
+
+/**
+ * Frees the arena along with every node still allocated from it, without
+ * disconnecting them from their owners or children. Any node allocated from
+ * the arena must no longer be referenced by nodes outside of it.
+ */
+YG_EXPORT void YGNodeArenaFree(YGNodeArenaRef arena);
+
+/**
+ * Returns the number of live nodes allocated from the arena.
+ */
+YG_EXPORT size_t YGNodeArenaGetNodeCount(YGNodeArenaConstRef arena);
+
+/**
+ * Allocates a new Yoga node from the arena, with customized settings. The node
+ * may be freed individually with YGNodeFree() or YGNodeFreeRecursive(), which
+ * returns its storage to the arena for reuse. Nodes cloned from it with
+ * YGNodeClone() are heap allocated.
+ */
+YG_EXPORT YGNodeRef
+YGNodeNewInArena(YGNodeArenaRef arena, YGConfigConstRef config);
+
+YG_EXTERN_C_END
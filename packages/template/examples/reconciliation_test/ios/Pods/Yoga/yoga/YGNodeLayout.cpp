@@ -42,6 +42,59 @@ float getResolvedLayoutProperty(const YGNodeConstRef nodeRef, const Edge edge) {
   return (node->getLayout().*LayoutMember)(static_cast<PhysicalEdge>(edge));
 }
 
+struct NewLayoutArrays {
+  size_t capacity;
+  void** contexts;
+  float* left;
+  float* top;
+  float* width;
+  float* height;
+};
+
+// Returns whether every node of the subtree with a new layout was written.
+// A node is only written once, but flags whether its subtree did not fit, so
+// that the next call descends through it to the nodes which did not.
+bool collectNewLayouts(
+    yoga::Node* node,
+    const NewLayoutArrays& arrays,
+    size_t& count) {
+  if (node->getHasNewLayout()) {
+    if (count == arrays.capacity) {
+      return false;
+    }
+    const auto& layout = node->getLayout();
+    arrays.contexts[count] = node->getContext();
+    arrays.left[count] = layout.position(PhysicalEdge::Left);
+    arrays.top[count] = layout.position(PhysicalEdge::Top);
+    arrays.width[count] = layout.dimension(Dimension::Width);
+    arrays.height[count] = layout.dimension(Dimension::Height);
+    count++;
+    node->setHasNewLayout(false);
+  } else if (!node->hasPendingNewLayouts()) {
+    return true;
+  }
+
+  // A hidden node is written with its zeroed layout, but its descendants,
+  // which are not displayed, are not
+  bool isComplete = true;
+  if (node->style().display() != Display::None) {
+    // Only the children near the window of a virtualizing node were laid out
+    const auto& children = node->getChildren();
+    const auto virtualizedChildren = node->getVirtualizedChildren();
+    const size_t first = virtualizedChildren != nullptr
+        ? virtualizedChildren->getFirstLaidOutChild()
+        : 0;
+    const size_t end = virtualizedChildren != nullptr
+        ? virtualizedChildren->getEndLaidOutChild()
+        : children.size();
+    for (size_t i = first; i < end && isComplete; i++) {
+      isComplete = collectNewLayouts(children[i], arrays, count);
+    }
+  }
+  node->setHasPendingNewLayouts(!isComplete);
+  return isComplete;
+}
+
 } // namespace
 
 float YGNodeLayoutGetLeft(const YGNodeConstRef node) {
@@ -90,3 +143,17 @@ float YGNodeLayoutGetPadding(YGNodeConstRef node, YGEdge edge) {
   return getResolvedLayoutProperty<&LayoutResults::padding>(
       node, scopedEnum(edge));
 }
+
+size_t YGNodeLayoutCollectNewLayouts(
+    const YGNodeRef root,
+    const size_t capacity,
+    void** const contexts,
+    float* const left,
+    float* const top,
+    float* const width,
+    float* const height) {
+  size_t count = 0;
+  collectNewLayouts(
+      resolveRef(root), {capacity, contexts, left, top, width, height}, count);
+  return count;
+}
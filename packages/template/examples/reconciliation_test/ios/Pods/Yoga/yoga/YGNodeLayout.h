@@ -8,6 +8,7 @@
 #pragma once
 
 #include <stdbool.h>
+#include <stddef.h>
 
 #include <yoga/YGConfig.h>
 #include <yoga/YGEnums.h>
@@ -32,4 +33,30 @@ YG_EXPORT float YGNodeLayoutGetMargin(YGNodeConstRef node, YGEdge edge);
 YG_EXPORT float YGNodeLayoutGetBorder(YGNodeConstRef node, YGEdge edge);
 YG_EXPORT float YGNodeLayoutGetPadding(YGNodeConstRef node, YGEdge edge);
 
+/**
+ * Reads back the layout of every node under `root` (inclusive) which has a new
+ * layout, and clears its new layout flag, replacing a walk of the tree calling
+ * YGNodeGetHasNewLayout(), YGNodeLayoutGetLeft() etc. for each node.
+ *
+ * Entry `i` of each array describes one node: its context, and its position
+ * (relative to its parent) and dimensions. Nodes are visited in pre-order. The
+ * subtree of a node without a new layout is skipped. A node with
+ * `display: none` is written with its zeroed layout, so that its view can be
+ * hidden, but its descendants are skipped.
+ *
+ * At most `capacity` nodes are written, and nodes beyond that keep their flag,
+ * to be written by the next call. Arrays sized to the number of nodes in the
+ * tree always suffice.
+ *
+ * @returns the number of nodes written
+ */
+YG_EXPORT size_t YGNodeLayoutCollectNewLayouts(
+    YGNodeRef root,
+    size_t capacity,
+    void** contexts,
+    float* left,
+    float* top,
+    float* width,
+    float* height);
+
 YG_EXTERN_C_END
@@ -7,6 +7,8 @@
 
 #include <yoga/Yoga.h>
 #include <yoga/debug/AssertFatal.h>
+#include <yoga/debug/Log.h>
+#include <yoga/enums/StyleProperty.h>
 #include <yoga/node/Node.h>
 
 using namespace facebook;
@@ -14,24 +16,187 @@ using namespace facebook::yoga;
 
 namespace {
 
+template <auto GetterT, auto SetterT, typename ValueT>
+bool setStyle(Style& style, ValueT value) {
+  if ((style.*GetterT)() == value) {
+    return false;
+  }
+  (style.*SetterT)(value);
+  return true;
+}
+
+template <auto GetterT, auto SetterT, typename IdxT, typename ValueT>
+bool setStyle(Style& style, IdxT idx, ValueT value) {
+  if ((style.*GetterT)(idx) == value) {
+    return false;
+  }
+  (style.*SetterT)(idx, value);
+  return true;
+}
+
 template <auto GetterT, auto SetterT, typename ValueT>
 void updateStyle(YGNodeRef node, ValueT value) {
-  auto& style = resolveRef(node)->style();
-  if ((style.*GetterT)() != value) {
-    (style.*SetterT)(value);
-    resolveRef(node)->markDirtyAndPropagate();
+  if (setStyle<GetterT, SetterT>(resolveRef(node)->style(), value)) {
+    resolveRef(node)->markStyleDirtyAndPropagate();
   }
 }
 
 template <auto GetterT, auto SetterT, typename IdxT, typename ValueT>
 void updateStyle(YGNodeRef node, IdxT idx, ValueT value) {
-  auto& style = resolveRef(node)->style();
-  if ((style.*GetterT)(idx) != value) {
-    (style.*SetterT)(idx, value);
-    resolveRef(node)->markDirtyAndPropagate();
+  if (setStyle<GetterT, SetterT>(resolveRef(node)->style(), idx, value)) {
+    resolveRef(node)->markStyleDirtyAndPropagate();
   }
 }
 
+[[noreturn]] void fatalStyleUpdate(
+    const yoga::Node* node,
+    const char* message) {
+  yoga::log(node, LogLevel::Fatal, "%s\n", message);
+  yoga::fatalWithMessage(message);
+}
+
+template <HasOrdinality EnumT>
+EnumT keywordOf(const yoga::Node* node, const YGStyleUpdate& update) {
+  const auto ordinal = static_cast<int32_t>(update.value);
+  if (!(update.value >= 0 && update.value < ordinalCount<EnumT>() &&
+        static_cast<float>(ordinal) == update.value)) {
+    fatalStyleUpdate(node, "Style update has an invalid keyword");
+  }
+  return static_cast<EnumT>(ordinal);
+}
+
+template <HasOrdinality EnumT>
+EnumT indexOf(const yoga::Node* node, const YGStyleUpdate& update) {
+  if (update.index >= ordinalCount<EnumT>()) {
+    fatalStyleUpdate(
+        node, "Style update has an invalid edge or gutter");
+  }
+  return static_cast<EnumT>(update.index);
+}
+
+StyleLength lengthOf(
+    const yoga::Node* node,
+    const YGStyleUpdate& update,
+    bool allowsPercent,
+    bool allowsAuto) {
+  switch (update.unit) {
+    case YGUnitUndefined:
+      return value::undefined();
+    case YGUnitPoint:
+      return value::points(update.value);
+    case YGUnitPercent:
+      if (allowsPercent) {
+        return value::percent(update.value);
+      }
+      break;
+    case YGUnitAuto:
+      if (allowsAuto) {
+        return value::ofAuto();
+      }
+      break;
+  }
+  fatalStyleUpdate(node, "Style update has an invalid unit");
+}
+
+// Sets one property of the node's style, and returns whether it changed
+bool applyStyleUpdate(yoga::Node* node, const YGStyleUpdate& update) {
+  if (update.property >= ordinalCount<StyleProperty>()) {
+    fatalStyleUpdate(node, "Style update has an invalid property");
+  }
+  auto& style = node->style();
+  switch (static_cast<StyleProperty>(update.property)) {
+    case StyleProperty::Direction:
+      return setStyle<&Style::direction, &Style::setDirection>(
+          style, keywordOf<Direction>(node, update));
+    case StyleProperty::FlexDirection:
+      return setStyle<&Style::flexDirection, &Style::setFlexDirection>(
+          style, keywordOf<FlexDirection>(node, update));
+    case StyleProperty::JustifyContent:
+      return setStyle<&Style::justifyContent, &Style::setJustifyContent>(
+          style, keywordOf<Justify>(node, update));
+    case StyleProperty::AlignContent:
+      return setStyle<&Style::alignContent, &Style::setAlignContent>(
+          style, keywordOf<Align>(node, update));
+    case StyleProperty::AlignItems:
+      return setStyle<&Style::alignItems, &Style::setAlignItems>(
+          style, keywordOf<Align>(node, update));
+    case StyleProperty::AlignSelf:
+      return setStyle<&Style::alignSelf, &Style::setAlignSelf>(
+          style, keywordOf<Align>(node, update));
+    case StyleProperty::PositionType:
+      return setStyle<&Style::positionType, &Style::setPositionType>(
+          style, keywordOf<PositionType>(node, update));
+    case StyleProperty::FlexWrap:
+      return setStyle<&Style::flexWrap, &Style::setFlexWrap>(
+          style, keywordOf<Wrap>(node, update));
+    case StyleProperty::Overflow:
+      return setStyle<&Style::overflow, &Style::setOverflow>(
+          style, keywordOf<Overflow>(node, update));
+    case StyleProperty::Display:
+      return setStyle<&Style::display, &Style::setDisplay>(
+          style, keywordOf<Display>(node, update));
+    case StyleProperty::Flex:
+      return setStyle<&Style::flex, &Style::setFlex>(
+          style, FloatOptional{update.value});
+    case StyleProperty::FlexGrow:
+      return setStyle<&Style::flexGrow, &Style::setFlexGrow>(
+          style, FloatOptional{update.value});
+    case StyleProperty::FlexShrink:
+      return setStyle<&Style::flexShrink, &Style::setFlexShrink>(
+          style, FloatOptional{update.value});
+    case StyleProperty::FlexBasis:
+      return setStyle<&Style::flexBasis, &Style::setFlexBasis>(
+          style, lengthOf(node, update, true, true));
+    case StyleProperty::Position:
+      return setStyle<&Style::position, &Style::setPosition>(
+          style,
+          indexOf<Edge>(node, update),
+          lengthOf(node, update, true, false));
+    case StyleProperty::Margin:
+      return setStyle<&Style::margin, &Style::setMargin>(
+          style,
+          indexOf<Edge>(node, update),
+          lengthOf(node, update, true, true));
+    case StyleProperty::Padding:
+      return setStyle<&Style::padding, &Style::setPadding>(
+          style,
+          indexOf<Edge>(node, update),
+          lengthOf(node, update, true, false));
+    case StyleProperty::Border:
+      return setStyle<&Style::border, &Style::setBorder>(
+          style,
+          indexOf<Edge>(node, update),
+          lengthOf(node, update, false, false));
+    case StyleProperty::Gap:
+      return setStyle<&Style::gap, &Style::setGap>(
+          style,
+          indexOf<Gutter>(node, update),
+          lengthOf(node, update, false, false));
+    case StyleProperty::AspectRatio:
+      return setStyle<&Style::aspectRatio, &Style::setAspectRatio>(
+          style, FloatOptional{update.value});
+    case StyleProperty::Width:
+      return setStyle<&Style::dimension, &Style::setDimension>(
+          style, Dimension::Width, lengthOf(node, update, true, true));
+    case StyleProperty::Height:
+      return setStyle<&Style::dimension, &Style::setDimension>(
+          style, Dimension::Height, lengthOf(node, update, true, true));
+    case StyleProperty::MinWidth:
+      return setStyle<&Style::minDimension, &Style::setMinDimension>(
+          style, Dimension::Width, lengthOf(node, update, true, false));
+    case StyleProperty::MinHeight:
+      return setStyle<&Style::minDimension, &Style::setMinDimension>(
+          style, Dimension::Height, lengthOf(node, update, true, false));
+    case StyleProperty::MaxWidth:
+      return setStyle<&Style::maxDimension, &Style::setMaxDimension>(
+          style, Dimension::Width, lengthOf(node, update, true, false));
+    case StyleProperty::MaxHeight:
+      return setStyle<&Style::maxDimension, &Style::setMaxDimension>(
+          style, Dimension::Height, lengthOf(node, update, true, false));
+  }
+  return false;
+}
+
 } // namespace
 
 void YGNodeCopyStyle(YGNodeRef dstNode, YGNodeConstRef srcNode) {
@@ -40,7 +205,7 @@ void YGNodeCopyStyle(YGNodeRef dstNode, YGNodeConstRef srcNode) {
 
   if (dst->style() != src->style()) {
     dst->setStyle(src->style());
-    dst->markDirtyAndPropagate();
+    dst->markStyleDirtyAndPropagate();
   }
 }
 
@@ -383,3 +548,33 @@ void YGNodeStyleSetMaxHeightPercent(
 YGValue YGNodeStyleGetMaxHeight(const YGNodeConstRef node) {
   return (YGValue)resolveRef(node)->style().maxDimension(Dimension::Height);
 }
+
+size_t YGNodeStyleApplyUpdates(
+    const YGNodeRef nodeRef,
+    const YGStyleUpdate* updates,
+    const size_t count) {
+  const auto node = resolveRef(nodeRef);
+  size_t changed = 0;
+  for (size_t i = 0; i < count; i++) {
+    if (applyStyleUpdate(node, updates[i])) {
+      changed++;
+    }
+  }
+  if (changed > 0) {
+    node->markStyleDirtyAndPropagate();
+  }
+  return changed;
+}
+
+size_t YGNodeStyleApplyUpdatesToNodes(
+    const YGNodeRef* nodes,
+    const size_t nodeCount,
+    const YGStyleUpdate* updates,
+    const size_t* updateCounts) {
+  size_t changed = 0;
+  for (size_t i = 0; i < nodeCount; i++) {
+    changed += YGNodeStyleApplyUpdates(nodes[i], updates, updateCounts[i]);
+    updates += updateCounts[i];
+  }
+  return changed;
+}
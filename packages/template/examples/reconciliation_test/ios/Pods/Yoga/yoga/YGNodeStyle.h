@@ -8,6 +8,7 @@
 #pragma once
 
 #include <stddef.h>
+#include <stdint.h>
 
 #include <yoga/YGNode.h>
 #include <yoga/YGValue.h>
@@ -120,4 +121,44 @@ YG_EXPORT YGValue YGNodeStyleGetMaxHeight(YGNodeConstRef node);
 YG_EXPORT void YGNodeStyleSetAspectRatio(YGNodeRef node, float aspectRatio);
 YG_EXPORT float YGNodeStyleGetAspectRatio(YGNodeConstRef node);
 
+/**
+ * One style property to set, as the YGNodeStyleSet* function for it would.
+ *
+ * `property` is a YGStyleProperty. `index` is the YGEdge of position, margin,
+ * padding and border, or the YGGutter of gap, and is ignored otherwise.
+ * `unit` is the YGUnit of a length, which must be one the setters accept,
+ * e.g. not YGUnitPercent for border. It is ignored for numbers such as flex
+ * grow, and for keywords such as flex direction, whose `value` is the value
+ * of the Yoga enum.
+ */
+typedef struct YGStyleUpdate {
+  uint16_t property;
+  uint8_t index;
+  uint8_t unit;
+  float value;
+} YGStyleUpdate;
+
+/**
+ * Applies `count` style updates to a node in order, comparing each against the
+ * current style, and marks the node dirty once if any of them changed it.
+ *
+ * @returns the number of updates which changed the style
+ */
+YG_EXPORT size_t YGNodeStyleApplyUpdates(
+    YGNodeRef node,
+    const YGStyleUpdate* updates,
+    size_t count);
+
+/**
+ * Applies style updates to `nodeCount` nodes, as YGNodeStyleApplyUpdates()
+ * does. Node `i` takes the next `updateCounts[i]` entries of `updates`.
+ *
+ * @returns the number of updates which changed a style
+ */
+YG_EXPORT size_t YGNodeStyleApplyUpdatesToNodes(
+    const YGNodeRef* nodes,
+    size_t nodeCount,
+    const YGStyleUpdate* updates,
+    const size_t* updateCounts);
+
 YG_EXTERN_C_END
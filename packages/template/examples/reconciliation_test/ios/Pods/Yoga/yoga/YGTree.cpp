@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) Dotcorr Studio. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <vector>
+
+#include <yoga/Yoga.h>
+
+#include <yoga/debug/AssertFatal.h>
+#include <yoga/event/event.h>
+#include <yoga/node/Node.h>
+#include <yoga/node/NodeArena.h>
+
+using namespace facebook;
+using namespace facebook::yoga;
+
+YGNodeRef YGTreeBuild(
+    const YGConfigConstRef config,
+    const YGNodeArenaRef arena,
+    const size_t nodeCount,
+    const int32_t* parents,
+    const YGStyleUpdate* styles,
+    const size_t* styleCounts,
+    void* const* contexts,
+    YGNodeRef* nodes) {
+  yoga::assertFatal(
+      config != nullptr, "Tried to construct YGNode with null config");
+  yoga::assertFatal(
+      nodeCount > 0 && parents[0] < 0, "Tried to build a tree without root");
+
+  std::vector<size_t> childCounts(nodeCount);
+  for (size_t i = 1; i < nodeCount; i++) {
+    yoga::assertFatal(
+        parents[i] >= 0 && static_cast<size_t>(parents[i]) < i,
+        "The parent of a node must come before it");
+    childCounts[static_cast<size_t>(parents[i])]++;
+  }
+
+  if (arena != nullptr) {
+    resolveRef(arena)->newNodes(resolveRef(config), nodeCount, nodes);
+  } else {
+    for (size_t i = 0; i < nodeCount; i++) {
+      nodes[i] = new yoga::Node{resolveRef(config)};
+    }
+  }
+
+  for (size_t i = 0; i < nodeCount; i++) {
+    Event::publish<Event::NodeAllocation>(nodes[i], {config});
+    if (contexts != nullptr) {
+      YGNodeSetContext(nodes[i], contexts[i]);
+    }
+    if (styleCounts != nullptr) {
+      YGNodeStyleApplyUpdates(nodes[i], styles, styleCounts[i]);
+      styles += styleCounts[i];
+    }
+    if (childCounts[i] > 0) {
+      resolveRef(nodes[i])->reserveChildren(childCounts[i]);
+    }
+  }
+
+  // Nodes are new, so they only need the dirty flag YGNodeInsertChild() sets
+  for (size_t i = 1; i < nodeCount; i++) {
+    auto parent = resolveRef(nodes[static_cast<size_t>(parents[i])]);
+    auto child = resolveRef(nodes[i]);
+    parent->insertChild(child, parent->getChildCount());
+    child->setOwner(parent);
+    parent->setDirty(true);
+  }
+  return nodes[0];
+}
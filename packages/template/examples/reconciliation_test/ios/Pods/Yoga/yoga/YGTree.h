@@ -0,0 +1,48 @@
+/*
+ * Copyright (c) Dotcorr Studio. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <yoga/YGConfig.h>
+#include <yoga/YGMacros.h>
+#include <yoga/YGNode.h>
+#include <yoga/YGNodeArena.h>
+#include <yoga/YGNodeStyle.h>
+
+YG_EXTERN_C_BEGIN
+
+/**
+ * Builds a whole tree of `nodeCount` nodes in one call, replacing a
+ * YGNodeNewWithConfig(), YGNodeInsertChild() and style setter call per node.
+ *
+ * Node 0 is the root, whose entry in `parents` must be -1. Every other node
+ * `i` is a child of node `parents[i]`, which must come before it, and
+ * children are ordered by index. Node `i` takes the next `styleCounts[i]`
+ * entries of `styles`, applied as by YGNodeStyleApplyUpdates(), and the
+ * context `contexts[i]`. `styles` and `styleCounts`, or `contexts`, may be
+ * NULL to leave every node with the default style, or without a context.
+ *
+ * Nodes are allocated from adjacent slots of `arena` or, given NULL, on the
+ * heap, and each child list is allocated once at its final size. The nodes
+ * are written to `nodes`.
+ *
+ * @returns the root
+ */
+YG_EXPORT YGNodeRef YGTreeBuild(
+    YGConfigConstRef config,
+    YGNodeArenaRef arena,
+    size_t nodeCount,
+    const int32_t* parents,
+    const YGStyleUpdate* styles,
+    const size_t* styleCounts,
+    void* const* contexts,
+    YGNodeRef* nodes);
+
+YG_EXTERN_C_END
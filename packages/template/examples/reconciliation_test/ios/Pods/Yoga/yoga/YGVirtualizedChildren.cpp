@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) Dotcorr Studio. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <algorithm>
+
+#include <yoga/Yoga.h>
+
+#include <yoga/debug/AssertFatal.h>
+#include <yoga/node/Node.h>
+
+using namespace facebook;
+using namespace facebook::yoga;
+
+namespace {
+
+VirtualizedChildren& getVirtualizedChildren(const yoga::Node* node) {
+  yoga::assertFatalWithNode(
+      node,
+      node->getVirtualizedChildren() != nullptr,
+      "Node does not virtualize its children");
+  return *node->getVirtualizedChildren();
+}
+
+} // namespace
+
+void YGNodeSetVirtualizesChildren(
+    const YGNodeRef nodeRef,
+    const bool virtualizesChildren,
+    const float estimatedChildExtent) {
+  const auto node = resolveRef(nodeRef);
+  const auto virtualizedChildren = node->getVirtualizedChildren();
+  const bool changed = virtualizedChildren == nullptr
+      ? virtualizesChildren
+      : !virtualizesChildren ||
+          virtualizedChildren->getEstimatedExtent() != estimatedChildExtent;
+  if (changed) {
+    node->setVirtualizesChildren(virtualizesChildren, estimatedChildExtent);
+    node->markStyleDirtyAndPropagate();
+  }
+}
+
+bool YGNodeGetVirtualizesChildren(const YGNodeConstRef node) {
+  return resolveRef(node)->getVirtualizedChildren() != nullptr;
+}
+
+void YGNodeSetVirtualizedWindow(
+    const YGNodeRef nodeRef,
+    const float offset,
+    const float extent,
+    const float overscan) {
+  const auto node = resolveRef(nodeRef);
+  auto& virtualizedChildren = getVirtualizedChildren(node);
+  virtualizedChildren.setWindow(offset, extent, overscan);
+
+  // The children in the window were laid out if they are within the laid out
+  // ones, as those kept their extent since
+  const size_t first = virtualizedChildren.getChildAtOffset(
+      virtualizedChildren.getWindowStart());
+  const size_t last = virtualizedChildren.getChildAtOffset(
+      virtualizedChildren.getWindowEnd());
+  const size_t end = std::min(last + 1, node->getChildCount());
+  if (first < virtualizedChildren.getFirstLaidOutChild() ||
+      end > virtualizedChildren.getEndLaidOutChild()) {
+    node->markDirtyAndPropagate();
+  }
+}
+
+void YGNodeGetVirtualizedLaidOutChildren(
+    const YGNodeConstRef node,
+    size_t* const first,
+    size_t* const end) {
+  const auto& virtualizedChildren = getVirtualizedChildren(resolveRef(node));
+  *first = virtualizedChildren.getFirstLaidOutChild();
+  *end = virtualizedChildren.getEndLaidOutChild();
+}
+
+float YGNodeGetVirtualizedChildOffset(
+    const YGNodeRef nodeRef,
+    const size_t index) {
+  const auto node = resolveRef(nodeRef);
+  yoga::assertFatalWithNode(
+      node, index <= node->getChildCount(), "Child index out of range");
+  return getVirtualizedChildren(node).getChildOffset(index);
+}
+
+size_t YGNodeGetVirtualizedChildAtOffset(
+    const YGNodeRef node,
+    const float offset) {
+  return getVirtualizedChildren(resolveRef(node)).getChildAtOffset(offset);
+}
+
+float YGNodeGetVirtualizedContentExtent(const YGNodeRef node) {
+  return getVirtualizedChildren(resolveRef(node)).getTotalExtent();
+}
@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) Dotcorr Studio. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include <yoga/YGMacros.h>
+#include <yoga/YGNode.h>
+
+YG_EXTERN_C_BEGIN
+
+/**
+ * Sets whether the node virtualizes its children, for long scrolling content
+ * such as a feed. Such a node only lays out the children overlapping the
+ * window set with YGNodeSetVirtualizedWindow(), and stacks them along its main
+ * axis at offsets taken from the extent of every child before them: the one
+ * it was last laid out at, or `estimatedChildExtent` (margins included) until
+ * it is first laid out. Offsets, the child at an offset and the content size
+ * are O(log n) in the number of children.
+ *
+ * Children are laid out one after the other: flexing, wrapping, justification
+ * and baseline alignment do not apply, and absolute children are stacked like
+ * the others. A child is stretched across the cross axis or aligned to its
+ * start, center or end. The node spans the available cross size, if any, and
+ * the extent of every child along the main axis.
+ *
+ * Children outside the window keep their last layout, and are skipped by
+ * YGNodeLayoutCollectNewLayouts() and pixel grid rounding. Passing a different
+ * estimate to a node which already virtualizes its children updates the
+ * children not laid out yet.
+ */
+YG_EXPORT void YGNodeSetVirtualizesChildren(
+    YGNodeRef node,
+    bool virtualizesChildren,
+    float estimatedChildExtent);
+
+/**
+ * Whether the node virtualizes its children.
+ */
+YG_EXPORT bool YGNodeGetVirtualizesChildren(YGNodeConstRef node);
+
+/**
+ * Sets the window along the main axis of a node virtualizing its children,
+ * e.g. the visible part of a scroll view, as an offset from the start of the
+ * content box of the node and an extent. Children within `overscan` of either
+ * side are laid out as well. Every child is laid out until a window is set.
+ *
+ * The node is only marked dirty if the window reaches children which were not
+ * laid out by the last layout.
+ */
+YG_EXPORT void YGNodeSetVirtualizedWindow(
+    YGNodeRef node,
+    float offset,
+    float extent,
+    float overscan);
+
+/**
+ * Returns the children laid out by the last layout of a node virtualizing its
+ * children, from index `*first` to before index `*end`.
+ */
+YG_EXPORT void YGNodeGetVirtualizedLaidOutChildren(
+    YGNodeConstRef node,
+    size_t* first,
+    size_t* end);
+
+/**
+ * Returns the offset of a child from the start of the content box of a node
+ * virtualizing its children, along its main axis. An index equal to the child
+ * count returns the offset of a child appended to the node.
+ */
+YG_EXPORT float YGNodeGetVirtualizedChildOffset(YGNodeRef node, size_t index);
+
+/**
+ * Returns the index of the child at an offset from the start of the content
+ * box of a node virtualizing its children, or the child count if the offset
+ * is past the last child, e.g. to scroll to a child.
+ */
+YG_EXPORT size_t
+YGNodeGetVirtualizedChildAtOffset(YGNodeRef node, float offset);
+
+/**
+ * Returns the extent of the children of a node virtualizing them along its
+ * main axis, gaps included, without laying them out.
+ */
+YG_EXPORT float YGNodeGetVirtualizedContentExtent(YGNodeRef node);
+
+YG_EXTERN_C_END
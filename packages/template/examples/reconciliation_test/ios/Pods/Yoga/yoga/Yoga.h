@@ -15,7 +15,10 @@
 #include <yoga/YGEnums.h>
 #include <yoga/YGMacros.h>
 #include <yoga/YGNode.h>
+#include <yoga/YGNodeArena.h>
 #include <yoga/YGNodeLayout.h>
 #include <yoga/YGNodeStyle.h>
 #include <yoga/YGPixelGrid.h>
+#include <yoga/YGTree.h>
 #include <yoga/YGValue.h>
+#include <yoga/YGVirtualizedChildren.h>
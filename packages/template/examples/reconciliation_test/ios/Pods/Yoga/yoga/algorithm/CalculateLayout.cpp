@@ -10,6 +10,8 @@
 #include <cfloat>
 #include <cmath>
 #include <cstring>
+#include <optional>
+#include <vector>
 
 #include <yoga/Yoga.h>
 
@@ -23,6 +25,7 @@
 #include <yoga/algorithm/FlexLine.h>
 #include <yoga/algorithm/PixelGrid.h>
 #include <yoga/algorithm/SizingMode.h>
+#include <yoga/algorithm/SubtreeMemo.h>
 #include <yoga/algorithm/TrailingPosition.h>
 #include <yoga/debug/AssertFatal.h>
 #include <yoga/debug/Log.h>
@@ -33,7 +36,32 @@
 
 namespace facebook::yoga {
 
-std::atomic<uint32_t> gCurrentGenerationCount(0);
+namespace {
+
+// Generation counts are handed out to threads in blocks, so that trees laid
+// out concurrently on different threads do not contend on a shared counter,
+// while every pass still gets a count that no other pass in the process uses.
+// A node laid out by one thread may then be laid out by another without its
+// cached layout being mistaken for the result of the current pass.
+constexpr uint32_t kGenerationBlockSize = 1024;
+std::atomic<uint32_t> gNextGenerationBlock(0);
+
+uint32_t nextGenerationCount() {
+  thread_local uint32_t next = 0;
+  thread_local uint32_t blockEnd = 0;
+  if (next == blockEnd) {
+    next = gNextGenerationBlock.fetch_add(
+        kGenerationBlockSize, std::memory_order_relaxed);
+    blockEnd = next + kGenerationBlockSize;
+  }
+  // 0 is the generation of nodes which were never laid out
+  if (next == 0) {
+    next++;
+  }
+  return next++;
+}
+
+} // namespace
 
 static void constrainMaxSizeForMode(
     const yoga::Node* node,
@@ -305,28 +333,75 @@ static void measureNodeWithMeasureFunc(
             ownerWidth),
         Dimension::Height);
   } else {
-    Event::publish<Event::MeasureCallbackStart>(node);
+    // Nodes with intrinsic sizes may know their size without measuring
+    const IntrinsicSizes* const intrinsicSizes = node->getIntrinsicSizes();
+    std::optional<YGSize> intrinsicSize;
+    if (intrinsicSizes != nullptr) {
+      intrinsicSize = intrinsicSizes->measure(
+          innerWidth,
+          measureMode(widthSizingMode),
+          innerHeight,
+          measureMode(heightSizingMode));
+    }
 
-    // Measure the text under the current constraints.
-    const YGSize measuredSize = node->measure(
-        innerWidth,
-        measureMode(widthSizingMode),
-        innerHeight,
-        measureMode(heightSizingMode));
+    // Nodes with a content key may reuse the measurement of another node with
+    // the same content.
+    const uint64_t measureCacheKey = node->getMeasureCacheKey();
+    MeasureCache* const measureCache =
+        measureCacheKey != 0 && !intrinsicSize.has_value()
+        ? node->getConfig()->getMeasureCache()
+        : nullptr;
+    std::optional<YGSize> sharedSize;
+    if (measureCache != nullptr) {
+      sharedSize = measureCache->get(
+          measureCacheKey,
+          innerWidth,
+          measureMode(widthSizingMode),
+          innerHeight,
+          measureMode(heightSizingMode));
+    }
 
-    layoutMarkerData.measureCallbacks += 1;
-    layoutMarkerData.measureCallbackReasonsCount[static_cast<size_t>(reason)] +=
-        1;
+    YGSize measuredSize;
+    if (intrinsicSize.has_value()) {
+      measuredSize = *intrinsicSize;
+      layoutMarkerData.intrinsicSizeHits += 1;
+    } else if (sharedSize.has_value()) {
+      measuredSize = *sharedSize;
+      layoutMarkerData.sharedMeasureCacheHits += 1;
+    } else {
+      Event::publish<Event::MeasureCallbackStart>(node);
 
-    Event::publish<Event::MeasureCallbackEnd>(
-        node,
-        {innerWidth,
-         unscopedEnum(measureMode(widthSizingMode)),
-         innerHeight,
-         unscopedEnum(measureMode(heightSizingMode)),
-         measuredSize.width,
-         measuredSize.height,
-         reason});
+      // Measure the text under the current constraints.
+      measuredSize = node->measure(
+          innerWidth,
+          measureMode(widthSizingMode),
+          innerHeight,
+          measureMode(heightSizingMode));
+
+      layoutMarkerData.measureCallbacks += 1;
+      layoutMarkerData
+          .measureCallbackReasonsCount[static_cast<size_t>(reason)] += 1;
+
+      Event::publish<Event::MeasureCallbackEnd>(
+          node,
+          {innerWidth,
+           unscopedEnum(measureMode(widthSizingMode)),
+           innerHeight,
+           unscopedEnum(measureMode(heightSizingMode)),
+           measuredSize.width,
+           measuredSize.height,
+           reason});
+
+      if (measureCache != nullptr) {
+        measureCache->put(
+            measureCacheKey,
+            innerWidth,
+            measureMode(widthSizingMode),
+            innerHeight,
+            measureMode(heightSizingMode),
+            measuredSize);
+      }
+    }
 
     node->setLayoutMeasuredDimension(
         boundAxis(
@@ -563,6 +638,128 @@ static float computeFlexBasisForChildren(
   return totalOuterFlexBasis;
 }
 
+namespace {
+
+// Set while a thread runs a child layout handed to the config's executor, so
+// that nested containers lay out their children inline instead of re-entering
+// the executor.
+thread_local bool gLayingOutInParallel = false;
+
+// The subtrees laid out by the layout pass running on the thread, when its
+// config memoizes them. Parallel child layouts run without, as their siblings
+// are laid out concurrently.
+thread_local SubtreeMemo* gSubtreeMemo = nullptr;
+
+// Memoizes the subtrees of a layout pass while in scope, if the config of its
+// root asks to
+class SubtreeMemoScope {
+ public:
+  explicit SubtreeMemoScope(const yoga::Node* root) : previous_(gSubtreeMemo) {
+    if (root->getConfig()->useSubtreeMemoization()) {
+      gSubtreeMemo = &memo_.emplace();
+    } else {
+      gSubtreeMemo = nullptr;
+    }
+  }
+
+  ~SubtreeMemoScope() {
+    gSubtreeMemo = previous_;
+  }
+
+  SubtreeMemoScope(const SubtreeMemoScope&) = delete;
+  SubtreeMemoScope& operator=(const SubtreeMemoScope&) = delete;
+
+ private:
+  SubtreeMemo* previous_;
+  std::optional<SubtreeMemo> memo_;
+};
+
+// The layout of a flex item, deferred so that it may run concurrently with the
+// layout of its siblings.
+struct ChildLayoutTask {
+  yoga::Node* child;
+  float availableWidth;
+  float availableHeight;
+  SizingMode widthSizingMode;
+  SizingMode heightSizingMode;
+  bool performLayout;
+  LayoutData layoutMarkerData;
+};
+
+struct ChildLayoutBatch {
+  std::vector<ChildLayoutTask> tasks;
+  Direction ownerDirection;
+  float ownerWidth;
+  float ownerHeight;
+  uint32_t depth;
+  uint32_t generationCount;
+};
+
+void runChildLayoutTask(void* taskData, size_t index) {
+  auto& batch = *static_cast<ChildLayoutBatch*>(taskData);
+  auto& task = batch.tasks[index];
+
+  const bool wasLayingOutInParallel = gLayingOutInParallel;
+  SubtreeMemo* const subtreeMemo = gSubtreeMemo;
+  gLayingOutInParallel = true;
+  gSubtreeMemo = nullptr;
+  calculateLayoutInternal(
+      task.child,
+      task.availableWidth,
+      task.availableHeight,
+      batch.ownerDirection,
+      task.widthSizingMode,
+      task.heightSizingMode,
+      batch.ownerWidth,
+      batch.ownerHeight,
+      task.performLayout,
+      task.performLayout ? LayoutPassReason::kFlexLayout
+                         : LayoutPassReason::kFlexMeasure,
+      task.layoutMarkerData,
+      batch.depth,
+      batch.generationCount);
+  gLayingOutInParallel = wasLayingOutInParallel;
+  gSubtreeMemo = subtreeMemo;
+}
+
+void mergeLayoutData(LayoutData& into, const LayoutData& from) {
+  into.layouts += from.layouts;
+  into.measures += from.measures;
+  into.maxMeasureCache = std::max(into.maxMeasureCache, from.maxMeasureCache);
+  into.cachedLayouts += from.cachedLayouts;
+  into.cachedMeasures += from.cachedMeasures;
+  into.measureCallbacks += from.measureCallbacks;
+  for (size_t i = 0; i < into.measureCallbackReasonsCount.size(); i++) {
+    into.measureCallbackReasonsCount[i] += from.measureCallbackReasonsCount[i];
+  }
+  into.measureCacheEvictions += from.measureCacheEvictions;
+  into.sharedMeasureCacheHits += from.sharedMeasureCacheHits;
+  into.memoizedSubtrees += from.memoizedSubtrees;
+  into.intrinsicSizeHits += from.intrinsicSizeHits;
+}
+
+// Flex items are independent of one another once their sizes are resolved, so
+// their subtrees may be laid out in parallel when an executor is configured and
+// at least two of them have children of their own.
+bool shouldLayoutChildrenInParallel(
+    const yoga::Node* node,
+    const FlexLine& flexLine,
+    bool performLayout) {
+  if (!performLayout || gLayingOutInParallel ||
+      !node->getConfig()->hasExecutor()) {
+    return false;
+  }
+  size_t containers = 0;
+  for (auto child : flexLine.itemsInFlow) {
+    if (child->getChildCount() > 0 && ++containers >= 2) {
+      return true;
+    }
+  }
+  return false;
+}
+
+} // namespace
+
 // It distributes the free space to the flexible items and ensures that the size
 // of the flex items abide the min and max constraints. At the end of this
 // function the child nodes would have proper size. Prior using this function
@@ -591,6 +788,19 @@ static float distributeFreeSpaceSecondPass(
   const bool isMainAxisRow = isRow(mainAxis);
   const bool isNodeFlexWrap = node->style().flexWrap() != Wrap::NoWrap;
 
+  const bool layoutInParallel =
+      shouldLayoutChildrenInParallel(node, flexLine, performLayout);
+  ChildLayoutBatch batch{
+      {},
+      node->getLayout().direction(),
+      availableInnerWidth,
+      availableInnerHeight,
+      depth,
+      generationCount};
+  if (layoutInParallel) {
+    batch.tasks.reserve(flexLine.itemsInFlow.size());
+  }
+
   for (auto currentLineChild : flexLine.itemsInFlow) {
     childFlexBasis = boundAxisWithinMinAndMax(
                          currentLineChild,
@@ -729,6 +939,18 @@ static float distributeFreeSpaceSecondPass(
         !isMainAxisRow ? childMainSizingMode : childCrossSizingMode;
 
     const bool isLayoutPass = performLayout && !requiresStretchLayout;
+    if (layoutInParallel) {
+      batch.tasks.push_back(
+          {currentLineChild,
+           childWidth,
+           childHeight,
+           childWidthSizingMode,
+           childHeightSizingMode,
+           isLayoutPass,
+           {}});
+      continue;
+    }
+
     // Recursively call the layout algorithm for this child with the updated
     // main size.
     calculateLayoutInternal(
@@ -750,6 +972,17 @@ static float distributeFreeSpaceSecondPass(
         node->getLayout().hadOverflow() ||
         currentLineChild->getLayout().hadOverflow());
   }
+
+  if (layoutInParallel) {
+    node->getConfig()->execute(
+        runChildLayoutTask, &batch, batch.tasks.size());
+    for (const auto& task : batch.tasks) {
+      mergeLayoutData(layoutMarkerData, task.layoutMarkerData);
+      node->setLayoutHadOverflow(
+          node->getLayout().hadOverflow() ||
+          task.child->getLayout().hadOverflow());
+    }
+  }
   return deltaFreeSpace;
 }
 
@@ -1122,6 +1355,299 @@ static void justifyMainAxis(
   }
 }
 
+// Lays out or measures the child at `index` of a node virtualizing its
+// children, at `offset` into its content box along the main axis, and records
+// its extent
+static void layoutVirtualizedChild(
+    yoga::Node* const node,
+    const size_t index,
+    const float offset,
+    const Direction direction,
+    const FlexDirection mainAxis,
+    const FlexDirection crossAxis,
+    const float leadingPaddingAndBorderMain,
+    const float leadingPaddingAndBorderCross,
+    const float availableInnerWidth,
+    const float availableInnerHeight,
+    const bool performLayout,
+    LayoutData& layoutMarkerData,
+    const uint32_t depth,
+    const uint32_t generationCount) {
+  VirtualizedChildren& virtualizedChildren = *node->getVirtualizedChildren();
+  yoga::Node* const child = node->cloneChildIfNeeded(index);
+  child->resolveDimension();
+  if (child->style().display() == Display::None) {
+    zeroOutLayoutRecursively(child);
+    child->setHasNewLayout(true);
+    child->setDirty(false);
+    virtualizedChildren.setHidden(index);
+    return;
+  }
+
+  const bool isMainAxisRow = isRow(mainAxis);
+  const float availableInnerMainDim =
+      isMainAxisRow ? availableInnerWidth : availableInnerHeight;
+  const float availableInnerCrossDim =
+      isMainAxisRow ? availableInnerHeight : availableInnerWidth;
+  if (performLayout) {
+    child->setPosition(
+        child->resolveDirection(direction),
+        availableInnerMainDim,
+        availableInnerCrossDim,
+        availableInnerWidth);
+  }
+
+  const float marginMain =
+      child->style().computeMarginForAxis(mainAxis, availableInnerWidth);
+  const float marginCross =
+      child->style().computeMarginForAxis(crossAxis, availableInnerWidth);
+  const Align alignItem = resolveChildAlignment(node, child);
+
+  float childMainSize = YGUndefined;
+  SizingMode childMainSizingMode = SizingMode::MaxContent;
+  if (child->hasDefiniteLength(dimension(mainAxis), availableInnerMainDim)) {
+    childMainSize = child->getResolvedDimension(dimension(mainAxis))
+                        .resolve(availableInnerMainDim)
+                        .unwrap() +
+        marginMain;
+    childMainSizingMode = SizingMode::StretchFit;
+  }
+
+  float childCrossSize = YGUndefined;
+  SizingMode childCrossSizingMode = SizingMode::MaxContent;
+  if (child->hasDefiniteLength(dimension(crossAxis), availableInnerCrossDim)) {
+    childCrossSize = child->getResolvedDimension(dimension(crossAxis))
+                         .resolve(availableInnerCrossDim)
+                         .unwrap() +
+        marginCross;
+    childCrossSizingMode = SizingMode::StretchFit;
+  } else if (yoga::isDefined(availableInnerCrossDim)) {
+    childCrossSize = availableInnerCrossDim;
+    childCrossSizingMode = alignItem == Align::Stretch
+        ? SizingMode::StretchFit
+        : SizingMode::FitContent;
+  }
+
+  const FloatOptional aspectRatio = child->style().aspectRatio();
+  if (aspectRatio.isDefined() && yoga::isUndefined(childMainSize) &&
+      childCrossSizingMode == SizingMode::StretchFit) {
+    const float crossSize = childCrossSize - marginCross;
+    childMainSize = marginMain +
+        (isMainAxisRow ? crossSize * aspectRatio.unwrap()
+                       : crossSize / aspectRatio.unwrap());
+    childMainSizingMode = SizingMode::StretchFit;
+  }
+
+  calculateLayoutInternal(
+      child,
+      isMainAxisRow ? childMainSize : childCrossSize,
+      isMainAxisRow ? childCrossSize : childMainSize,
+      direction,
+      isMainAxisRow ? childMainSizingMode : childCrossSizingMode,
+      isMainAxisRow ? childCrossSizingMode : childMainSizingMode,
+      availableInnerWidth,
+      availableInnerHeight,
+      performLayout,
+      performLayout ? LayoutPassReason::kFlexLayout
+                    : LayoutPassReason::kFlexMeasure,
+      layoutMarkerData,
+      depth,
+      generationCount);
+
+  virtualizedChildren.setExtent(
+      index,
+      child->getLayout().measuredDimension(dimension(mainAxis)) + marginMain);
+  const float crossExtent =
+      child->getLayout().measuredDimension(dimension(crossAxis)) + marginCross;
+  virtualizedChildren.setMaxCrossExtent(yoga::maxOrDefined(
+      virtualizedChildren.getMaxCrossExtent(), crossExtent));
+  if (!performLayout) {
+    return;
+  }
+
+  float crossOffset = 0.0f;
+  if (yoga::isDefined(availableInnerCrossDim)) {
+    if (alignItem == Align::Center) {
+      crossOffset = (availableInnerCrossDim - crossExtent) / 2.0f;
+    } else if (alignItem == Align::FlexEnd) {
+      crossOffset = availableInnerCrossDim - crossExtent;
+    }
+  }
+
+  child->setLayoutPosition(
+      child->getLayout().position(flexStartEdge(mainAxis)) +
+          leadingPaddingAndBorderMain + offset,
+      flexStartEdge(mainAxis));
+  child->setLayoutPosition(
+      child->getLayout().position(flexStartEdge(crossAxis)) +
+          leadingPaddingAndBorderCross + crossOffset,
+      flexStartEdge(crossAxis));
+}
+
+// Lays out a node virtualizing its children (see
+// YGNodeSetVirtualizesChildren()). Children are stacked along the main axis,
+// each at its offset in the extent index, and only those overlapping the
+// window are laid out, or measured to size the node. The others keep their
+// last layout, so that moving the window costs O(log n) plus the children
+// entering it.
+static void layoutVirtualizedChildren(
+    yoga::Node* const node,
+    const float availableWidth,
+    const float availableHeight,
+    const Direction direction,
+    const SizingMode widthSizingMode,
+    const SizingMode heightSizingMode,
+    const float ownerWidth,
+    const float ownerHeight,
+    const bool performLayout,
+    LayoutData& layoutMarkerData,
+    const uint32_t depth,
+    const uint32_t generationCount) {
+  VirtualizedChildren& virtualizedChildren = *node->getVirtualizedChildren();
+  const FlexDirection mainAxis =
+      resolveDirection(node->style().flexDirection(), direction);
+  const FlexDirection crossAxis = resolveCrossDirection(mainAxis, direction);
+  const bool isMainAxisRow = isRow(mainAxis);
+
+  const float paddingAndBorderAxisMain =
+      paddingAndBorderForAxis(node, mainAxis, ownerWidth);
+  const float paddingAndBorderAxisCross =
+      paddingAndBorderForAxis(node, crossAxis, ownerWidth);
+  const float availableInnerWidth = calculateAvailableInnerDimension(
+      node,
+      Dimension::Width,
+      availableWidth,
+      isMainAxisRow ? paddingAndBorderAxisMain : paddingAndBorderAxisCross,
+      ownerWidth);
+  const float availableInnerHeight = calculateAvailableInnerDimension(
+      node,
+      Dimension::Height,
+      availableHeight,
+      isMainAxisRow ? paddingAndBorderAxisCross : paddingAndBorderAxisMain,
+      ownerHeight);
+  const float availableInnerMainDim =
+      isMainAxisRow ? availableInnerWidth : availableInnerHeight;
+  const float availableInnerCrossDim =
+      isMainAxisRow ? availableInnerHeight : availableInnerWidth;
+  const SizingMode sizingModeMainDim =
+      isMainAxisRow ? widthSizingMode : heightSizingMode;
+  const SizingMode sizingModeCrossDim =
+      isMainAxisRow ? heightSizingMode : widthSizingMode;
+  const float mainAxisOwnerSize = isMainAxisRow ? ownerWidth : ownerHeight;
+  const float crossAxisOwnerSize = isMainAxisRow ? ownerHeight : ownerWidth;
+
+  virtualizedChildren.setGap(node->style().computeGapForAxis(mainAxis));
+
+  const size_t childCount = node->getChildCount();
+  const float windowEnd = virtualizedChildren.getWindowEnd();
+  const float leadingPaddingAndBorderMain =
+      node->style().computeFlexStartPaddingAndBorder(
+          mainAxis, direction, ownerWidth);
+  const float leadingPaddingAndBorderCross =
+      node->style().computeFlexStartPaddingAndBorder(
+          crossAxis, direction, ownerWidth);
+  virtualizedChildren.setMaxCrossExtent(0.0f);
+  const size_t firstChild = virtualizedChildren.getChildAtOffset(
+      virtualizedChildren.getWindowStart());
+  size_t endChild = firstChild;
+  // Offsets past the first child shift as the children before them are laid
+  // out at their actual extent
+  for (; endChild < childCount; endChild++) {
+    const float offset = virtualizedChildren.getChildOffset(endChild);
+    if (offset >= windowEnd) {
+      break;
+    }
+    layoutVirtualizedChild(
+        node,
+        endChild,
+        offset,
+        direction,
+        mainAxis,
+        crossAxis,
+        leadingPaddingAndBorderMain,
+        leadingPaddingAndBorderCross,
+        availableInnerWidth,
+        availableInnerHeight,
+        performLayout,
+        layoutMarkerData,
+        depth,
+        generationCount);
+  }
+  if (performLayout) {
+    virtualizedChildren.setLaidOutChildren(firstChild, endChild);
+  }
+
+  node->setLayoutMeasuredDimension(
+      boundAxis(
+          node, FlexDirection::Row, availableWidth, ownerWidth, ownerWidth),
+      Dimension::Width);
+  node->setLayoutMeasuredDimension(
+      boundAxis(
+          node,
+          FlexDirection::Column,
+          availableHeight,
+          ownerHeight,
+          ownerWidth),
+      Dimension::Height);
+
+  // The content size covers every child, laid out or estimated
+  const float contentMainDim =
+      virtualizedChildren.getTotalExtent() + paddingAndBorderAxisMain;
+  if (sizingModeMainDim == SizingMode::MaxContent ||
+      (node->style().overflow() != Overflow::Scroll &&
+       sizingModeMainDim == SizingMode::FitContent)) {
+    node->setLayoutMeasuredDimension(
+        boundAxis(
+            node, mainAxis, contentMainDim, mainAxisOwnerSize, ownerWidth),
+        dimension(mainAxis));
+  } else if (sizingModeMainDim == SizingMode::FitContent) {
+    node->setLayoutMeasuredDimension(
+        yoga::maxOrDefined(
+            yoga::minOrDefined(
+                availableInnerMainDim + paddingAndBorderAxisMain,
+                boundAxisWithinMinAndMax(
+                    node,
+                    mainAxis,
+                    FloatOptional{contentMainDim},
+                    mainAxisOwnerSize)
+                    .unwrap()),
+            paddingAndBorderAxisMain),
+        dimension(mainAxis));
+  }
+
+  // Children outside of the window have no known cross size, so the node
+  // spans the available cross size when there is one
+  if (sizingModeCrossDim != SizingMode::StretchFit) {
+    const float contentCrossDim = yoga::isDefined(availableInnerCrossDim)
+        ? availableInnerCrossDim
+        : virtualizedChildren.getMaxCrossExtent();
+    node->setLayoutMeasuredDimension(
+        boundAxis(
+            node,
+            crossAxis,
+            contentCrossDim + paddingAndBorderAxisCross,
+            crossAxisOwnerSize,
+            ownerWidth),
+        dimension(crossAxis));
+  }
+
+  if (performLayout && (needsTrailingPosition(mainAxis) ||
+                        needsTrailingPosition(crossAxis))) {
+    for (size_t i = firstChild; i < endChild; i++) {
+      const auto child = node->getChild(i);
+      if (child->style().display() == Display::None) {
+        continue;
+      }
+      if (needsTrailingPosition(mainAxis)) {
+        setChildTrailingPosition(node, child, mainAxis);
+      }
+      if (needsTrailingPosition(crossAxis)) {
+        setChildTrailingPosition(node, child, crossAxis);
+      }
+    }
+  }
+}
+
 //
 // This is the main routine that implements a subset of the flexbox layout
 // algorithm described in the W3C CSS documentation:
@@ -1310,6 +1836,23 @@ static void calculateLayoutImpl(
     return;
   }
 
+  if (node->getVirtualizedChildren() != nullptr) {
+    layoutVirtualizedChildren(
+        node,
+        availableWidth - marginAxisRow,
+        availableHeight - marginAxisColumn,
+        direction,
+        widthSizingMode,
+        heightSizingMode,
+        ownerWidth,
+        ownerHeight,
+        performLayout,
+        layoutMarkerData,
+        depth,
+        generationCount);
+    return;
+  }
+
   // At this point we know we're going to perform work. Ensure that each child
   // has a mutable copy.
   node->cloneChildrenIfNeeded();
@@ -2212,24 +2755,65 @@ bool calculateLayoutInternal(
         Dimension::Width, cachedResults->computedWidth);
     layout->setMeasuredDimension(
         Dimension::Height, cachedResults->computedHeight);
+    cachedResults->lastUsed = ++layout->cacheTick;
+    layout->cacheHits++;
 
     (performLayout ? layoutMarkerData.cachedLayouts
                    : layoutMarkerData.cachedMeasures) += 1;
   } else {
-    calculateLayoutImpl(
-        node,
+    layout->cacheMisses++;
+
+    // A subtree identical to one sized in the same constraints during this
+    // pass takes its size, and its layout, rather than being sized again
+    const uint64_t fingerprint = gSubtreeMemo != nullptr &&
+            node->getChildCount() > 0 && node->getOwner() != nullptr
+        ? subtreeFingerprint(node)
+        : 0;
+    const LayoutConstraints constraints{
         availableWidth,
         availableHeight,
-        ownerDirection,
         widthSizingMode,
         heightSizingMode,
         ownerWidth,
-        ownerHeight,
-        performLayout,
-        layoutMarkerData,
-        depth,
-        generationCount,
-        reason);
+        ownerHeight};
+    const SubtreeMemo::Entry* const memoized = fingerprint != 0
+        ? gSubtreeMemo->find(
+              *node,
+              fingerprint,
+              constraints,
+              ownerDirection,
+              performLayout,
+              generationCount)
+        : nullptr;
+
+    if (memoized != nullptr) {
+      layout->setMeasuredDimension(Dimension::Width, memoized->measuredWidth);
+      layout->setMeasuredDimension(
+          Dimension::Height, memoized->measuredHeight);
+      if (performLayout) {
+        copySubtreeLayout(*memoized->node, *node, generationCount);
+      }
+      layoutMarkerData.memoizedSubtrees += 1;
+    } else {
+      calculateLayoutImpl(
+          node,
+          availableWidth,
+          availableHeight,
+          ownerDirection,
+          widthSizingMode,
+          heightSizingMode,
+          ownerWidth,
+          ownerHeight,
+          performLayout,
+          layoutMarkerData,
+          depth,
+          generationCount,
+          reason);
+      if (fingerprint != 0) {
+        gSubtreeMemo->insert(
+            *node, fingerprint, constraints, ownerDirection, performLayout);
+      }
+    }
 
     layout->lastOwnerDirection = ownerDirection;
 
@@ -2238,20 +2822,27 @@ bool calculateLayoutInternal(
           layoutMarkerData.maxMeasureCache,
           layout->nextCachedMeasurementsIndex + 1u);
 
-      if (layout->nextCachedMeasurementsIndex ==
-          LayoutResults::MaxCachedMeasurements) {
-        layout->nextCachedMeasurementsIndex = 0;
-      }
-
       CachedMeasurement* newCacheEntry;
       if (performLayout) {
         // Use the single layout cache entry.
         newCacheEntry = &layout->cachedLayout;
-      } else {
+      } else if (
+          layout->nextCachedMeasurementsIndex <
+          node->getConfig()->getMaxCachedMeasurements()) {
         // Allocate a new measurement cache entry.
-        newCacheEntry =
-            &layout->cachedMeasurements[layout->nextCachedMeasurementsIndex];
+        newCacheEntry = &layout->cachedMeasurements.allocate(
+            layout->nextCachedMeasurementsIndex);
         layout->nextCachedMeasurementsIndex++;
+      } else {
+        // Replace the least recently used measurement cache entry.
+        newCacheEntry = &layout->cachedMeasurements[0];
+        for (uint32_t i = 1; i < layout->nextCachedMeasurementsIndex; i++) {
+          if (layout->cachedMeasurements[i].lastUsed <
+              newCacheEntry->lastUsed) {
+            newCacheEntry = &layout->cachedMeasurements[i];
+          }
+        }
+        layoutMarkerData.measureCacheEvictions += 1;
       }
 
       newCacheEntry->availableWidth = availableWidth;
@@ -2262,10 +2853,18 @@ bool calculateLayoutInternal(
           layout->measuredDimension(Dimension::Width);
       newCacheEntry->computedHeight =
           layout->measuredDimension(Dimension::Height);
+      newCacheEntry->lastUsed = ++layout->cacheTick;
     }
   }
 
   if (performLayout) {
+    layout->lastLayoutConstraints = {
+        availableWidth,
+        availableHeight,
+        widthSizingMode,
+        heightSizingMode,
+        ownerWidth,
+        ownerHeight};
     node->setLayoutDimension(
         node->getLayout().measuredDimension(Dimension::Width),
         Dimension::Width);
@@ -2288,23 +2887,20 @@ bool calculateLayoutInternal(
     layoutType = cachedResults != nullptr ? LayoutType::kCachedMeasure
                                           : LayoutType::kMeasure;
   }
-  Event::publish<Event::NodeLayout>(node, {layoutType});
+  Event::publish<Event::NodeLayout>(
+      node, {layoutType, layout->cacheHits, layout->cacheMisses});
 
   return (needToVisitNode || cachedResults == nullptr);
 }
 
-void calculateLayout(
+// Lays out `node` as the root of a layout pass
+static void layoutRoot(
     yoga::Node* const node,
     const float ownerWidth,
     const float ownerHeight,
-    const Direction ownerDirection) {
-  Event::publish<Event::LayoutPassStart>(node);
-  LayoutData markerData = {};
-
-  // Increment the generation count. This will force the recursive routine to
-  // visit all dirty nodes at least once. Subsequent visits will be skipped if
-  // the input parameters don't change.
-  gCurrentGenerationCount.fetch_add(1, std::memory_order_relaxed);
+    const Direction ownerDirection,
+    LayoutData& markerData,
+    const uint32_t generationCount) {
   node->resolveDimension();
   float width = YGUndefined;
   SizingMode widthSizingMode = SizingMode::MaxContent;
@@ -2360,11 +2956,167 @@ void calculateLayout(
           LayoutPassReason::kInitial,
           markerData,
           0, // tree root
-          gCurrentGenerationCount.load(std::memory_order_relaxed))) {
+          generationCount)) {
     node->setPosition(
         node->getLayout().direction(), ownerWidth, ownerHeight, ownerWidth);
     roundLayoutResultsToPixelGrid(node, 0.0f, 0.0f);
   }
+}
+
+// Dirties every node on the paths to the dirty layout boundaries under
+// `node`, as if dirtiness had propagated past them
+static void dirtyPathsToBoundaries(yoga::Node* const node) {
+  node->setHasDirtyDescendant(false);
+  if (!node->isDirty()) {
+    // Relaying out the path is internal to this pass, so dirtied funcs, which
+    // report changes to the tree, are not called
+    node->setDirtyFlag(true);
+    node->setLayoutComputedFlexBasis(FloatOptional());
+  }
+  for (yoga::Node* child : node->getChildren()) {
+    if (child->hasDirtyDescendant()) {
+      dirtyPathsToBoundaries(child);
+    }
+  }
+}
+
+// Dirtiness which stopped at a node that is no longer a layout boundary, e.g.
+// as an ancestor is now aligned by baseline, goes on to its owner
+static void propagatePastFormerBoundaries(yoga::Node* const node) {
+  if (node->isDirty() && node->getOwner() != nullptr &&
+      !node->isLayoutBoundary()) {
+    node->getOwner()->markDirtyAndPropagate();
+  }
+  for (yoga::Node* child : node->getChildren()) {
+    if (child->hasDirtyDescendant()) {
+      propagatePastFormerBoundaries(child);
+    }
+  }
+}
+
+// Lays out a dirty layout boundary again, within the same constraints as its
+// last layout. As its size does not depend on its content, neither does the
+// layout of its owner.
+static void layoutBoundary(
+    yoga::Node* const node,
+    const double absoluteLeft,
+    const double absoluteTop,
+    LayoutData& markerData,
+    const uint32_t generationCount) {
+  // Copied, as laying out the node records new constraints
+  const LayoutConstraints constraints =
+      node->getLayout().lastLayoutConstraints;
+  if (calculateLayoutInternal(
+          node,
+          constraints.availableWidth,
+          constraints.availableHeight,
+          node->getOwner()->getLayout().direction(),
+          constraints.widthSizingMode,
+          constraints.heightSizingMode,
+          constraints.ownerWidth,
+          constraints.ownerHeight,
+          true,
+          LayoutPassReason::kInitial,
+          markerData,
+          0,
+          generationCount)) {
+    roundLayoutResultsToPixelGrid(node, absoluteLeft, absoluteTop);
+  }
+}
+
+// Lays out the layout boundaries under `node` which are still dirty, whose
+// owner is at the given absolute position. Nodes on the way to a boundary
+// keep their layout, but are flagged as having a new one so that it is read
+// back.
+static void layoutDirtyBoundaries(
+    yoga::Node* const node,
+    const double absoluteLeft,
+    const double absoluteTop,
+    LayoutData& markerData,
+    const uint32_t generationCount) {
+  node->setHasDirtyDescendant(false);
+
+  // Boundaries which the root pass, or an outer boundary, laid out are no
+  // longer dirty. Hidden ones were zeroed out, and are laid out again once
+  // shown.
+  const auto& constraints = node->getLayout().lastLayoutConstraints;
+  if (node->isDirty() && node->getOwner() != nullptr &&
+      constraints.widthSizingMode == SizingMode::StretchFit &&
+      constraints.heightSizingMode == SizingMode::StretchFit) {
+    layoutBoundary(
+        node, absoluteLeft, absoluteTop, markerData, generationCount);
+  } else {
+    node->setHasNewLayout(true);
+  }
+
+  const double nodeLeft =
+      absoluteLeft + node->getLayout().position(PhysicalEdge::Left);
+  const double nodeTop =
+      absoluteTop + node->getLayout().position(PhysicalEdge::Top);
+  for (yoga::Node* child : node->getChildren()) {
+    if (child->hasDirtyDescendant()) {
+      layoutDirtyBoundaries(
+          child, nodeLeft, nodeTop, markerData, generationCount);
+    }
+  }
+}
+
+void calculateLayout(
+    yoga::Node* const node,
+    const float ownerWidth,
+    const float ownerHeight,
+    const Direction ownerDirection) {
+  Event::publish<Event::LayoutPassStart>(node);
+  LayoutData markerData = {};
+
+  // Reach dirty layout boundaries from the root, like any other dirty node
+  if (node->hasDirtyDescendant()) {
+    dirtyPathsToBoundaries(node);
+  }
+
+  // Start a new generation. This will force the recursive routine to
+  // visit all dirty nodes at least once. Subsequent visits will be skipped if
+  // the input parameters don't change.
+  const uint32_t generationCount = nextGenerationCount();
+  SubtreeMemoScope subtreeMemoScope(node);
+  layoutRoot(
+      node,
+      ownerWidth,
+      ownerHeight,
+      ownerDirection,
+      markerData,
+      generationCount);
+
+  Event::publish<Event::LayoutPassEnd>(node, {&markerData});
+}
+
+void calculateLayoutIncremental(
+    yoga::Node* const node,
+    const float ownerWidth,
+    const float ownerHeight,
+    const Direction ownerDirection) {
+  Event::publish<Event::LayoutPassStart>(node);
+  LayoutData markerData = {};
+
+  if (node->hasDirtyDescendant()) {
+    propagatePastFormerBoundaries(node);
+  }
+
+  // The root keeps its cached layout unless something outside of the dirty
+  // boundaries changed
+  const uint32_t generationCount = nextGenerationCount();
+  SubtreeMemoScope subtreeMemoScope(node);
+  layoutRoot(
+      node,
+      ownerWidth,
+      ownerHeight,
+      ownerDirection,
+      markerData,
+      generationCount);
+
+  if (node->hasDirtyDescendant()) {
+    layoutDirtyBoundaries(node, 0.0, 0.0, markerData, generationCount);
+  }
 
   Event::publish<Event::LayoutPassEnd>(node, {&markerData});
 }
@@ -20,6 +20,12 @@ void calculateLayout(
     const float ownerHeight,
     const Direction ownerDirection);
 
+void calculateLayoutIncremental(
+    yoga::Node* const node,
+    const float ownerWidth,
+    const float ownerHeight,
+    const Direction ownerDirection);
+
 bool calculateLayoutInternal(
     yoga::Node* const node,
     const float availableWidth,
@@ -5,6 +5,9 @@
  * LICENSE file in the root directory of this source tree.
  */
 
+#include <array>
+#include <cmath>
+
 #include <yoga/Yoga.h>
 
 #include <yoga/algorithm/PixelGrid.h>
@@ -62,11 +65,66 @@ float roundValueToPixelGrid(
       : (float)(scaledValue / pointScaleFactor);
 }
 
-void roundLayoutResultsToPixelGrid(
+void roundValuesToPixelGrid(
+    const double* values,
+    float* roundedValues,
+    size_t count,
+    double pointScaleFactor) {
+  for (size_t i = 0; i < count; i++) {
+    const double scaledValue = values[i] * pointScaleFactor;
+    // Same as the fmod() based fractial of roundValueToPixelGrid(), for
+    // negative values too
+    const double fractial = scaledValue - std::floor(scaledValue);
+    const bool roundUp = fractial > 0.5 ||
+        std::abs(fractial - 0.5) < 0.0001 || std::abs(fractial - 1.0) < 0.0001;
+    // NaN propagates to YGUndefined
+    roundedValues[i] = static_cast<float>(
+        (scaledValue - fractial + (roundUp ? 1.0 : 0.0)) / pointScaleFactor);
+  }
+}
+
+namespace {
+
+// Number of siblings whose layout is rounded by one roundValuesToPixelGrid()
+// call
+constexpr size_t kBatchSize = 8;
+
+bool isOnPixelGrid(const double value, const double pointScaleFactor) {
+  const double fractial = fmod(value * pointScaleFactor, 1.0);
+  return yoga::inexactEquals(fractial, 0) ||
+      yoga::inexactEquals(std::abs(fractial), 1.0);
+}
+
+// Whether the pass which set `generationCount` may have changed the layout of
+// `child` or of its subtree, or moved it relative to the pixel grid
+bool needsRounding(
+    const yoga::Node* const child,
+    const double absoluteLeft,
+    const double absoluteTop,
+    const uint32_t generationCount) {
+  if (child->getLayout().generationCount == generationCount) {
+    return true;
+  }
+  // A static node does not contain its absolute descendants, which may have
+  // been laid out without it
+  if (child->style().positionType() == PositionType::Static) {
+    return true;
+  }
+  // Layout values rounded before stay rounded as long as their absolute
+  // offset is on the grid
+  const double pointScaleFactor = child->getConfig()->getPointScaleFactor();
+  return !isOnPixelGrid(absoluteLeft, pointScaleFactor) ||
+      !isOnPixelGrid(absoluteTop, pointScaleFactor);
+}
+
+void roundNodeToPixelGrid(
     yoga::Node* const node,
     const double absoluteLeft,
     const double absoluteTop) {
   const auto pointScaleFactor = node->getConfig()->getPointScaleFactor();
+  if (pointScaleFactor == 0.0f) {
+    return;
+  }
 
   const double nodeLeft = node->getLayout().position(PhysicalEdge::Left);
   const double nodeTop = node->getLayout().position(PhysicalEdge::Top);
@@ -80,53 +138,177 @@ void roundLayoutResultsToPixelGrid(
   const double absoluteNodeRight = absoluteNodeLeft + nodeWidth;
   const double absoluteNodeBottom = absoluteNodeTop + nodeHeight;
 
-  if (pointScaleFactor != 0.0f) {
-    // If a node has a custom measure function we never want to round down its
-    // size as this could lead to unwanted text truncation.
-    const bool textRounding = node->getNodeType() == NodeType::Text;
-
-    node->setLayoutPosition(
-        roundValueToPixelGrid(nodeLeft, pointScaleFactor, false, textRounding),
-        PhysicalEdge::Left);
-
-    node->setLayoutPosition(
-        roundValueToPixelGrid(nodeTop, pointScaleFactor, false, textRounding),
-        PhysicalEdge::Top);
-
-    // We multiply dimension by scale factor and if the result is close to the
-    // whole number, we don't have any fraction To verify if the result is close
-    // to whole number we want to check both floor and ceil numbers
-    const bool hasFractionalWidth =
-        !yoga::inexactEquals(fmod(nodeWidth * pointScaleFactor, 1.0), 0) &&
-        !yoga::inexactEquals(fmod(nodeWidth * pointScaleFactor, 1.0), 1.0);
-    const bool hasFractionalHeight =
-        !yoga::inexactEquals(fmod(nodeHeight * pointScaleFactor, 1.0), 0) &&
-        !yoga::inexactEquals(fmod(nodeHeight * pointScaleFactor, 1.0), 1.0);
-
-    node->setLayoutDimension(
-        roundValueToPixelGrid(
-            absoluteNodeRight,
-            pointScaleFactor,
-            (textRounding && hasFractionalWidth),
-            (textRounding && !hasFractionalWidth)) -
-            roundValueToPixelGrid(
-                absoluteNodeLeft, pointScaleFactor, false, textRounding),
-        Dimension::Width);
-
-    node->setLayoutDimension(
-        roundValueToPixelGrid(
-            absoluteNodeBottom,
-            pointScaleFactor,
-            (textRounding && hasFractionalHeight),
-            (textRounding && !hasFractionalHeight)) -
-            roundValueToPixelGrid(
-                absoluteNodeTop, pointScaleFactor, false, textRounding),
-        Dimension::Height);
+  // If a node has a custom measure function we never want to round down its
+  // size as this could lead to unwanted text truncation.
+  const bool textRounding = node->getNodeType() == NodeType::Text;
+
+  node->setLayoutPosition(
+      roundValueToPixelGrid(nodeLeft, pointScaleFactor, false, textRounding),
+      PhysicalEdge::Left);
+
+  node->setLayoutPosition(
+      roundValueToPixelGrid(nodeTop, pointScaleFactor, false, textRounding),
+      PhysicalEdge::Top);
+
+  // We multiply dimension by scale factor and if the result is close to the
+  // whole number, we don't have any fraction To verify if the result is close
+  // to whole number we want to check both floor and ceil numbers
+  const bool hasFractionalWidth =
+      !yoga::inexactEquals(fmod(nodeWidth * pointScaleFactor, 1.0), 0) &&
+      !yoga::inexactEquals(fmod(nodeWidth * pointScaleFactor, 1.0), 1.0);
+  const bool hasFractionalHeight =
+      !yoga::inexactEquals(fmod(nodeHeight * pointScaleFactor, 1.0), 0) &&
+      !yoga::inexactEquals(fmod(nodeHeight * pointScaleFactor, 1.0), 1.0);
+
+  node->setLayoutDimension(
+      roundValueToPixelGrid(
+          absoluteNodeRight,
+          pointScaleFactor,
+          (textRounding && hasFractionalWidth),
+          (textRounding && !hasFractionalWidth)) -
+          roundValueToPixelGrid(
+              absoluteNodeLeft, pointScaleFactor, false, textRounding),
+      Dimension::Width);
+
+  node->setLayoutDimension(
+      roundValueToPixelGrid(
+          absoluteNodeBottom,
+          pointScaleFactor,
+          (textRounding && hasFractionalHeight),
+          (textRounding && !hasFractionalHeight)) -
+          roundValueToPixelGrid(
+              absoluteNodeTop, pointScaleFactor, false, textRounding),
+      Dimension::Height);
+}
+
+// Rounds the layout of up to kBatchSize siblings, and returns their unrounded
+// absolute positions in `absoluteNodeLefts` and `absoluteNodeTops`. Nodes
+// rounded to the nearest pixel, i.e. all but text, share one
+// roundValuesToPixelGrid() call.
+void roundSiblingsToPixelGrid(
+    yoga::Node* const* nodes,
+    const size_t count,
+    const double absoluteLeft,
+    const double absoluteTop,
+    double* absoluteNodeLefts,
+    double* absoluteNodeTops) {
+  // Per batched node: left, top, and the absolute left, top, right and bottom
+  constexpr size_t kValueCount = 6;
+  std::array<double, kBatchSize * kValueCount> values{};
+  std::array<float, kBatchSize * kValueCount> roundedValues{};
+  std::array<yoga::Node*, kBatchSize> batch{};
+  size_t batchCount = 0;
+  double batchPointScaleFactor = 0.0;
+
+  for (size_t i = 0; i < count; i++) {
+    yoga::Node* const node = nodes[i];
+    const auto& layout = node->getLayout();
+    const double nodeLeft = layout.position(PhysicalEdge::Left);
+    const double nodeTop = layout.position(PhysicalEdge::Top);
+    absoluteNodeLefts[i] = absoluteLeft + nodeLeft;
+    absoluteNodeTops[i] = absoluteTop + nodeTop;
+
+    const double pointScaleFactor = node->getConfig()->getPointScaleFactor();
+    if (pointScaleFactor == 0.0) {
+      continue;
+    }
+    if (batchCount == 0) {
+      batchPointScaleFactor = pointScaleFactor;
+    }
+    if (node->getNodeType() == NodeType::Text ||
+        pointScaleFactor != batchPointScaleFactor) {
+      roundNodeToPixelGrid(node, absoluteLeft, absoluteTop);
+      continue;
+    }
+
+    double* nodeValues = &values[batchCount * kValueCount];
+    nodeValues[0] = nodeLeft;
+    nodeValues[1] = nodeTop;
+    nodeValues[2] = absoluteNodeLefts[i];
+    nodeValues[3] = absoluteNodeTops[i];
+    nodeValues[4] = absoluteNodeLefts[i] + layout.dimension(Dimension::Width);
+    nodeValues[5] = absoluteNodeTops[i] + layout.dimension(Dimension::Height);
+    batch[batchCount++] = node;
   }
 
-  for (yoga::Node* child : node->getChildren()) {
-    roundLayoutResultsToPixelGrid(child, absoluteNodeLeft, absoluteNodeTop);
+  roundValuesToPixelGrid(
+      values.data(),
+      roundedValues.data(),
+      batchCount * kValueCount,
+      batchPointScaleFactor);
+
+  for (size_t i = 0; i < batchCount; i++) {
+    const float* nodeValues = &roundedValues[i * kValueCount];
+    batch[i]->setLayoutPosition(nodeValues[0], PhysicalEdge::Left);
+    batch[i]->setLayoutPosition(nodeValues[1], PhysicalEdge::Top);
+    batch[i]->setLayoutDimension(
+        nodeValues[4] - nodeValues[2], Dimension::Width);
+    batch[i]->setLayoutDimension(
+        nodeValues[5] - nodeValues[3], Dimension::Height);
+  }
+}
+
+void roundChildrenToPixelGrid(
+    yoga::Node* const node,
+    const double absoluteNodeLeft,
+    const double absoluteNodeTop,
+    const uint32_t generationCount) {
+  const auto& children = node->getChildren();
+  // Only the children near the window of a virtualizing node were laid out
+  const auto virtualizedChildren = node->getVirtualizedChildren();
+  size_t index = virtualizedChildren != nullptr
+      ? virtualizedChildren->getFirstLaidOutChild()
+      : 0;
+  const size_t endIndex = virtualizedChildren != nullptr
+      ? virtualizedChildren->getEndLaidOutChild()
+      : children.size();
+  while (index < endIndex) {
+    std::array<yoga::Node*, kBatchSize> batch{};
+    size_t count = 0;
+    while (index < endIndex && count < kBatchSize) {
+      yoga::Node* const child = children[index++];
+      if (needsRounding(
+              child, absoluteNodeLeft, absoluteNodeTop, generationCount)) {
+        batch[count++] = child;
+      }
+    }
+
+    std::array<double, kBatchSize> absoluteChildLefts{};
+    std::array<double, kBatchSize> absoluteChildTops{};
+    roundSiblingsToPixelGrid(
+        batch.data(),
+        count,
+        absoluteNodeLeft,
+        absoluteNodeTop,
+        absoluteChildLefts.data(),
+        absoluteChildTops.data());
+    for (size_t i = 0; i < count; i++) {
+      roundChildrenToPixelGrid(
+          batch[i],
+          absoluteChildLefts[i],
+          absoluteChildTops[i],
+          generationCount);
+    }
   }
 }
 
+} // namespace
+
+void roundLayoutResultsToPixelGrid(
+    yoga::Node* const node,
+    const double absoluteLeft,
+    const double absoluteTop) {
+  const double absoluteNodeLeft =
+      absoluteLeft + node->getLayout().position(PhysicalEdge::Left);
+  const double absoluteNodeTop =
+      absoluteTop + node->getLayout().position(PhysicalEdge::Top);
+
+  roundNodeToPixelGrid(node, absoluteLeft, absoluteTop);
+  roundChildrenToPixelGrid(
+      node,
+      absoluteNodeLeft,
+      absoluteNodeTop,
+      node->getLayout().generationCount);
+}
+
 } // namespace facebook::yoga
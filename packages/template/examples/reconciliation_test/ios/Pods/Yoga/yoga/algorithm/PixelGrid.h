@@ -7,6 +7,8 @@
 
 #pragma once
 
+#include <cstddef>
+
 #include <yoga/Yoga.h>
 #include <yoga/node/Node.h>
 
@@ -20,7 +22,19 @@ float roundValueToPixelGrid(
     const bool forceCeil,
     const bool forceFloor);
 
-// Round the layout results of a node and its subtree to the pixel grid.
+// Round `count` point values to the nearest physical pixel, as
+// roundValueToPixelGrid() without forced rounding does. The loop has no
+// branches so that the compiler can vectorize it.
+void roundValuesToPixelGrid(
+    const double* values,
+    float* roundedValues,
+    size_t count,
+    double pointScaleFactor);
+
+// Round the layout results of a node and its subtree to the pixel grid. The
+// node must have been laid out by the current pass. Descendants which the pass
+// did not visit keep their rounded layout, unless their absolute position
+// moved off the pixel grid.
 void roundLayoutResultsToPixelGrid(
     yoga::Node* const node,
     const double absoluteLeft,
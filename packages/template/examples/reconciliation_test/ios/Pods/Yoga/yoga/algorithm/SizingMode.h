@@ -7,6 +7,8 @@
 
 #pragma once
 
+#include <cstdint>
+
 #include <yoga/debug/AssertFatal.h>
 #include <yoga/enums/MeasureMode.h>
 
@@ -18,7 +20,7 @@ namespace facebook::yoga {
  * https://www.w3.org/TR/css-sizing-3/#auto-box-sizes
  * https://www.w3.org/TR/css-flexbox-1/#min-size-auto
  */
-enum class SizingMode {
+enum class SizingMode : uint8_t {
   /**
    * The size a box would take if its outer size filled the available space in
    * the given axis; in other words, the stretch fit into the available space,
@@ -0,0 +1,193 @@
+/*
+ * Copyright (c) Dotcorr Studio. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <yoga/algorithm/SubtreeMemo.h>
+#include <yoga/numeric/Comparison.h>
+
+namespace facebook::yoga {
+
+namespace {
+
+// Cached for subtrees which may not be copied, as 0 means no fingerprint
+constexpr uint64_t kNotCopyable = 1;
+
+bool isSameSubtree(const yoga::Node& a, const yoga::Node& b) {
+  if (a.getConfig() != b.getConfig() || a.getNodeType() != b.getNodeType() ||
+      a.hasMeasureFunc() != b.hasMeasureFunc() ||
+      a.getMeasureCacheKey() != b.getMeasureCacheKey() ||
+      a.alwaysFormsContainingBlock() != b.alwaysFormsContainingBlock() ||
+      a.isReferenceBaseline() != b.isReferenceBaseline() ||
+      a.getChildCount() != b.getChildCount() || a.style() != b.style()) {
+    return false;
+  }
+  for (size_t i = 0; i < a.getChildCount(); i++) {
+    if (!isSameSubtree(*a.getChild(i), *b.getChild(i))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool isSameConstraints(const LayoutConstraints& a, const LayoutConstraints& b) {
+  return yoga::inexactEquals(a.availableWidth, b.availableWidth) &&
+      yoga::inexactEquals(a.availableHeight, b.availableHeight) &&
+      a.widthSizingMode == b.widthSizingMode &&
+      a.heightSizingMode == b.heightSizingMode &&
+      yoga::inexactEquals(a.ownerWidth, b.ownerWidth) &&
+      yoga::inexactEquals(a.ownerHeight, b.ownerHeight);
+}
+
+void copyChildLayouts(
+    const yoga::Node& source,
+    yoga::Node& node,
+    const uint32_t generationCount) {
+  for (size_t i = 0; i < node.getChildCount(); i++) {
+    const yoga::Node& sourceChild = *source.getChild(i);
+    yoga::Node& child = *node.getChild(i);
+
+    // The cache statistics are the node's own
+    const uint32_t cacheHits = child.getLayout().cacheHits;
+    const uint32_t cacheMisses = child.getLayout().cacheMisses;
+    child.setLayout(sourceChild.getLayout());
+    child.getLayout().cacheHits = cacheHits;
+    child.getLayout().cacheMisses = cacheMisses;
+    // Laid out in this pass, to be rounded to the pixel grid at its position
+    child.getLayout().generationCount = generationCount;
+    child.setLineIndex(sourceChild.getLineIndex());
+    child.setHasNewLayout(true);
+    child.setDirty(false);
+    child.setHasDirtyDescendant(false);
+
+    copyChildLayouts(sourceChild, child, generationCount);
+  }
+}
+
+} // namespace
+
+uint64_t subtreeFingerprint(yoga::Node* const node) {
+  if (node->getFingerprint() != 0) {
+    return node->getFingerprint() == kNotCopyable ? 0
+                                                  : node->getFingerprint();
+  }
+
+  bool isCopyable = !node->hasBaselineFunc() &&
+      node->getVirtualizedChildren() == nullptr &&
+      (!node->hasMeasureFunc() || node->getMeasureCacheKey() != 0);
+
+  uint64_t hash = node->style().hash();
+  hash = Style::hashCombine(hash, yoga::to_underlying(node->getNodeType()));
+  hash = Style::hashCombine(hash, node->hasMeasureFunc());
+  hash = Style::hashCombine(hash, node->getMeasureCacheKey());
+  hash = Style::hashCombine(hash, node->alwaysFormsContainingBlock());
+  hash = Style::hashCombine(hash, node->isReferenceBaseline());
+  hash = Style::hashCombine(hash, node->getChildCount());
+  // Every child is hashed, as a node with a fingerprint must only have
+  // descendants with one (see Node::invalidateFingerprint())
+  for (auto child : node->getChildren()) {
+    const uint64_t childFingerprint = subtreeFingerprint(child);
+    isCopyable = isCopyable && childFingerprint != 0 &&
+        child->style().positionType() != PositionType::Absolute;
+    hash = Style::hashCombine(hash, childFingerprint);
+  }
+
+  if (!isCopyable) {
+    node->setFingerprint(kNotCopyable);
+    return 0;
+  }
+  if (hash <= kNotCopyable) {
+    hash += kNotCopyable + 1;
+  }
+  node->setFingerprint(hash);
+  return hash;
+}
+
+const SubtreeMemo::Entry* SubtreeMemo::find(
+    const yoga::Node& node,
+    const uint64_t fingerprint,
+    const LayoutConstraints& constraints,
+    const Direction ownerDirection,
+    const bool performLayout,
+    const uint32_t generationCount) const {
+  const Entry* entry = nullptr;
+  for (const Entry& candidate : sets_[setIndex(fingerprint, performLayout)]) {
+    if (candidate.fingerprint == fingerprint &&
+        candidate.performLayout == performLayout && candidate.node != &node &&
+        candidate.ownerDirection == ownerDirection &&
+        isSameConstraints(candidate.constraints, constraints)) {
+      entry = &candidate;
+      break;
+    }
+  }
+  if (entry == nullptr) {
+    return nullptr;
+  }
+
+  // A subtree sized in this pass is sized the same in the same constraints,
+  // but its layout is only left if it was not laid out again since
+  const yoga::Node& source = *entry->node;
+  const LayoutResults& layout = source.getLayout();
+  if (layout.generationCount != generationCount || source.isDirty()) {
+    return nullptr;
+  }
+  if (performLayout &&
+      (!isSameConstraints(layout.lastLayoutConstraints, constraints) ||
+       !yoga::inexactEquals(
+           layout.cachedLayout.availableWidth, constraints.availableWidth) ||
+       !yoga::inexactEquals(
+           layout.cachedLayout.availableHeight, constraints.availableHeight) ||
+       layout.cachedLayout.widthSizingMode != constraints.widthSizingMode ||
+       layout.cachedLayout.heightSizingMode != constraints.heightSizingMode ||
+       layout.lastOwnerDirection != ownerDirection)) {
+    return nullptr;
+  }
+  // The fingerprint is only a hash
+  return isSameSubtree(source, node) ? entry : nullptr;
+}
+
+void SubtreeMemo::insert(
+    const yoga::Node& node,
+    const uint64_t fingerprint,
+    const LayoutConstraints& constraints,
+    const Direction ownerDirection,
+    const bool performLayout) {
+  auto& set = sets_[setIndex(fingerprint, performLayout)];
+  Entry& entry = set[0].insertion <= set[1].insertion ? set[0] : set[1];
+  entry = {
+      fingerprint,
+      constraints,
+      ownerDirection,
+      performLayout,
+      node.getLayout().measuredDimension(Dimension::Width),
+      node.getLayout().measuredDimension(Dimension::Height),
+      &node,
+      ++insertions_};
+}
+
+void copySubtreeLayout(
+    const yoga::Node& source,
+    yoga::Node& node,
+    const uint32_t generationCount) {
+  const LayoutResults& sourceLayout = source.getLayout();
+  LayoutResults& layout = node.getLayout();
+
+  // The position of the node is its owner's to set
+  layout.setDirection(sourceLayout.direction());
+  layout.setHadOverflow(sourceLayout.hadOverflow());
+  for (auto edge :
+       {PhysicalEdge::Left,
+        PhysicalEdge::Top,
+        PhysicalEdge::Right,
+        PhysicalEdge::Bottom}) {
+    layout.setMargin(edge, sourceLayout.margin(edge));
+    layout.setBorder(edge, sourceLayout.border(edge));
+    layout.setPadding(edge, sourceLayout.padding(edge));
+  }
+
+  copyChildLayouts(source, node, generationCount);
+}
+
+} // namespace facebook::yoga
@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) Dotcorr Studio. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include <yoga/enums/Direction.h>
+#include <yoga/node/LayoutResults.h>
+#include <yoga/node/Node.h>
+
+namespace facebook::yoga {
+
+// Returns a hash of the style and structure of the subtree rooted at `node`,
+// or 0 if its layout may not be copied to another subtree: when it has a
+// baseline function, virtualizes its children, measures content without a
+// measure cache key, or has absolute descendants, whose containing block may
+// lie outside of it. The hashes are cached on the nodes until they change.
+uint64_t subtreeFingerprint(yoga::Node* node);
+
+/**
+ * The subtrees measured or laid out during a layout pass, by fingerprint and
+ * by the constraints they were sized in, so that a subtree identical to one of
+ * them may take its size and layout instead of being sized again (see
+ * YGConfigSetUseSubtreeMemoization()). A two-way set associative table of
+ * fixed size, a subtree replacing the older one of its set, which keeps the
+ * few kinds of rows of a list without growing with it.
+ */
+class SubtreeMemo {
+ public:
+  struct Entry {
+    uint64_t fingerprint = 0;
+    LayoutConstraints constraints;
+    Direction ownerDirection = Direction::Inherit;
+    bool performLayout = false;
+    float measuredWidth = 0.0f;
+    float measuredHeight = 0.0f;
+    const yoga::Node* node = nullptr;
+    uint32_t insertion = 0;
+  };
+
+  // Finds a subtree identical to the one of `node`, measured or laid out as
+  // `performLayout` says during the pass of `generationCount` in the same
+  // constraints, or returns nullptr
+  const Entry* find(
+      const yoga::Node& node,
+      uint64_t fingerprint,
+      const LayoutConstraints& constraints,
+      Direction ownerDirection,
+      bool performLayout,
+      uint32_t generationCount) const;
+
+  // Records the size `node` was just given, and its layout if `performLayout`
+  void insert(
+      const yoga::Node& node,
+      uint64_t fingerprint,
+      const LayoutConstraints& constraints,
+      Direction ownerDirection,
+      bool performLayout);
+
+ private:
+  static constexpr size_t kSetCount = 128;
+
+  // Measurements and layouts of a subtree go to different sets
+  static size_t setIndex(uint64_t fingerprint, bool performLayout) {
+    const uint64_t hash =
+        (fingerprint + (performLayout ? 1 : 0)) * 0x9e3779b97f4a7c15ull;
+    return static_cast<size_t>(hash >> 57) % kSetCount;
+  }
+
+  std::array<std::array<Entry, 2>, kSetCount> sets_{};
+  uint32_t insertions_ = 0;
+};
+
+// Gives `node` the layout `source`, found by SubtreeMemo::find(), had in the
+// same constraints, but for its measured dimensions, and its descendants those
+// of the descendants of `source`
+void copySubtreeLayout(
+    const yoga::Node& source,
+    yoga::Node& node,
+    uint32_t generationCount);
+
+} // namespace facebook::yoga
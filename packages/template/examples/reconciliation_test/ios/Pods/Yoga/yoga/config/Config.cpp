@@ -5,6 +5,8 @@
  * LICENSE file in the root directory of this source tree.
  */
 
+#include <algorithm>
+
 #include <yoga/config/Config.h>
 #include <yoga/debug/Log.h>
 #include <yoga/node/Node.h>
@@ -32,6 +34,22 @@ bool Config::useWebDefaults() const {
   return useWebDefaults_;
 }
 
+void Config::setUseLayoutBoundaries(bool useLayoutBoundaries) {
+  useLayoutBoundaries_ = useLayoutBoundaries;
+}
+
+bool Config::useLayoutBoundaries() const {
+  return useLayoutBoundaries_;
+}
+
+void Config::setUseSubtreeMemoization(bool useSubtreeMemoization) {
+  useSubtreeMemoization_ = useSubtreeMemoization;
+}
+
+bool Config::useSubtreeMemoization() const {
+  return useSubtreeMemoization_;
+}
+
 void Config::setExperimentalFeatureEnabled(
     ExperimentalFeature feature,
     bool enabled) {
@@ -112,6 +130,42 @@ YGNodeRef Config::cloneNode(
   return clone;
 }
 
+void Config::setMaxCachedMeasurements(size_t maxCachedMeasurements) {
+  maxCachedMeasurements_ = static_cast<uint32_t>(std::clamp<size_t>(
+      maxCachedMeasurements, 1, LayoutResults::MaxCachedMeasurements));
+}
+
+uint32_t Config::getMaxCachedMeasurements() const {
+  return maxCachedMeasurements_;
+}
+
+void Config::setMeasureCacheCapacity(size_t capacity) {
+  measureCache_ =
+      capacity > 0 ? std::make_unique<MeasureCache>(capacity) : nullptr;
+}
+
+MeasureCache* Config::getMeasureCache() const {
+  return measureCache_.get();
+}
+
+void Config::setExecutor(YGExecutorFunc executor) {
+  executor_ = executor;
+}
+
+bool Config::hasExecutor() const {
+  return executor_ != nullptr;
+}
+
+void Config::execute(YGTaskFunc task, void* taskData, size_t count) const {
+  if (executor_ != nullptr) {
+    executor_(this, task, taskData, count);
+  } else {
+    for (size_t i = 0; i < count; i++) {
+      task(taskData, i);
+    }
+  }
+}
+
 /*static*/ const Config& Config::getDefault() {
   static Config config{getDefaultLogger()};
   return config;
@@ -8,11 +8,14 @@
 #pragma once
 
 #include <bitset>
+#include <memory>
 
 #include <yoga/Yoga.h>
+#include <yoga/config/MeasureCache.h>
 #include <yoga/enums/Errata.h>
 #include <yoga/enums/ExperimentalFeature.h>
 #include <yoga/enums/LogLevel.h>
+#include <yoga/node/LayoutResults.h>
 
 // Tag struct used to form the opaque YGConfigRef for the public C API
 struct YGConfig {};
@@ -37,6 +40,12 @@ class YG_EXPORT Config : public ::YGConfig {
   void setUseWebDefaults(bool useWebDefaults);
   bool useWebDefaults() const;
 
+  void setUseLayoutBoundaries(bool useLayoutBoundaries);
+  bool useLayoutBoundaries() const;
+
+  void setUseSubtreeMemoization(bool useSubtreeMemoization);
+  bool useSubtreeMemoization() const;
+
   void setExperimentalFeatureEnabled(ExperimentalFeature feature, bool enabled);
   bool isExperimentalFeatureEnabled(ExperimentalFeature feature) const;
   ExperimentalFeatureSet getEnabledExperiments() const;
@@ -64,17 +73,32 @@ class YG_EXPORT Config : public ::YGConfig {
   YGNodeRef
   cloneNode(YGNodeConstRef node, YGNodeConstRef owner, size_t childIndex) const;
 
+  void setMaxCachedMeasurements(size_t maxCachedMeasurements);
+  uint32_t getMaxCachedMeasurements() const;
+
+  void setMeasureCacheCapacity(size_t capacity);
+  MeasureCache* getMeasureCache() const;
+
+  void setExecutor(YGExecutorFunc executor);
+  bool hasExecutor() const;
+  void execute(YGTaskFunc task, void* taskData, size_t count) const;
+
   static const Config& getDefault();
 
  private:
   YGCloneNodeFunc cloneNodeCallback_;
   YGLogger logger_;
+  YGExecutorFunc executor_ = nullptr;
+  std::unique_ptr<MeasureCache> measureCache_;
 
   bool useWebDefaults_ : 1 = false;
+  bool useLayoutBoundaries_ : 1 = false;
+  bool useSubtreeMemoization_ : 1 = false;
 
   ExperimentalFeatureSet experimentalFeatures_{};
   Errata errata_ = Errata::None;
   float pointScaleFactor_ = 1.0f;
+  uint32_t maxCachedMeasurements_ = LayoutResults::DefaultCachedMeasurements;
   void* context_ = nullptr;
 };
 
@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) Dotcorr Studio. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <algorithm>
+#include <bit>
+
+#include <yoga/config/MeasureCache.h>
+
+namespace facebook::yoga {
+
+namespace {
+
+// Constraints are compared bitwise, so that undefined (NaN) sizes match.
+uint32_t bits(float value) {
+  return std::bit_cast<uint32_t>(value);
+}
+
+uint64_t mix(uint64_t value) {
+  value ^= value >> 30;
+  value *= 0xbf58476d1ce4e5b9ull;
+  value ^= value >> 27;
+  value *= 0x94d049bb133111ebull;
+  value ^= value >> 31;
+  return value;
+}
+
+} // namespace
+
+MeasureCache::MeasureCache(size_t capacity)
+    : entries_(std::bit_ceil(std::max<size_t>(capacity, 2))) {}
+
+bool MeasureCache::Entry::matches(
+    uint64_t key,
+    uint32_t width,
+    MeasureMode widthMode,
+    uint32_t height,
+    MeasureMode heightMode) const {
+  return this->key == key && this->width == width &&
+      this->widthMode == widthMode && this->height == height &&
+      this->heightMode == heightMode;
+}
+
+size_t MeasureCache::bucket(
+    uint64_t key,
+    uint32_t width,
+    MeasureMode widthMode,
+    uint32_t height,
+    MeasureMode heightMode) const {
+  const uint64_t constraints = (uint64_t{width} << 32) | height;
+  const uint64_t modes = (static_cast<uint64_t>(widthMode) << 2) |
+      static_cast<uint64_t>(heightMode);
+  const uint64_t hash = mix(key ^ mix(constraints ^ (modes << 60)));
+  return static_cast<size_t>(hash) & (entries_.size() - 1) & ~size_t{1};
+}
+
+std::optional<YGSize> MeasureCache::get(
+    uint64_t key,
+    float width,
+    MeasureMode widthMode,
+    float height,
+    MeasureMode heightMode) {
+  const size_t index =
+      bucket(key, bits(width), widthMode, bits(height), heightMode);
+
+  std::lock_guard<std::mutex> lock{mutex_};
+  for (size_t way = 0; way < 2; way++) {
+    auto& entry = entries_[index + way];
+    if (entry.matches(key, bits(width), widthMode, bits(height), heightMode)) {
+      entry.recentlyUsed = true;
+      entries_[index + (way ^ 1)].recentlyUsed = false;
+      return entry.measuredSize;
+    }
+  }
+  return std::nullopt;
+}
+
+void MeasureCache::put(
+    uint64_t key,
+    float width,
+    MeasureMode widthMode,
+    float height,
+    MeasureMode heightMode,
+    YGSize measuredSize) {
+  const size_t index =
+      bucket(key, bits(width), widthMode, bits(height), heightMode);
+
+  std::lock_guard<std::mutex> lock{mutex_};
+  // Replace the way which was not used most recently
+  const size_t way = entries_[index].recentlyUsed ? 1 : 0;
+  entries_[index + way] = {
+      key,
+      bits(width),
+      bits(height),
+      widthMode,
+      heightMode,
+      true,
+      measuredSize};
+  entries_[index + (way ^ 1)].recentlyUsed = false;
+}
+
+void MeasureCache::clear() {
+  std::lock_guard<std::mutex> lock{mutex_};
+  std::fill(entries_.begin(), entries_.end(), Entry{});
+}
+
+} // namespace facebook::yoga
@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) Dotcorr Studio. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+#include <yoga/Yoga.h>
+#include <yoga/enums/MeasureMode.h>
+
+namespace facebook::yoga {
+
+/**
+ * Measure function results shared by every node of a Config, keyed by a
+ * content key supplied by the node (see YGNodeSetMeasureCacheKey()) along with
+ * the constraints the node was measured under. Nodes with the same content,
+ * such as repeated labels in a list, are measured once across the whole tree
+ * and across layout passes.
+ *
+ * The cache is a fixed size, two-way set associative table, so lookups never
+ * allocate. It may be accessed concurrently when layout runs on an executor.
+ */
+class MeasureCache {
+ public:
+  explicit MeasureCache(size_t capacity);
+
+  size_t capacity() const {
+    return entries_.size();
+  }
+
+  std::optional<YGSize> get(
+      uint64_t key,
+      float width,
+      MeasureMode widthMode,
+      float height,
+      MeasureMode heightMode);
+
+  void put(
+      uint64_t key,
+      float width,
+      MeasureMode widthMode,
+      float height,
+      MeasureMode heightMode,
+      YGSize measuredSize);
+
+  void clear();
+
+ private:
+  struct Entry {
+    uint64_t key = 0;
+    uint32_t width = 0;
+    uint32_t height = 0;
+    MeasureMode widthMode = MeasureMode::Undefined;
+    MeasureMode heightMode = MeasureMode::Undefined;
+    bool recentlyUsed = false;
+    YGSize measuredSize{};
+
+    bool matches(
+        uint64_t key,
+        uint32_t width,
+        MeasureMode widthMode,
+        uint32_t height,
+        MeasureMode heightMode) const;
+  };
+
+  size_t bucket(
+      uint64_t key,
+      uint32_t width,
+      MeasureMode widthMode,
+      uint32_t height,
+      MeasureMode heightMode) const;
+
+  std::mutex mutex_;
+  std::vector<Entry> entries_;
+};
+
+} // namespace facebook::yoga
@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+// @generated by enums.py
+// clang-format off
+#pragma once
+
+#include <cstdint>
+#include <yoga/YGEnums.h>
+#include <yoga/enums/YogaEnums.h>
+
+namespace facebook::yoga {
+
+enum class StyleProperty : uint8_t {
+  Direction = YGStylePropertyDirection,
+  FlexDirection = YGStylePropertyFlexDirection,
+  JustifyContent = YGStylePropertyJustifyContent,
+  AlignContent = YGStylePropertyAlignContent,
+  AlignItems = YGStylePropertyAlignItems,
+  AlignSelf = YGStylePropertyAlignSelf,
+  PositionType = YGStylePropertyPositionType,
+  FlexWrap = YGStylePropertyFlexWrap,
+  Overflow = YGStylePropertyOverflow,
+  Display = YGStylePropertyDisplay,
+  Flex = YGStylePropertyFlex,
+  FlexGrow = YGStylePropertyFlexGrow,
+  FlexShrink = YGStylePropertyFlexShrink,
+  FlexBasis = YGStylePropertyFlexBasis,
+  Position = YGStylePropertyPosition,
+  Margin = YGStylePropertyMargin,
+  Padding = YGStylePropertyPadding,
+  Border = YGStylePropertyBorder,
+  Gap = YGStylePropertyGap,
+  AspectRatio = YGStylePropertyAspectRatio,
+  Width = YGStylePropertyWidth,
+  Height = YGStylePropertyHeight,
+  MinWidth = YGStylePropertyMinWidth,
+  MinHeight = YGStylePropertyMinHeight,
+  MaxWidth = YGStylePropertyMaxWidth,
+  MaxHeight = YGStylePropertyMaxHeight,
+};
+
+template <>
+constexpr int32_t ordinalCount<StyleProperty>() {
+  return 26;
+}
+
+constexpr StyleProperty scopedEnum(YGStyleProperty unscoped) {
+  return static_cast<StyleProperty>(unscoped);
+}
+
+constexpr YGStyleProperty unscopedEnum(StyleProperty scoped) {
+  return static_cast<YGStyleProperty>(scoped);
+}
+
+inline const char* toString(StyleProperty e) {
+  return YGStylePropertyToString(unscopedEnum(e));
+}
+
+} // namespace facebook::yoga
@@ -44,6 +44,10 @@ struct LayoutData {
   int measureCallbacks;
   std::array<int, static_cast<uint8_t>(LayoutPassReason::COUNT)>
       measureCallbackReasonsCount;
+  int measureCacheEvictions;
+  int sharedMeasureCacheHits;
+  int memoizedSubtrees;
+  int intrinsicSizeHits;
 };
 
 const char* LayoutPassReasonToString(const LayoutPassReason value);
@@ -122,6 +126,9 @@ struct Event::TypedData<Event::MeasureCallbackEnd> {
 template <>
 struct Event::TypedData<Event::NodeLayout> {
   LayoutType layoutType;
+  // Lifetime cache hits and misses of the node
+  uint32_t cacheHits;
+  uint32_t cacheMisses;
 };
 
 } // namespace facebook::yoga
@@ -7,7 +7,10 @@
 
 #pragma once
 
+#include <array>
 #include <cmath>
+#include <cstddef>
+#include <memory>
 
 #include <yoga/Yoga.h>
 
@@ -25,6 +28,10 @@ struct CachedMeasurement {
   float computedWidth{-1};
   float computedHeight{-1};
 
+  // Tick of the owning node's cache at which the entry was last used, used to
+  // pick the least recently used entry for replacement. Not part of equality.
+  uint32_t lastUsed{0};
+
   bool operator==(CachedMeasurement measurement) const {
     bool isEqual = widthSizingMode == measurement.widthSizingMode &&
         heightSizingMode == measurement.heightSizingMode;
@@ -50,4 +57,92 @@ struct CachedMeasurement {
   }
 };
 
+/**
+ * The measurements cached by a node. Most nodes are only measured in a few
+ * constraints, so the first entries are stored in the node and the others in
+ * an array allocated when an entry past them is first used.
+ */
+class CachedMeasurements {
+ public:
+  static constexpr size_t Capacity = 16;
+  static constexpr size_t InlineCapacity = 4;
+
+  CachedMeasurements() = default;
+  CachedMeasurements(const CachedMeasurements& other);
+  CachedMeasurements(CachedMeasurements&&) noexcept = default;
+  CachedMeasurements& operator=(const CachedMeasurements& other);
+  CachedMeasurements& operator=(CachedMeasurements&&) noexcept = default;
+
+  // The entry must have been returned by allocate() before
+  CachedMeasurement& operator[](size_t index) {
+    return index < InlineCapacity ? inline_[index]
+                                  : (*overflow_)[index - InlineCapacity];
+  }
+
+  const CachedMeasurement& operator[](size_t index) const {
+    return index < InlineCapacity ? inline_[index]
+                                  : (*overflow_)[index - InlineCapacity];
+  }
+
+  // Returns the entry at `index`, allocating the entries past the inline ones
+  // if it is one of them
+  CachedMeasurement& allocate(size_t index) {
+    if (index >= InlineCapacity && !overflow_) {
+      overflow_ = std::make_unique<Overflow>();
+    }
+    return (*this)[index];
+  }
+
+  // Whether entries past the inline ones were allocated
+  bool hasOverflow() const {
+    return overflow_ != nullptr;
+  }
+
+  // Entries which were never allocated compare as default ones
+  bool operator==(const CachedMeasurements& other) const;
+
+ private:
+  using Overflow = std::array<CachedMeasurement, Capacity - InlineCapacity>;
+
+  std::array<CachedMeasurement, InlineCapacity> inline_ = {};
+  std::unique_ptr<Overflow> overflow_;
+};
+
+inline CachedMeasurements::CachedMeasurements(const CachedMeasurements& other)
+    : inline_{other.inline_},
+      overflow_{
+          other.overflow_ ? std::make_unique<Overflow>(*other.overflow_)
+                          : nullptr} {}
+
+inline CachedMeasurements& CachedMeasurements::operator=(
+    const CachedMeasurements& other) {
+  if (this != &other) {
+    inline_ = other.inline_;
+    if (!other.overflow_) {
+      overflow_.reset();
+    } else if (overflow_) {
+      *overflow_ = *other.overflow_;
+    } else {
+      overflow_ = std::make_unique<Overflow>(*other.overflow_);
+    }
+  }
+  return *this;
+}
+
+inline bool CachedMeasurements::operator==(
+    const CachedMeasurements& other) const {
+  if (inline_ != other.inline_) {
+    return false;
+  }
+  const CachedMeasurement empty{};
+  for (size_t i = 0; i < Capacity - InlineCapacity; i++) {
+    const auto& entry = overflow_ ? (*overflow_)[i] : empty;
+    const auto& otherEntry = other.overflow_ ? (*other.overflow_)[i] : empty;
+    if (!(entry == otherEntry)) {
+      return false;
+    }
+  }
+  return true;
+}
+
 } // namespace facebook::yoga
@@ -0,0 +1,47 @@
+/*
+ * Copyright (c) Dotcorr Studio. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <algorithm>
+
+#include <yoga/node/IntrinsicSizes.h>
+#include <yoga/numeric/Comparison.h>
+
+namespace facebook::yoga {
+
+IntrinsicSizes::IntrinsicSizes(const YGSize* sizes, size_t count)
+    : sizes_(sizes, sizes + count) {}
+
+std::optional<YGSize> IntrinsicSizes::measure(
+    float width,
+    MeasureMode widthMode,
+    float height,
+    MeasureMode heightMode) const {
+  auto size = sizes_.end() - 1;
+  if (widthMode != MeasureMode::Undefined) {
+    // The first size wider than the width, which is otherwise fitted within
+    // float error
+    size = std::upper_bound(
+        sizes_.begin(),
+        sizes_.end(),
+        width,
+        [](float width, const YGSize& size) {
+          return width < size.width && !yoga::inexactEquals(width, size.width);
+        });
+    if (size == sizes_.begin()) {
+      return std::nullopt;
+    }
+    --size;
+  }
+
+  if (heightMode == MeasureMode::AtMost && height < size->height &&
+      !yoga::inexactEquals(height, size->height)) {
+    return std::nullopt;
+  }
+  return *size;
+}
+
+} // namespace facebook::yoga
@@ -0,0 +1,46 @@
+/*
+ * Copyright (c) Dotcorr Studio. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+#include <yoga/Yoga.h>
+
+#include <yoga/enums/MeasureMode.h>
+
+namespace facebook::yoga {
+
+/**
+ * The sizes a measured node's content lays out at, one per width at which it
+ * lays out differently, e.g. per set of line breaks of a text (see
+ * YGNodeSetIntrinsicSizes()).
+ *
+ * Sizes are ordered by increasing width, from the min-content size, the
+ * narrowest the content lays out at without overflowing, to the max-content
+ * size. In a given width, the content takes the widest size fitting it, found
+ * by binary search.
+ */
+class IntrinsicSizes {
+ public:
+  IntrinsicSizes(const YGSize* sizes, size_t count);
+
+  // The size of the content in the given constraints, or nullopt if they are
+  // narrower than its min-content width, or shorter than its height
+  std::optional<YGSize> measure(
+      float width,
+      MeasureMode widthMode,
+      float height,
+      MeasureMode heightMode) const;
+
+ private:
+  std::vector<YGSize> sizes_;
+};
+
+} // namespace facebook::yoga
@@ -12,7 +12,7 @@
 
 namespace facebook::yoga {
 
-bool LayoutResults::operator==(LayoutResults layout) const {
+bool LayoutResults::operator==(const LayoutResults& layout) const {
   bool isEqual = yoga::inexactEquals(position_, layout.position_) &&
       yoga::inexactEquals(dimensions_, layout.dimensions_) &&
       yoga::inexactEquals(margin_, layout.margin_) &&
@@ -23,12 +23,8 @@ bool LayoutResults::operator==(LayoutResults layout) const {
       lastOwnerDirection == layout.lastOwnerDirection &&
       nextCachedMeasurementsIndex == layout.nextCachedMeasurementsIndex &&
       cachedLayout == layout.cachedLayout &&
-      computedFlexBasis == layout.computedFlexBasis;
-
-  for (uint32_t i = 0; i < LayoutResults::MaxCachedMeasurements && isEqual;
-       ++i) {
-    isEqual = isEqual && cachedMeasurements[i] == layout.cachedMeasurements[i];
-  }
+      computedFlexBasis == layout.computedFlexBasis &&
+      cachedMeasurements == layout.cachedMeasurements;
 
   if (!yoga::isUndefined(measuredDimensions_[0]) ||
       !yoga::isUndefined(layout.measuredDimensions_[0])) {
@@ -9,6 +9,7 @@
 
 #include <array>
 
+#include <yoga/algorithm/SizingMode.h>
 #include <yoga/debug/AssertFatal.h>
 #include <yoga/enums/Dimension.h>
 #include <yoga/enums/Direction.h>
@@ -19,10 +20,40 @@
 
 namespace facebook::yoga {
 
+struct LayoutConstraints {
+  float availableWidth{-1};
+  float availableHeight{-1};
+  SizingMode widthSizingMode{SizingMode::MaxContent};
+  SizingMode heightSizingMode{SizingMode::MaxContent};
+  // Size of the owner, which percentages of the node resolve against
+  float ownerWidth{YGUndefined};
+  float ownerHeight{YGUndefined};
+};
+
 struct LayoutResults {
-  // This value was chosen based on empirical data:
-  // 98% of analyzed layouts require less than 8 entries.
-  static constexpr int32_t MaxCachedMeasurements = 8;
+  // Upper bound of the per-node measurement cache size, which is configured
+  // per Config (see Config::setMaxCachedMeasurements()).
+  static constexpr int32_t MaxCachedMeasurements =
+      static_cast<int32_t>(CachedMeasurements::Capacity);
+
+  // The default number of cached measurements. This value was chosen based on
+  // empirical data: 98% of analyzed layouts require less than 8 entries.
+  static constexpr int32_t DefaultCachedMeasurements = 8;
+
+ private:
+  // The geometry of the node, read and written throughout a layout pass,
+  // comes first so that it shares cache lines with the node
+  Direction direction_ : bitCount<Direction>() = Direction::Inherit;
+  bool hadOverflow_ : 1 = false;
+
+  std::array<float, 2> dimensions_ = {{YGUndefined, YGUndefined}};
+  std::array<float, 2> measuredDimensions_ = {{YGUndefined, YGUndefined}};
+  std::array<float, 4> position_ = {};
+  std::array<float, 4> margin_ = {};
+  std::array<float, 4> border_ = {};
+  std::array<float, 4> padding_ = {};
+
+ public:
 
   uint32_t computedFlexBasisGeneration = 0;
   FloatOptional computedFlexBasis = {};
@@ -32,11 +63,26 @@ struct LayoutResults {
   uint32_t generationCount = 0;
   Direction lastOwnerDirection = Direction::Inherit;
 
+  // Number of entries of cachedMeasurements in use. Once the configured size
+  // is reached, the least recently used entry is replaced.
   uint32_t nextCachedMeasurementsIndex = 0;
-  std::array<CachedMeasurement, MaxCachedMeasurements> cachedMeasurements = {};
+  CachedMeasurements cachedMeasurements;
 
   CachedMeasurement cachedLayout{};
 
+  // Constraints the node was last laid out in, for laying out a layout
+  // boundary again. Unlike cachedLayout, they survive invalidation of the
+  // caches, and cover layouts answered from a cached measurement.
+  LayoutConstraints lastLayoutConstraints{};
+
+  // Incremented whenever a cache entry is used, to order entries by recency
+  uint32_t cacheTick = 0;
+
+  // Lifetime count of layout and measure requests answered from, or missing,
+  // the caches above.
+  uint32_t cacheHits = 0;
+  uint32_t cacheMisses = 0;
+
   Direction direction() const {
     return direction_;
   }
@@ -101,21 +147,10 @@ struct LayoutResults {
     padding_[yoga::to_underlying(physicalEdge)] = dimension;
   }
 
-  bool operator==(LayoutResults layout) const;
-  bool operator!=(LayoutResults layout) const {
+  bool operator==(const LayoutResults& layout) const;
+  bool operator!=(const LayoutResults& layout) const {
     return !(*this == layout);
   }
-
- private:
-  Direction direction_ : bitCount<Direction>() = Direction::Inherit;
-  bool hadOverflow_ : 1 = false;
-
-  std::array<float, 2> dimensions_ = {{YGUndefined, YGUndefined}};
-  std::array<float, 2> measuredDimensions_ = {{YGUndefined, YGUndefined}};
-  std::array<float, 4> position_ = {};
-  std::array<float, 4> margin_ = {};
-  std::array<float, 4> border_ = {};
-  std::array<float, 4> padding_ = {};
 };
 
 } // namespace facebook::yoga
@@ -9,15 +9,42 @@
 #include <cstddef>
 #include <iostream>
 
+#include <yoga/algorithm/Align.h>
+#include <yoga/algorithm/Baseline.h>
 #include <yoga/debug/AssertFatal.h>
 #include <yoga/node/Node.h>
 #include <yoga/numeric/Comparison.h>
 
 namespace facebook::yoga {
 
+namespace {
+
+// Whether calculateBaseline() may read the baseline of `owner` from `child`
+bool mayProvideBaseline(const Node* owner, const Node* child) {
+  if (child->style().positionType() == PositionType::Absolute) {
+    return false;
+  }
+  if (resolveChildAlignment(owner, child) == Align::Baseline ||
+      child->isReferenceBaseline()) {
+    return true;
+  }
+  // Otherwise the first child in flow is used
+  for (const Node* sibling : owner->getChildren()) {
+    if (sibling->style().positionType() != PositionType::Absolute) {
+      return sibling == child;
+    }
+  }
+  return false;
+}
+
+} // namespace
+
 Node::Node() : Node{&Config::getDefault()} {}
 
-Node::Node(const yoga::Config* config) : config_{config} {
+Node::Node(const yoga::Config* config) : Node{config, nullptr} {}
+
+Node::Node(const yoga::Config* config, NodeArena* arena)
+    : config_{config}, children_{ArenaAllocator<Node*>{arena}} {
   yoga::assertFatal(
       config != nullptr, "Attempting to construct Node with null config");
 
@@ -26,23 +53,45 @@ Node::Node(const yoga::Config* config) : config_{config} {
   }
 }
 
-Node::Node(Node&& node) {
+Node::Node(const Node& node)
+    : hasNewLayout_{node.hasNewLayout_},
+      isReferenceBaseline_{node.isReferenceBaseline_},
+      isDirty_{node.isDirty_},
+      alwaysFormsContainingBlock_{node.alwaysFormsContainingBlock_},
+      hasDirtyDescendant_{node.hasDirtyDescendant_},
+      hasPendingNewLayouts_{node.hasPendingNewLayouts_},
+      nodeType_{node.nodeType_},
+      config_{node.config_},
+      owner_{node.owner_},
+      children_{node.children_},
+      lineIndex_{node.lineIndex_},
+      resolvedDimensions_{node.resolvedDimensions_},
+      style_{node.style_},
+      layout_{node.layout_},
+      measureFunc_{node.measureFunc_},
+      context_{node.context_},
+      measureCacheKey_{node.measureCacheKey_},
+      extras_{node.extras_ ? std::make_unique<Extras>(*node.extras_) : nullptr} {
+}
+
+Node::Node(Node&& node)
+    : children_{std::move(node.children_)}, extras_{std::move(node.extras_)} {
   hasNewLayout_ = node.hasNewLayout_;
   isReferenceBaseline_ = node.isReferenceBaseline_;
   isDirty_ = node.isDirty_;
   alwaysFormsContainingBlock_ = node.alwaysFormsContainingBlock_;
+  hasDirtyDescendant_ = node.hasDirtyDescendant_;
+  hasPendingNewLayouts_ = node.hasPendingNewLayouts_;
   nodeType_ = node.nodeType_;
-  context_ = node.context_;
-  measureFunc_ = node.measureFunc_;
-  baselineFunc_ = node.baselineFunc_;
-  dirtiedFunc_ = node.dirtiedFunc_;
-  style_ = node.style_;
-  layout_ = node.layout_;
-  lineIndex_ = node.lineIndex_;
-  owner_ = node.owner_;
-  children_ = std::move(node.children_);
   config_ = node.config_;
+  owner_ = node.owner_;
+  lineIndex_ = node.lineIndex_;
   resolvedDimensions_ = node.resolvedDimensions_;
+  style_ = node.style_;
+  layout_ = std::move(node.layout_);
+  measureFunc_ = node.measureFunc_;
+  context_ = node.context_;
+  measureCacheKey_ = node.measureCacheKey_;
   for (auto c : children_) {
     c->setOwner(this);
   }
@@ -58,7 +107,7 @@ YGSize Node::measure(
 }
 
 float Node::baseline(float width, float height) const {
-  return baselineFunc_(this, width, height);
+  return extras_->baselineFunc(this, width, height);
 }
 
 float Node::dimensionWithMargin(
@@ -94,6 +143,34 @@ void Node::setMeasureFunc(YGMeasureFunc measureFunc) {
   measureFunc_ = measureFunc;
 }
 
+void Node::setIntrinsicSizes(const YGSize* sizes, size_t count) {
+  if (count == 0) {
+    if (extras_) {
+      extras_->intrinsicSizes.reset();
+    }
+    return;
+  }
+  for (size_t i = 1; i < count; i++) {
+    yoga::assertFatalWithNode(
+        this,
+        sizes[i - 1].width <= sizes[i].width,
+        "Intrinsic sizes must be ordered by increasing width");
+  }
+  extras().intrinsicSizes.emplace(sizes, count);
+}
+
+void Node::setVirtualizesChildren(bool virtualizes, float estimatedExtent) {
+  if (!virtualizes) {
+    if (extras_) {
+      extras_->virtualizedChildren.reset();
+    }
+  } else if (auto virtualizedChildren = getVirtualizedChildren()) {
+    virtualizedChildren->setEstimatedExtent(estimatedExtent);
+  } else {
+    extras().virtualizedChildren.emplace(children_.size(), estimatedExtent);
+  }
+}
+
 void Node::replaceChild(Node* child, size_t index) {
   children_[index] = child;
 }
@@ -104,6 +181,9 @@ void Node::replaceChild(Node* oldChild, Node* newChild) {
 
 void Node::insertChild(Node* child, size_t index) {
   children_.insert(children_.begin() + static_cast<ptrdiff_t>(index), child);
+  if (auto virtualizedChildren = getVirtualizedChildren()) {
+    virtualizedChildren->insertChild(index);
+  }
 }
 
 void Node::setConfig(yoga::Config* config) {
@@ -115,7 +195,7 @@ void Node::setConfig(yoga::Config* config) {
       "UseWebDefaults may not be changed after constructing a Node");
 
   if (yoga::configUpdateInvalidatesLayout(*config_, *config)) {
-    markDirtyAndPropagate();
+    markStyleDirtyAndPropagate();
   }
 
   config_ = config;
@@ -125,17 +205,23 @@ void Node::setDirty(bool isDirty) {
   if (isDirty == isDirty_) {
     return;
   }
+  setDirtyFlag(isDirty);
+  if (isDirty && extras_ && extras_->dirtiedFunc) {
+    extras_->dirtiedFunc(this);
+  }
+}
+
+void Node::setDirtyFlag(bool isDirty) {
   isDirty_ = isDirty;
-  if (isDirty && dirtiedFunc_) {
-    dirtiedFunc_(this);
+  if (isDirty) {
+    invalidateFingerprint();
   }
 }
 
 bool Node::removeChild(Node* child) {
-  std::vector<Node*>::iterator p =
-      std::find(children_.begin(), children_.end(), child);
+  auto p = std::find(children_.begin(), children_.end(), child);
   if (p != children_.end()) {
-    children_.erase(p);
+    removeChild(static_cast<size_t>(p - children_.begin()));
     return true;
   }
   return false;
@@ -143,6 +229,9 @@ bool Node::removeChild(Node* child) {
 
 void Node::removeChild(size_t index) {
   children_.erase(children_.begin() + static_cast<ptrdiff_t>(index));
+  if (auto virtualizedChildren = getVirtualizedChildren()) {
+    virtualizedChildren->removeChild(index);
+  }
 }
 
 void Node::setLayoutDirection(Direction direction) {
@@ -288,29 +377,88 @@ Direction Node::resolveDirection(const Direction ownerDirection) {
 void Node::clearChildren() {
   children_.clear();
   children_.shrink_to_fit();
+  if (auto virtualizedChildren = getVirtualizedChildren()) {
+    virtualizedChildren->reset(0);
+  }
 }
 
 // Other Methods
 
+Node* Node::cloneChildIfNeeded(size_t index) {
+  Node*& child = children_[index];
+  if (child->getOwner() != this) {
+    child = resolveRef(config_->cloneNode(child, this, index));
+    child->setOwner(this);
+  }
+  return child;
+}
+
 void Node::cloneChildrenIfNeeded() {
-  size_t i = 0;
-  for (Node*& child : children_) {
-    if (child->getOwner() != this) {
-      child = resolveRef(config_->cloneNode(child, this, i));
-      child->setOwner(this);
-    }
-    i += 1;
+  for (size_t i = 0; i < children_.size(); i++) {
+    cloneChildIfNeeded(i);
   }
 }
 
 void Node::markDirtyAndPropagate() {
+  // The node may be dirty already, with ancestors fingerprinted since
+  invalidateFingerprint();
   if (!isDirty_) {
     setDirty(true);
     setLayoutComputedFlexBasis(FloatOptional());
     if (owner_) {
-      owner_->markDirtyAndPropagate();
+      if (isLayoutBoundary()) {
+        markHasDirtyDescendant();
+      } else {
+        owner_->markDirtyAndPropagate();
+      }
+    }
+  }
+}
+
+void Node::markStyleDirtyAndPropagate() {
+  markDirtyAndPropagate();
+  // The owner lays the node out from its style, even past a layout boundary
+  if (owner_) {
+    owner_->markDirtyAndPropagate();
+  }
+}
+
+void Node::markHasDirtyDescendant() {
+  for (Node* node = this; node != nullptr && !node->hasDirtyDescendant_;
+       node = node->owner_) {
+    node->hasDirtyDescendant_ = true;
+  }
+}
+
+bool Node::isLayoutBoundary() const {
+  if (owner_ == nullptr || !config_->useLayoutBoundaries()) {
+    return false;
+  }
+
+  // The size must not depend on the content or the owner, and the owner must
+  // have laid out the node at that size
+  if (style_.dimension(Dimension::Width).unit() != Unit::Point ||
+      style_.dimension(Dimension::Height).unit() != Unit::Point ||
+      style_.positionType() == PositionType::Absolute ||
+      style_.display() == Display::None ||
+      layout_.lastLayoutConstraints.widthSizingMode != SizingMode::StretchFit ||
+      layout_.lastLayoutConstraints.heightSizingMode !=
+          SizingMode::StretchFit) {
+    return false;
+  }
+
+  // Nor may an owner read the baseline of the node, which depends on its
+  // content, or the baseline of an ancestor read from the node
+  for (const Node* node = this; node->owner_ != nullptr;
+       node = node->owner_) {
+    if (isBaselineLayout(node->owner_)) {
+      return false;
+    }
+    if (!mayProvideBaseline(node->owner_, node)) {
+      break;
     }
   }
+  return true;
 }
 
 float Node::resolveFlexGrow() const {
@@ -356,7 +504,7 @@ void Node::reset() {
   yoga::assertFatalWithNode(
       this, owner_ == nullptr, "Cannot reset a node still attached to a owner");
 
-  *this = Node{getConfig()};
+  *this = Node{getConfig(), getArena()};
 }
 
 } // namespace facebook::yoga
@@ -9,6 +9,8 @@
 
 #include <stdio.h>
 #include <cstdint>
+#include <memory>
+#include <optional>
 #include <vector>
 
 #include <yoga/Yoga.h>
@@ -21,7 +23,10 @@
 #include <yoga/enums/MeasureMode.h>
 #include <yoga/enums/NodeType.h>
 #include <yoga/enums/PhysicalEdge.h>
+#include <yoga/node/IntrinsicSizes.h>
 #include <yoga/node/LayoutResults.h>
+#include <yoga/node/NodeArena.h>
+#include <yoga/node/VirtualizedChildren.h>
 #include <yoga/style/Style.h>
 
 // Tag struct used to form the opaque YGNodeRef for the public C API
@@ -31,14 +36,17 @@ namespace facebook::yoga {
 
 class YG_EXPORT Node : public ::YGNode {
  public:
+  using Children = std::vector<Node*, ArenaAllocator<Node*>>;
+
   Node();
   explicit Node(const Config* config);
+  Node(const Config* config, NodeArena* arena);
 
   Node(Node&&);
 
   // Does not expose true value semantics, as children are not cloned eagerly.
   // Should we remove this?
-  Node(const Node& node) = default;
+  Node(const Node& node);
 
   // assignment means potential leaks of existing children, or alternatively
   // freeing unowned memory, double free, or freeing stack memory.
@@ -49,6 +57,16 @@ class YG_EXPORT Node : public ::YGNode {
     return context_;
   }
 
+  uint64_t getMeasureCacheKey() const {
+    return measureCacheKey_;
+  }
+
+  // Hash of the subtree last computed by subtreeFingerprint(), or
+  // 0 if it changed since
+  uint64_t getFingerprint() const {
+    return fingerprint_;
+  }
+
   bool alwaysFormsContainingBlock() const {
     return alwaysFormsContainingBlock_;
   }
@@ -57,6 +75,12 @@ class YG_EXPORT Node : public ::YGNode {
     return hasNewLayout_;
   }
 
+  // Whether a descendant has a new layout which YGNodeLayoutCollectNewLayouts()
+  // had no room to read, after it read and cleared that of the node
+  bool hasPendingNewLayouts() const {
+    return hasPendingNewLayouts_;
+  }
+
   NodeType getNodeType() const {
     return nodeType_;
   }
@@ -67,8 +91,15 @@ class YG_EXPORT Node : public ::YGNode {
 
   YGSize measure(float, MeasureMode, float, MeasureMode);
 
+  // The sizes answering measurements without calling the measure function,
+  // or nullptr
+  const IntrinsicSizes* getIntrinsicSizes() const {
+    return extras_ && extras_->intrinsicSizes ? &*extras_->intrinsicSizes
+                                              : nullptr;
+  }
+
   bool hasBaselineFunc() const noexcept {
-    return baselineFunc_ != nullptr;
+    return extras_ && extras_->baselineFunc != nullptr;
   }
 
   float baseline(float width, float height) const;
@@ -91,7 +122,7 @@ class YG_EXPORT Node : public ::YGNode {
   }
 
   YGDirtiedFunc getDirtiedFunc() const {
-    return dirtiedFunc_;
+    return extras_ ? extras_->dirtiedFunc : nullptr;
   }
 
   // For Performance reasons passing as reference.
@@ -128,7 +159,7 @@ class YG_EXPORT Node : public ::YGNode {
     return owner_;
   }
 
-  const std::vector<Node*>& getChildren() const {
+  const Children& getChildren() const {
     return children_;
   }
 
@@ -144,10 +175,31 @@ class YG_EXPORT Node : public ::YGNode {
     return config_;
   }
 
+  // The arena the node was allocated from, or nullptr for heap nodes
+  NodeArena* getArena() const {
+    return children_.get_allocator().arena();
+  }
+
   bool isDirty() const {
     return isDirty_;
   }
 
+  // Whether the node, or a node under it, is a layout boundary which was
+  // marked dirty without dirtying its owner
+  bool hasDirtyDescendant() const {
+    return hasDirtyDescendant_;
+  }
+
+  bool isLayoutBoundary() const;
+
+  // The virtualization state of the children, or nullptr if every child is
+  // laid out
+  VirtualizedChildren* getVirtualizedChildren() const {
+    return extras_ && extras_->virtualizedChildren
+        ? &*extras_->virtualizedChildren
+        : nullptr;
+  }
+
   std::array<Style::Length, 2> getResolvedDimensions() const {
     return resolvedDimensions_;
   }
@@ -162,30 +214,56 @@ class YG_EXPORT Node : public ::YGNode {
     context_ = context;
   }
 
+  void setMeasureCacheKey(uint64_t measureCacheKey) {
+    if (measureCacheKey != measureCacheKey_) {
+      measureCacheKey_ = measureCacheKey;
+      invalidateFingerprint();
+    }
+  }
+
+  void setFingerprint(uint64_t fingerprint) {
+    fingerprint_ = fingerprint;
+  }
+
   void setAlwaysFormsContainingBlock(bool alwaysFormsContainingBlock) {
     alwaysFormsContainingBlock_ = alwaysFormsContainingBlock;
+    invalidateFingerprint();
   }
 
   void setHasNewLayout(bool hasNewLayout) {
     hasNewLayout_ = hasNewLayout;
   }
 
+  void setHasPendingNewLayouts(bool hasPendingNewLayouts) {
+    hasPendingNewLayouts_ = hasPendingNewLayouts;
+  }
+
   void setNodeType(NodeType nodeType) {
     nodeType_ = nodeType;
+    invalidateFingerprint();
   }
 
   void setMeasureFunc(YGMeasureFunc measureFunc);
 
+  // Clears the intrinsic sizes when `count` is 0
+  void setIntrinsicSizes(const YGSize* sizes, size_t count);
+
   void setBaselineFunc(YGBaselineFunc baseLineFunc) {
-    baselineFunc_ = baseLineFunc;
+    if (baseLineFunc != nullptr || extras_) {
+      extras().baselineFunc = baseLineFunc;
+    }
+    invalidateFingerprint();
   }
 
   void setDirtiedFunc(YGDirtiedFunc dirtiedFunc) {
-    dirtiedFunc_ = dirtiedFunc;
+    if (dirtiedFunc != nullptr || extras_) {
+      extras().dirtiedFunc = dirtiedFunc;
+    }
   }
 
   void setStyle(const Style& style) {
     style_ = style;
+    invalidateFingerprint();
   }
 
   void setLayout(const LayoutResults& layout) {
@@ -205,14 +283,29 @@ class YG_EXPORT Node : public ::YGNode {
   }
 
   void setChildren(const std::vector<Node*>& children) {
-    children_ = children;
+    children_.assign(children.begin(), children.end());
+    if (auto virtualizedChildren = getVirtualizedChildren()) {
+      virtualizedChildren->reset(children_.size());
+    }
   }
 
   // TODO: rvalue override for setChildren
 
+  void reserveChildren(size_t count) {
+    children_.reserve(count);
+  }
+
+  void setVirtualizesChildren(bool virtualizes, float estimatedExtent);
+
   void setConfig(Config* config);
 
   void setDirty(bool isDirty);
+  // Sets the dirty flag as setDirty() does, without calling the dirtied func,
+  // for the layout to redo work that no change to the node asked for
+  void setDirtyFlag(bool isDirty);
+  void setHasDirtyDescendant(bool hasDirtyDescendant) {
+    hasDirtyDescendant_ = hasDirtyDescendant;
+  }
   void setLayoutLastOwnerDirection(Direction direction);
   void setLayoutComputedFlexBasis(const FloatOptional computedFlexBasis);
   void setLayoutComputedFlexBasisGeneration(
@@ -244,8 +337,25 @@ class YG_EXPORT Node : public ::YGNode {
   bool removeChild(Node* child);
   void removeChild(size_t index);
 
+  Node* cloneChildIfNeeded(size_t index);
   void cloneChildrenIfNeeded();
+  // Marks the node and its ancestors up to the first layout boundary dirty,
+  // after its content changed
   void markDirtyAndPropagate();
+  // Marks the node and its ancestors dirty after its style changed, which
+  // may change its size even if it is a layout boundary
+  void markStyleDirtyAndPropagate();
+  // Flags the node and its ancestors as having a dirty descendant
+  void markHasDirtyDescendant();
+  // Clears the fingerprint of the node and of its ancestors, which hash it.
+  // A node with a fingerprint only has descendants with one, so this stops
+  // at the first ancestor without.
+  void invalidateFingerprint() {
+    for (Node* node = this; node != nullptr && node->fingerprint_ != 0;
+         node = node->owner_) {
+      node->fingerprint_ = 0;
+    }
+  }
   float resolveFlexGrow() const;
   float resolveFlexShrink() const;
   bool isNodeFlexible();
@@ -265,23 +375,45 @@ class YG_EXPORT Node : public ::YGNode {
     style_.setAlignContent(Align::Stretch);
   }
 
+  // State few nodes have, allocated when first set so that the nodes without
+  // it stay small
+  struct Extras {
+    YGBaselineFunc baselineFunc = nullptr;
+    YGDirtiedFunc dirtiedFunc = nullptr;
+    std::optional<VirtualizedChildren> virtualizedChildren;
+    std::optional<IntrinsicSizes> intrinsicSizes;
+  };
+
+  Extras& extras() {
+    if (!extras_) {
+      extras_ = std::make_unique<Extras>();
+    }
+    return *extras_;
+  }
+
+  // The fields read by every layout pass come first, so that they span as few
+  // cache lines as possible, followed by the results of the pass and the
+  // fields only read by the API or for measured and rare nodes
   bool hasNewLayout_ : 1 = true;
   bool isReferenceBaseline_ : 1 = false;
   bool isDirty_ : 1 = false;
   bool alwaysFormsContainingBlock_ : 1 = false;
+  bool hasDirtyDescendant_ : 1 = false;
+  bool hasPendingNewLayouts_ : 1 = false;
   NodeType nodeType_ : bitCount<NodeType>() = NodeType::Default;
-  void* context_ = nullptr;
-  YGMeasureFunc measureFunc_ = nullptr;
-  YGBaselineFunc baselineFunc_ = nullptr;
-  YGDirtiedFunc dirtiedFunc_ = nullptr;
-  Style style_;
-  LayoutResults layout_;
-  size_t lineIndex_ = 0;
-  Node* owner_ = nullptr;
-  std::vector<Node*> children_;
   const Config* config_;
+  Node* owner_ = nullptr;
+  Children children_;
+  size_t lineIndex_ = 0;
   std::array<Style::Length, 2> resolvedDimensions_{
       {value::undefined(), value::undefined()}};
+  Style style_;
+  LayoutResults layout_;
+  YGMeasureFunc measureFunc_ = nullptr;
+  void* context_ = nullptr;
+  uint64_t measureCacheKey_ = 0;
+  uint64_t fingerprint_ = 0;
+  std::unique_ptr<Extras> extras_;
 };
 
 inline Node* resolveRef(const YGNodeRef ref) {
@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) Dotcorr Studio. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <algorithm>
+#include <bit>
+#include <new>
+
+#include <yoga/debug/AssertFatal.h>
+#include <yoga/event/event.h>
+#include <yoga/node/Node.h>
+#include <yoga/node/NodeArena.h>
+
+namespace facebook::yoga {
+
+struct NodeArena::NodeSlot {
+  alignas(Node) std::byte storage[sizeof(Node)];
+  NodeSlot* nextFree = nullptr;
+  bool live = false;
+
+  Node* node() {
+    return std::launder(reinterpret_cast<Node*>(storage));
+  }
+};
+
+NodeArena::NodeArena() = default;
+
+NodeArena::~NodeArena() {
+  for (auto& slab : nodeSlabs_) {
+    for (size_t i = 0; i < slab.size; i++) {
+      auto& slot = slab.slots[i];
+      if (slot.live) {
+        Node* node = slot.node();
+        Event::publish<Event::NodeDeallocation>(node, {node->getConfig()});
+        node->~Node();
+      }
+    }
+  }
+}
+
+void NodeArena::newSlab(size_t size) {
+  nodeSlabs_.push_back({std::unique_ptr<NodeSlot[]>(new NodeSlot[size]), size});
+  nextSlotInSlab_ = 0;
+}
+
+Node* NodeArena::newNode(const Config* config) {
+  NodeSlot* slot = freeSlots_;
+  if (slot != nullptr) {
+    freeSlots_ = slot->nextFree;
+  } else {
+    if (nodeSlabs_.empty() || nextSlotInSlab_ == nodeSlabs_.back().size) {
+      newSlab(NodesPerSlab);
+    }
+    slot = &nodeSlabs_.back().slots[nextSlotInSlab_++];
+  }
+
+  auto* node = new (slot->storage) Node{config, this};
+  slot->live = true;
+  nodeCount_++;
+  return node;
+}
+
+void NodeArena::newNodes(
+    const Config* config,
+    const size_t count,
+    YGNodeRef* nodes) {
+  if (nodeSlabs_.empty() || nextSlotInSlab_ + count > nodeSlabs_.back().size) {
+    // The rest of the current slab is left to newNode()
+    if (!nodeSlabs_.empty()) {
+      auto& slab = nodeSlabs_.back();
+      for (; nextSlotInSlab_ < slab.size; nextSlotInSlab_++) {
+        slab.slots[nextSlotInSlab_].nextFree = freeSlots_;
+        freeSlots_ = &slab.slots[nextSlotInSlab_];
+      }
+    }
+    newSlab(std::max(count, NodesPerSlab));
+  }
+
+  NodeSlot* slots = &nodeSlabs_.back().slots[nextSlotInSlab_];
+  nextSlotInSlab_ += count;
+  for (size_t i = 0; i < count; i++) {
+    nodes[i] = new (slots[i].storage) Node{config, this};
+    slots[i].live = true;
+  }
+  nodeCount_ += count;
+}
+
+void NodeArena::deleteNode(Node* node) {
+  yoga::assertFatalWithNode(
+      node,
+      node->getArena() == this,
+      "Cannot delete a node which was not allocated from this arena");
+
+  // Node is the first member of its slot, which has standard layout
+  auto* slot = reinterpret_cast<NodeSlot*>(node);
+  node->~Node();
+  slot->live = false;
+  slot->nextFree = freeSlots_;
+  freeSlots_ = slot;
+  nodeCount_--;
+}
+
+size_t NodeArena::sizeClass(size_t bytes) {
+  const auto log2 = static_cast<size_t>(std::bit_width(bytes - 1));
+  return log2 < MinBlockSizeLog2 ? 0 : log2 - MinBlockSizeLog2;
+}
+
+void* NodeArena::allocate(size_t bytes) {
+  if (bytes > (size_t{1} << MaxBlockSizeLog2)) {
+    return ::operator new(bytes);
+  }
+
+  const size_t index = sizeClass(bytes);
+  if (FreeBlock* block = freeBlocks_[index]) {
+    freeBlocks_[index] = block->next;
+    return block;
+  }
+
+  const size_t blockSize = size_t{1} << (index + MinBlockSizeLog2);
+  if (nextByteInSlab_ + blockSize > BytesPerSlab) {
+    byteSlabs_.emplace_back(new std::byte[BytesPerSlab]);
+    nextByteInSlab_ = 0;
+  }
+  void* ptr = byteSlabs_.back().get() + nextByteInSlab_;
+  nextByteInSlab_ += blockSize;
+  return ptr;
+}
+
+void NodeArena::deallocate(void* ptr, size_t bytes) noexcept {
+  if (bytes > (size_t{1} << MaxBlockSizeLog2)) {
+    ::operator delete(ptr);
+    return;
+  }
+
+  const size_t index = sizeClass(bytes);
+  auto* block = static_cast<FreeBlock*>(ptr);
+  block->next = freeBlocks_[index];
+  freeBlocks_[index] = block;
+}
+
+} // namespace facebook::yoga
@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) Dotcorr Studio. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include <yoga/Yoga.h>
+
+// Tag struct used to form the opaque YGNodeArenaRef for the public C API
+struct YGNodeArena {};
+
+namespace facebook::yoga {
+
+class Config;
+class Node;
+
+/**
+ * NodeArena carves nodes and their child arrays out of large slabs, so that a
+ * whole tree can be built without per-node heap traffic and released in bulk.
+ * Nodes freed individually are recycled for later allocations from the same
+ * arena. An arena is not thread-safe, and must outlive every node allocated
+ * from it (which it destroys when it is itself destroyed).
+ */
+class YG_EXPORT NodeArena : public ::YGNodeArena {
+ public:
+  NodeArena();
+  ~NodeArena();
+
+  NodeArena(const NodeArena&) = delete;
+  NodeArena& operator=(const NodeArena&) = delete;
+
+  Node* newNode(const Config* config);
+  void deleteNode(Node* node);
+
+  // Allocates `count` nodes from adjacent slots, bypassing the recycled ones,
+  // so that a tree built at once is laid out in memory in build order.
+  void newNodes(const Config* config, size_t count, YGNodeRef* nodes);
+
+  size_t getNodeCount() const {
+    return nodeCount_;
+  }
+
+  // Storage for child arrays. Blocks are rounded up to a power-of-two size
+  // class and recycled per class.
+  void* allocate(size_t bytes);
+  void deallocate(void* ptr, size_t bytes) noexcept;
+
+ private:
+  struct NodeSlot;
+  struct NodeSlab {
+    std::unique_ptr<NodeSlot[]> slots;
+    size_t size;
+  };
+  struct FreeBlock {
+    FreeBlock* next;
+  };
+
+  static constexpr size_t NodesPerSlab = 256;
+  static constexpr size_t BytesPerSlab = 16 * 1024;
+  static constexpr size_t MinBlockSizeLog2 = 3;
+  static constexpr size_t MaxBlockSizeLog2 = 12;
+
+  static size_t sizeClass(size_t bytes);
+
+  void newSlab(size_t size);
+
+  std::vector<NodeSlab> nodeSlabs_;
+  size_t nextSlotInSlab_ = 0;
+  NodeSlot* freeSlots_ = nullptr;
+  size_t nodeCount_ = 0;
+
+  std::vector<std::unique_ptr<std::byte[]>> byteSlabs_;
+  size_t nextByteInSlab_ = BytesPerSlab;
+  std::array<FreeBlock*, MaxBlockSizeLog2 - MinBlockSizeLog2 + 1>
+      freeBlocks_{};
+};
+
+/**
+ * Allocator used for a node's children. Nodes allocated from a NodeArena keep
+ * their child arrays in the same arena, while heap allocated nodes (and copies
+ * of arena nodes) use the regular heap.
+ */
+template <typename T>
+class ArenaAllocator {
+ public:
+  using value_type = T;
+
+  ArenaAllocator() noexcept = default;
+  explicit ArenaAllocator(NodeArena* arena) noexcept : arena_{arena} {}
+
+  template <typename U>
+  ArenaAllocator(const ArenaAllocator<U>& other) noexcept
+      : arena_{other.arena()} {}
+
+  NodeArena* arena() const noexcept {
+    return arena_;
+  }
+
+  T* allocate(size_t n) {
+    static_assert(alignof(T) <= alignof(void*));
+    if (arena_ == nullptr) {
+      return std::allocator<T>{}.allocate(n);
+    }
+    return static_cast<T*>(arena_->allocate(n * sizeof(T)));
+  }
+
+  void deallocate(T* ptr, size_t n) noexcept {
+    if (arena_ == nullptr) {
+      std::allocator<T>{}.deallocate(ptr, n);
+    } else {
+      arena_->deallocate(ptr, n * sizeof(T));
+    }
+  }
+
+  // Copies of a node are independent of the arena of the original.
+  ArenaAllocator select_on_container_copy_construction() const noexcept {
+    return ArenaAllocator{};
+  }
+
+  template <typename U>
+  bool operator==(const ArenaAllocator<U>& other) const noexcept {
+    return arena_ == other.arena();
+  }
+
+ private:
+  NodeArena* arena_ = nullptr;
+};
+
+inline NodeArena* resolveRef(const YGNodeArenaRef ref) {
+  return static_cast<NodeArena*>(ref);
+}
+
+inline const NodeArena* resolveRef(const YGNodeArenaConstRef ref) {
+  return static_cast<const NodeArena*>(ref);
+}
+
+} // namespace facebook::yoga
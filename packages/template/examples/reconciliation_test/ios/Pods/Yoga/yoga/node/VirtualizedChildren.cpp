@@ -0,0 +1,192 @@
+/*
+ * Copyright (c) Dotcorr Studio. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+
+#include <yoga/node/VirtualizedChildren.h>
+
+namespace facebook::yoga {
+
+namespace {
+
+// The number of entries summed by node `index` of a 1-based Fenwick tree
+size_t lowestBit(size_t index) {
+  return index & (~index + 1);
+}
+
+} // namespace
+
+VirtualizedChildren::VirtualizedChildren(
+    size_t childCount,
+    float estimatedExtent)
+    : extents_(childCount, estimatedExtent),
+      isLaidOut_(childCount, false),
+      isHidden_(childCount, false),
+      estimatedExtent_{estimatedExtent} {}
+
+void VirtualizedChildren::insertChild(size_t index) {
+  extents_.insert(
+      extents_.begin() + static_cast<ptrdiff_t>(index), estimatedExtent_);
+  isLaidOut_.insert(
+      isLaidOut_.begin() + static_cast<ptrdiff_t>(index), false);
+  isHidden_.insert(isHidden_.begin() + static_cast<ptrdiff_t>(index), false);
+  if (needsRebuild_) {
+    return;
+  }
+  if (index + 1 != extents_.size()) {
+    needsRebuild_ = true;
+    return;
+  }
+
+  // Node `position` sums the entries since the one after node
+  // `position - lowestBit(position)`
+  const size_t position = index + 1;
+  tree_.push_back(
+      estimatedExtent_ + gap_ + prefixSum(index) -
+      prefixSum(position - lowestBit(position)));
+}
+
+void VirtualizedChildren::removeChild(size_t index) {
+  extents_.erase(extents_.begin() + static_cast<ptrdiff_t>(index));
+  isLaidOut_.erase(isLaidOut_.begin() + static_cast<ptrdiff_t>(index));
+  if (isHidden_[index]) {
+    hiddenCount_--;
+  }
+  isHidden_.erase(isHidden_.begin() + static_cast<ptrdiff_t>(index));
+  endLaidOut_ = std::min(endLaidOut_, extents_.size());
+  firstLaidOut_ = std::min(firstLaidOut_, endLaidOut_);
+  needsRebuild_ = true;
+}
+
+void VirtualizedChildren::reset(size_t childCount) {
+  extents_.assign(childCount, estimatedExtent_);
+  isLaidOut_.assign(childCount, false);
+  isHidden_.assign(childCount, false);
+  hiddenCount_ = 0;
+  firstLaidOut_ = 0;
+  endLaidOut_ = 0;
+  needsRebuild_ = true;
+}
+
+void VirtualizedChildren::setEstimatedExtent(float estimatedExtent) {
+  if (estimatedExtent == estimatedExtent_) {
+    return;
+  }
+  estimatedExtent_ = estimatedExtent;
+  for (size_t i = 0; i < extents_.size(); i++) {
+    if (!isLaidOut_[i]) {
+      extents_[i] = estimatedExtent;
+    }
+  }
+  needsRebuild_ = true;
+}
+
+void VirtualizedChildren::setGap(float gap) {
+  if (gap != gap_) {
+    gap_ = gap;
+    needsRebuild_ = true;
+  }
+}
+
+void VirtualizedChildren::setExtent(size_t index, float extent) {
+  const double oldSpan = getSpan(index);
+  extents_[index] = extent;
+  isLaidOut_[index] = true;
+  if (isHidden_[index]) {
+    isHidden_[index] = false;
+    hiddenCount_--;
+  }
+  updateSpan(index, oldSpan);
+}
+
+void VirtualizedChildren::setHidden(size_t index) {
+  const double oldSpan = getSpan(index);
+  extents_[index] = 0.0f;
+  isLaidOut_[index] = true;
+  if (!isHidden_[index]) {
+    isHidden_[index] = true;
+    hiddenCount_++;
+  }
+  updateSpan(index, oldSpan);
+}
+
+void VirtualizedChildren::updateSpan(size_t index, double oldSpan) {
+  const double delta = getSpan(index) - oldSpan;
+  if (!needsRebuild_ && delta != 0.0) {
+    add(index + 1, delta);
+  }
+}
+
+float VirtualizedChildren::getChildOffset(size_t index) {
+  rebuildIfNeeded();
+  return static_cast<float>(prefixSum(index));
+}
+
+size_t VirtualizedChildren::getChildAtOffset(float offset) {
+  rebuildIfNeeded();
+  const size_t count = extents_.size();
+  size_t position = 0;
+  double remaining = offset;
+  for (size_t step = std::bit_floor(count); step > 0; step >>= 1) {
+    if (position + step <= count && tree_[position + step] <= remaining) {
+      position += step;
+      remaining -= tree_[position];
+    }
+  }
+  return position;
+}
+
+float VirtualizedChildren::getTotalExtent() {
+  rebuildIfNeeded();
+  const size_t count = extents_.size();
+  // Every child but the last one shown is followed by a gap
+  return hiddenCount_ < count ? static_cast<float>(prefixSum(count) - gap_)
+                              : 0.0f;
+}
+
+void VirtualizedChildren::setWindow(
+    float offset,
+    float extent,
+    float overscan) {
+  windowOffset_ = offset;
+  windowExtent_ = extent;
+  overscan_ = overscan;
+}
+
+double VirtualizedChildren::prefixSum(size_t count) const {
+  double sum = 0.0;
+  for (size_t position = count; position > 0;
+       position -= lowestBit(position)) {
+    sum += tree_[position];
+  }
+  return sum;
+}
+
+void VirtualizedChildren::add(size_t position, double delta) {
+  for (; position < tree_.size(); position += lowestBit(position)) {
+    tree_[position] += delta;
+  }
+}
+
+void VirtualizedChildren::rebuildIfNeeded() {
+  if (!needsRebuild_) {
+    return;
+  }
+  tree_.assign(extents_.size() + 1, 0.0);
+  for (size_t position = 1; position < tree_.size(); position++) {
+    tree_[position] += getSpan(position - 1);
+    const size_t parent = position + lowestBit(position);
+    if (parent < tree_.size()) {
+      tree_[parent] += tree_[position];
+    }
+  }
+  needsRebuild_ = false;
+}
+
+} // namespace facebook::yoga
@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) Dotcorr Studio. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+namespace facebook::yoga {
+
+/**
+ * The state of a node which only lays out the children near a window along
+ * its main axis (see YGNodeSetVirtualizesChildren()).
+ *
+ * Every child has an extent along the main axis, margins included: the one
+ * it was last laid out at, or an estimate until it is first laid out.
+ * Children with `display: none` span nothing, not even a gap, as in a plain
+ * layout. A Fenwick tree over the extents and the gaps which follow them
+ * gives the
+ * offset of a child, the child at an offset and the total extent in
+ * O(log n). Appending a child or updating an extent is O(log n), while
+ * inserting or removing a child elsewhere rebuilds the tree in O(n) when it
+ * is next queried.
+ *
+ * Offsets are along the main axis, from the start of the content box of the
+ * node.
+ */
+class VirtualizedChildren {
+ public:
+  VirtualizedChildren(size_t childCount, float estimatedExtent);
+
+  // Keep the extents in step with the child list
+  void insertChild(size_t index);
+  void removeChild(size_t index);
+  void reset(size_t childCount);
+
+  float getEstimatedExtent() const {
+    return estimatedExtent_;
+  }
+
+  // Replaces the extent of every child not laid out yet
+  void setEstimatedExtent(float estimatedExtent);
+
+  void setGap(float gap);
+
+  float getExtent(size_t index) const {
+    return extents_[index];
+  }
+
+  // Records the extent a child was laid out at
+  void setExtent(size_t index, float extent);
+
+  // Records that a child has `display: none`, until its extent is next set
+  void setHidden(size_t index);
+
+  float getChildOffset(size_t index);
+
+  // Returns the index of the child spanning `offset` (the gap following a
+  // child included), or the child count if it is past the last one
+  size_t getChildAtOffset(float offset);
+
+  // The sum of the extents and gaps between the children which are not
+  // hidden
+  float getTotalExtent();
+
+  // The window along the main axis whose children are laid out, extended by
+  // `overscan` on both sides
+  void setWindow(float offset, float extent, float overscan);
+
+  float getWindowStart() const {
+    return windowOffset_ - overscan_;
+  }
+
+  float getWindowEnd() const {
+    return windowOffset_ + windowExtent_ + overscan_;
+  }
+
+  // The range of children laid out by the last layout
+  size_t getFirstLaidOutChild() const {
+    return firstLaidOut_;
+  }
+
+  size_t getEndLaidOutChild() const {
+    return endLaidOut_;
+  }
+
+  void setLaidOutChildren(size_t first, size_t end) {
+    firstLaidOut_ = first;
+    endLaidOut_ = end;
+  }
+
+  // The largest cross size of the children laid out by the last layout
+  float getMaxCrossExtent() const {
+    return maxCrossExtent_;
+  }
+
+  void setMaxCrossExtent(float maxCrossExtent) {
+    maxCrossExtent_ = maxCrossExtent;
+  }
+
+ private:
+  // The entry of a child in the Fenwick tree
+  double getSpan(size_t index) const {
+    return isHidden_[index] ? 0.0
+                            : static_cast<double>(extents_[index]) + gap_;
+  }
+
+  // Updates the entry of a child after its extent or visibility changed
+  void updateSpan(size_t index, double oldSpan);
+
+  double prefixSum(size_t count) const;
+  void add(size_t position, double delta);
+  void rebuildIfNeeded();
+
+  std::vector<float> extents_;
+  std::vector<bool> isLaidOut_;
+  std::vector<bool> isHidden_;
+  size_t hiddenCount_ = 0;
+  // 1-based Fenwick tree over getSpan(i)
+  std::vector<double> tree_;
+  bool needsRebuild_ = true;
+  float estimatedExtent_;
+  float gap_ = 0.0f;
+
+  float windowOffset_ = 0.0f;
+  // Every child is laid out until a window is set
+  float windowExtent_ = std::numeric_limits<float>::infinity();
+  float overscan_ = 0.0f;
+  size_t firstLaidOut_ = 0;
+  size_t endLaidOut_ = 0;
+  float maxCrossExtent_ = 0.0f;
+};
+
+} // namespace facebook::yoga
@@ -8,6 +8,7 @@
 #pragma once
 
 #include <array>
+#include <bit>
 #include <cstdint>
 #include <type_traits>
 
@@ -472,6 +473,39 @@ class YG_EXPORT Style {
     return !(*this == other);
   }
 
+  // A hash of the style. Styles which compare equal have the same hash,
+  // unless their lengths only differ within the tolerance of inexactEquals().
+  uint64_t hash() const {
+    uint64_t hash = 0;
+    hash = hashCombine(hash, yoga::to_underlying(direction_));
+    hash = hashCombine(hash, yoga::to_underlying(flexDirection_));
+    hash = hashCombine(hash, yoga::to_underlying(justifyContent_));
+    hash = hashCombine(hash, yoga::to_underlying(alignContent_));
+    hash = hashCombine(hash, yoga::to_underlying(alignItems_));
+    hash = hashCombine(hash, yoga::to_underlying(alignSelf_));
+    hash = hashCombine(hash, yoga::to_underlying(positionType_));
+    hash = hashCombine(hash, yoga::to_underlying(flexWrap_));
+    hash = hashCombine(hash, yoga::to_underlying(overflow_));
+    hash = hashCombine(hash, yoga::to_underlying(display_));
+    hash = hashNumber(hash, flex_);
+    hash = hashNumber(hash, flexGrow_);
+    hash = hashNumber(hash, flexShrink_);
+    hash = hashLengths(hash, std::array{flexBasis_});
+    hash = hashLengths(hash, margin_);
+    hash = hashLengths(hash, position_);
+    hash = hashLengths(hash, padding_);
+    hash = hashLengths(hash, border_);
+    hash = hashLengths(hash, gap_);
+    hash = hashLengths(hash, dimensions_);
+    hash = hashLengths(hash, minDimensions_);
+    hash = hashLengths(hash, maxDimensions_);
+    return hashNumber(hash, aspectRatio_);
+  }
+
+  static constexpr uint64_t hashCombine(uint64_t hash, uint64_t value) {
+    return (hash ^ value) * 0x100000001b3ull + 0x9e3779b97f4a7c15ull;
+  }
+
  private:
   using Dimensions = std::array<StyleValueHandle, ordinalCount<Dimension>()>;
   using Edges = std::array<StyleValueHandle, ordinalCount<Edge>()>;
@@ -495,6 +529,28 @@ class YG_EXPORT Style {
         (lhsPool.getLength(lhsHandle) == rhsPool.getLength(rhsHandle));
   }
 
+  uint64_t hashNumber(uint64_t hash, const StyleValueHandle& handle) const {
+    const FloatOptional number = pool_.getNumber(handle);
+    return hashCombine(
+        hash,
+        number.isUndefined() ? 0 : std::bit_cast<uint32_t>(number.unwrap()));
+  }
+
+  template <size_t N>
+  uint64_t hashLengths(
+      uint64_t hash,
+      const std::array<StyleValueHandle, N>& handles) const {
+    for (const auto& handle : handles) {
+      const StyleLength length = pool_.getLength(handle);
+      hash = hashCombine(hash, yoga::to_underlying(length.unit()));
+      if (length.value().isDefined()) {
+        hash = hashCombine(
+            hash, std::bit_cast<uint32_t>(length.value().unwrap()));
+      }
+    }
+    return hash;
+  }
+
   template <size_t N>
   static inline bool lengthsEqual(
       const std::array<StyleValueHandle, N>& lhs,